@@ -18,6 +18,7 @@
 #include <stl2/detail/algorithm/adjacent_find.hpp>
 #include <stl2/detail/algorithm/all_of.hpp>
 #include <stl2/detail/algorithm/any_of.hpp>
+#include <stl2/detail/algorithm/apply_permutation.hpp>
 #include <stl2/detail/algorithm/binary_search.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
 #include <stl2/detail/algorithm/copy_backward.hpp>
@@ -45,8 +46,10 @@
 #include <stl2/detail/algorithm/is_permutation.hpp>
 #include <stl2/detail/algorithm/is_sorted.hpp>
 #include <stl2/detail/algorithm/is_sorted_until.hpp>
+#include <stl2/detail/algorithm/layout_bound.hpp>
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
 #include <stl2/detail/algorithm/lower_bound.hpp>
+#include <stl2/detail/algorithm/lower_bound_batch.hpp>
 #include <stl2/detail/algorithm/make_heap.hpp>
 #include <stl2/detail/algorithm/max.hpp>
 #include <stl2/detail/algorithm/max_element.hpp>
@@ -69,6 +72,7 @@
 #include <stl2/detail/algorithm/pop_heap.hpp>
 #include <stl2/detail/algorithm/prev_permutation.hpp>
 #include <stl2/detail/algorithm/push_heap.hpp>
+#include <stl2/detail/algorithm/radix_sort.hpp>
 #include <stl2/detail/algorithm/remove.hpp>
 #include <stl2/detail/algorithm/remove_copy.hpp>
 #include <stl2/detail/algorithm/remove_copy_if.hpp>
@@ -82,17 +86,22 @@
 #include <stl2/detail/algorithm/rotate.hpp>
 #include <stl2/detail/algorithm/rotate_copy.hpp>
 #include <stl2/detail/algorithm/search.hpp>
+#include <stl2/detail/algorithm/search_any.hpp>
 #include <stl2/detail/algorithm/search_n.hpp>
+#include <stl2/detail/algorithm/searchers.hpp>
 #include <stl2/detail/algorithm/set_difference.hpp>
 #include <stl2/detail/algorithm/set_intersection.hpp>
 #include <stl2/detail/algorithm/set_symmetric_difference.hpp>
 #include <stl2/detail/algorithm/set_union.hpp>
 #include <stl2/detail/algorithm/shuffle.hpp>
 #include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/sort_by_cached_key.hpp>
+#include <stl2/detail/algorithm/sort_permutation.hpp>
 #include <stl2/detail/algorithm/sort_heap.hpp>
 #include <stl2/detail/algorithm/stable_partition.hpp>
 #include <stl2/detail/algorithm/stable_sort.hpp>
 #include <stl2/detail/algorithm/swap_ranges.hpp>
+#include <stl2/detail/algorithm/top_k.hpp>
 #include <stl2/detail/algorithm/transform.hpp>
 #include <stl2/detail/algorithm/unique.hpp>
 #include <stl2/detail/algorithm/unique_copy.hpp>
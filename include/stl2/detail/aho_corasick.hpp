@@ -0,0 +1,209 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_AHO_CORASICK_HPP
+#define STL2_DETAIL_AHO_CORASICK_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/view/subrange.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// aho_corasick [Extension]
+//
+// An automaton that finds every occurrence of any of a set of byte string
+// patterns in a single pass over a text, as search_any and
+// views::match_all do.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class T>
+		META_CONCEPT byte_like = (integral<T> && sizeof(T) == 1) || same_as<T, std::byte>;
+
+		// The last positions of a scan, enough to recover the start of a
+		// match of up to max_length elements that ends at the current
+		// position. Random-access iterators need no record.
+		template<forward_iterator I>
+		class scan_history {
+			std::vector<I> ring_;
+			std::size_t head_ = 0;
+		public:
+			scan_history() = default;
+			explicit scan_history(const std::size_t max_length)
+			: ring_(random_access_iterator<I> ? 0 : max_length) {}
+
+			// Records i, the position of the element about to be read.
+			void push(const I& i) {
+				if constexpr (!random_access_iterator<I>) {
+					ring_[head_] = i;
+					if (++head_ == ring_.size()) head_ = 0;
+				}
+			}
+
+			// The position length elements before cur, the position after
+			// the last element read; length is in [1, max_length].
+			I start(const I& cur, const std::size_t length) const {
+				if constexpr (random_access_iterator<I>) {
+					return cur - static_cast<iter_difference_t<I>>(length);
+				} else {
+					const std::size_t n = ring_.size();
+					return ring_[head_ >= length ? head_ - length : head_ + n - length];
+				}
+			}
+		};
+	} // namespace detail
+
+	namespace ext {
+		// An occurrence of the pattern with index pattern.
+		template<class I>
+		struct pattern_match : subrange<I> {
+			std::size_t pattern = 0;
+		};
+
+		// The deterministic Aho-Corasick automaton of a set of patterns.
+		//
+		// Bytes that occur in no pattern are mapped to one class, and the
+		// rest to one class each, so that each state needs only a row of
+		// transitions per class: with failure links folded into the rows,
+		// reading a byte costs two loads from a dense table. Each
+		// transition holds the offset of the target's row, tagged when some
+		// pattern ends there; the patterns ending at a state are chained,
+		// longest first, through the nearest accepting states on its failure
+		// path. Empty patterns never match, and of equal patterns only the
+		// first is reported.
+		class aho_corasick {
+		public:
+			using state_type = std::uint32_t;
+			using output_type = std::uint32_t;
+
+			aho_corasick() = default;
+
+			template<forward_range Patterns>
+			requires forward_range<range_reference_t<Patterns>> &&
+				detail::byte_like<range_value_t<range_reference_t<Patterns>>>
+			explicit aho_corasick(Patterns&& patterns) {
+				build(patterns);
+			}
+
+			// The number of patterns.
+			std::size_t size() const noexcept { return lengths_.size(); }
+			// The length of the longest pattern.
+			std::size_t max_length() const noexcept { return max_length_; }
+			// The length of pattern p.
+			std::size_t length(const std::size_t p) const noexcept { return lengths_[p]; }
+
+			// The state before reading any byte.
+			static constexpr state_type start() noexcept { return 0; }
+
+			// The state after reading c in state s.
+			state_type next(const state_type s, const unsigned char c) const noexcept {
+				return delta_[(s & ~accepting_bit) + class_[c]];
+			}
+
+			// Whether some pattern ends on reaching s.
+			static constexpr bool accepting(const state_type s) noexcept {
+				return (s & accepting_bit) != 0;
+			}
+
+			// The longest pattern ending at the accepting state s, and each
+			// shorter one in turn; 0 marks the end of the chain.
+			output_type first_output(const state_type s) const noexcept {
+				const auto q = (s & ~accepting_bit) / classes_;
+				return pattern_[q] != none ? q : output_[q];
+			}
+			output_type next_output(const output_type o) const noexcept { return output_[o]; }
+			std::size_t pattern(const output_type o) const noexcept { return pattern_[o]; }
+
+		private:
+			static constexpr state_type accepting_bit = state_type{1} << 31;
+			static constexpr std::uint32_t none = ~std::uint32_t{0};
+
+			std::array<std::uint16_t, 256> class_{};
+			std::uint32_t classes_ = 1;
+			std::vector<state_type> delta_ = std::vector<state_type>(1);
+			std::vector<std::uint32_t> pattern_ = std::vector<std::uint32_t>(1, none);
+			std::vector<output_type> output_ = std::vector<output_type>(1);
+			std::vector<std::size_t> lengths_;
+			std::size_t max_length_ = 0;
+
+			template<class Patterns>
+			void build(Patterns& patterns);
+		};
+
+		template<class Patterns>
+		void aho_corasick::build(Patterns& patterns) {
+			std::array<bool, 256> used{};
+			for (auto&& p : patterns) {
+				for (auto&& c : p) used[static_cast<unsigned char>(c)] = true;
+			}
+			for (std::size_t c = 0; c < 256; ++c) {
+				if (used[c]) class_[c] = static_cast<std::uint16_t>(classes_++);
+			}
+
+			// The trie, with transitions as state numbers and 0 for none
+			delta_.assign(classes_, 0);
+			for (auto&& p : patterns) {
+				std::uint32_t q = 0;
+				std::size_t length = 0;
+				for (auto&& c : p) {
+					const std::size_t i = q * classes_ + class_[static_cast<unsigned char>(c)];
+					if (delta_[i] == 0) {
+						delta_[i] = static_cast<std::uint32_t>(pattern_.size());
+						delta_.resize(delta_.size() + classes_);
+						pattern_.push_back(none);
+					}
+					q = delta_[i];
+					++length;
+				}
+				const auto index = static_cast<std::uint32_t>(lengths_.size());
+				lengths_.push_back(length);
+				if (length > max_length_) max_length_ = length;
+				if (q != 0 && pattern_[q] == none) pattern_[q] = index;
+			}
+			STL2_EXPECT(pattern_.size() < (accepting_bit / classes_));
+
+			// Breadth first, so that failure targets come first: fold the
+			// failure links into the rows, and chain the outputs.
+			const std::size_t states = pattern_.size();
+			std::vector<std::uint32_t> fail(states, 0);
+			output_.assign(states, 0);
+			std::vector<std::uint32_t> queue;
+			queue.reserve(states);
+			queue.push_back(0);
+			for (std::size_t head = 0; head < queue.size(); ++head) {
+				const std::uint32_t q = queue[head];
+				for (std::uint32_t c = 1; c < classes_; ++c) {
+					auto& t = delta_[q * classes_ + c];
+					const std::uint32_t f = q == 0 ? 0 : delta_[fail[q] * classes_ + c];
+					if (t == 0) {
+						t = f;
+					} else {
+						fail[t] = f;
+						output_[t] = pattern_[f] != none ? f : output_[f];
+						queue.push_back(t);
+					}
+				}
+			}
+
+			// Rows by offset, tagged when accepting
+			for (auto& t : delta_) {
+				const bool accepts = pattern_[t] != none || output_[t] != 0;
+				t = t * classes_ | (accepts ? accepting_bit : 0);
+			}
+		}
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
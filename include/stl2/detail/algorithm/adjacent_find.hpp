@@ -16,6 +16,7 @@
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/concepts.hpp>
 #include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // adjacent_find [alg.adjacent.find]
@@ -26,6 +27,13 @@ STL2_OPEN_NAMESPACE {
 			indirect_relation<projected<I, Proj>> Pred = equal_to>
 		constexpr I
 		operator()(I first, S last, Pred pred = {}, Proj proj = {}) const {
+			if constexpr (detail::simd::adjacent_equality_scannable<I, S, Pred, Proj>) {
+				if (!detail::is_constant_evaluated()) {
+					const auto n = last - first;
+					return first + static_cast<iter_difference_t<I>>(
+						detail::simd::adjacent_n<0>(first, static_cast<std::size_t>(n)));
+				}
+			}
 			if (first == last) {
 				return first;
 			}
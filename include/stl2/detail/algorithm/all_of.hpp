@@ -17,6 +17,7 @@
 
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/simd.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
 // all_of [alg.all_of]
@@ -26,6 +27,13 @@ STL2_OPEN_NAMESPACE {
 		template<input_iterator I, sentinel_for<I> S, class Proj = identity,
 			indirect_unary_predicate<projected<I, Proj>> Pred>
 		constexpr bool operator()(I first, S last, Pred pred, Proj proj = {}) const {
+			if constexpr (detail::simd::predicate_scannable<I, S, Proj, Pred>) {
+				if (!detail::is_constant_evaluated()) {
+					using VP = detail::simd::value_predicate<Pred>;
+					return detail::simd::find_value<!VP::equal>(first, last,
+						VP::value(pred)) == last;
+				}
+			}
 			for (; first != last; ++first) {
 				if (!bool(__stl2::invoke(pred, __stl2::invoke(proj, *first)))) {
 					return false;
@@ -0,0 +1,97 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_APPLY_PERMUTATION_HPP
+#define STL2_DETAIL_ALGORITHM_APPLY_PERMUTATION_HPP
+
+#include <cstdint>
+#include <limits>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// apply_permutation [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		// Rearranges [first, last) so that the element at position i is the
+		// one that was at perm[i], as produced by sort_permutation. perm
+		// must hold each of 0, 1, ..., last - first - 1 exactly once.
+		//
+		// Each cycle of the permutation is followed from its least position,
+		// so every element out of place is moved once, plus once more
+		// through a single temporary per cycle. The positions visited are
+		// marked in perm itself by complementing them, and unmarked as the
+		// scan reaches them, so perm is unchanged on return. An unsigned
+		// index type must therefore be able to represent
+		// 2 * (last - first) - 1, and a signed one last - first - 1.
+		struct __apply_permutation_fn : private __niebloid {
+			template<random_access_iterator I, sentinel_for<I> S, random_access_iterator P>
+			requires permutable<I> && integral<iter_value_t<P>> &&
+				indirectly_writable<P, iter_value_t<P>>
+			constexpr I operator()(I first, S sent, P perm) const {
+				using D = iter_difference_t<I>;
+				using V = iter_value_t<P>;
+				auto last = next(first, static_cast<S&&>(sent));
+				const D n = last - first;
+				if constexpr (unsigned_integral<V>) {
+					STL2_EXPECT(static_cast<std::uintmax_t>(n) <=
+						std::uintmax_t{std::numeric_limits<V>::max()} / 2 + 1);
+				} else {
+					STL2_EXPECT(static_cast<std::uintmax_t>(n) <=
+						static_cast<std::uintmax_t>(std::numeric_limits<V>::max()) + 1);
+				}
+				auto marked = [n](const V v) {
+					if constexpr (signed_integral<V>) {
+						if (v < 0) return true;
+					}
+					return static_cast<std::uintmax_t>(v) >= static_cast<std::uintmax_t>(n);
+				};
+
+				for (D i = 0; i < n; ++i) {
+					const V p = perm[i];
+					if (marked(p)) {
+						perm[i] = static_cast<V>(~p);
+						continue;
+					}
+					if (static_cast<D>(p) == i) continue;
+
+					iter_value_t<I> tmp = iter_move(first + i);
+					D j = i;
+					D k = static_cast<D>(p);
+					do {
+						STL2_EXPECT(i < k && k < n);
+						*(first + j) = iter_move(first + k);
+						j = k;
+						const V next_k = perm[j];
+						perm[j] = static_cast<V>(~next_k);
+						k = static_cast<D>(next_k);
+					} while (k != i);
+					*(first + j) = std::move(tmp);
+				}
+				return last;
+			}
+
+			template<random_access_range R, random_access_range Perm>
+			requires permutable<iterator_t<R>> && integral<range_value_t<Perm>> &&
+				indirectly_writable<iterator_t<Perm>, range_value_t<Perm>>
+			constexpr safe_iterator_t<R> operator()(R&& r, Perm&& perm) const {
+				STL2_EXPECT(distance(perm) == distance(r));
+				return (*this)(begin(r), end(r), begin(perm));
+			}
+		};
+
+		inline constexpr __apply_permutation_fn apply_permutation{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_COPY_HPP
 #define STL2_DETAIL_ALGORITHM_COPY_HPP
 
+#include <stl2/detail/algorithm/memcopy.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/range/concepts.hpp>
 #include <stl2/detail/range/dangling.hpp>
@@ -28,6 +29,14 @@ STL2_OPEN_NAMESPACE {
 		requires indirectly_copyable<I, O>
 		constexpr copy_result<I, O>
 		operator()(I first, S last, O result) const {
+			if constexpr (sized_sentinel_for<S, I> &&
+				detail::memcopyable<I, O, iter_reference_t<I>>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					auto const n = last - first;
+					return detail::memcopy(std::move(first), n, std::move(result));
+				}
+			}
 			for (; first != last; (void) ++first, (void) ++result) {
 				*result = *first;
 			}
@@ -50,6 +59,14 @@ STL2_OPEN_NAMESPACE {
 			requires indirectly_copyable<I, O>
 			constexpr copy_result<I, O>
 			operator()(I first, S last, O result) const {
+				if constexpr (sized_sentinel_for<S, I> &&
+					detail::memcopyable<I, O, iter_reference_t<I>>)
+				{
+					if (!detail::is_constant_evaluated()) {
+						auto const n = last - first;
+						return detail::memcopy(std::move(first), n, std::move(result));
+					}
+				}
 				for (; first != last; (void) ++first, (void) ++result) {
 					*result = *first;
 				}
@@ -70,6 +87,17 @@ STL2_OPEN_NAMESPACE {
 			requires indirectly_copyable<I1, I2>
 			constexpr copy_result<I1, I2>
 			operator()(I1 first, S1 last, I2 rfirst, S2 rlast) const {
+				if constexpr (sized_sentinel_for<S1, I1> && sized_sentinel_for<S2, I2> &&
+					detail::memcopyable<I1, I2, iter_reference_t<I1>>)
+				{
+					if (!detail::is_constant_evaluated()) {
+						auto const n1 = last - first;
+						auto const n2 = rlast - rfirst;
+						return detail::memcopy(std::move(first),
+							n2 < n1 ? static_cast<iter_difference_t<I1>>(n2) : n1,
+							std::move(rfirst));
+					}
+				}
 				for (; first != last && rfirst != rlast; (void) ++first, (void)++rfirst) {
 					*rfirst = *first;
 				}
@@ -13,6 +13,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_COPY_BACKWARD_HPP
 #define STL2_DETAIL_ALGORITHM_COPY_BACKWARD_HPP
 
+#include <stl2/detail/algorithm/memcopy.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/range/concepts.hpp>
 #include <stl2/detail/range/dangling.hpp>
@@ -29,6 +30,15 @@ STL2_OPEN_NAMESPACE {
 		requires indirectly_copyable<I1, I2>
 		constexpr copy_backward_result<I1, I2>
 		operator()(I1 first, S1 sent, I2 out) const {
+			if constexpr (sized_sentinel_for<S1, I1> &&
+				detail::memcopyable<I1, I2, iter_reference_t<I1>>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					auto const n = sent - first;
+					return detail::memcopy<true>(static_cast<I1&&>(first), n,
+						static_cast<I2&&>(out));
+				}
+			}
 			auto last = next(first, static_cast<S1&&>(sent));
 			auto i = last;
 			while (i != first) {
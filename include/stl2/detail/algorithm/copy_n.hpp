@@ -13,6 +13,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_COPY_N_HPP
 #define STL2_DETAIL_ALGORITHM_COPY_N_HPP
 
+#include <stl2/detail/algorithm/memcopy.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/iterator/concepts.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
@@ -30,6 +31,11 @@ STL2_OPEN_NAMESPACE {
 		constexpr copy_n_result<I, O>
 		operator()(I first_, iter_difference_t<I> n, O result) const {
 			if (n < 0) n = 0;
+			if constexpr (detail::memcopyable<I, O, iter_reference_t<I>>) {
+				if (!detail::is_constant_evaluated()) {
+					return detail::memcopy(std::move(first_), n, std::move(result));
+				}
+			}
 			auto norig = n;
 			auto first = ext::uncounted(first_);
 			for(; n > 0; (void) ++first, (void) ++result, --n) {
@@ -14,6 +14,7 @@
 
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // count [alg.count]
@@ -24,6 +25,11 @@ STL2_OPEN_NAMESPACE {
 		requires indirect_relation<equal_to, projected<I, Proj>, const T*>
 		constexpr iter_difference_t<I>
 		operator()(I first, S last, const T& value, Proj proj = {}) const {
+			if constexpr (detail::simd::value_scannable<I, S, Proj, T>) {
+				if (!detail::is_constant_evaluated()) {
+					return detail::simd::count_value(first, last, value);
+				}
+			}
 			iter_difference_t<I> n = 0;
 			for (; first != last; ++first) {
 				if (__stl2::invoke(proj, *first) == value) {
@@ -14,6 +14,7 @@
 
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // equal [alg.equal]
@@ -27,6 +28,14 @@ STL2_OPEN_NAMESPACE {
 		static constexpr bool __equal_3(I1 first1, S1 last1, I2 first2,
 			Pred& pred, Proj1& proj1, Proj2& proj2)
 		{
+			if constexpr (sized_sentinel_for<S1, I1> &&
+				detail::simd::equality_scannable<I1, I2, Pred, Proj1, Proj2>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					const auto n = static_cast<std::size_t>(last1 - first1);
+					return detail::simd::equal_n(first1, first2, n);
+				}
+			}
 			for (; first1 != last1; (void) ++first1, (void) ++first2) {
 				if (!__stl2::invoke(pred,
 						__stl2::invoke(proj1, *first1),
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_FILL_HPP
 #define STL2_DETAIL_ALGORITHM_FILL_HPP
 
+#include <stl2/detail/algorithm/memfill.hpp>
 #include <stl2/detail/range/concepts.hpp>
 #include <stl2/detail/range/dangling.hpp>
 
@@ -21,6 +22,14 @@ STL2_OPEN_NAMESPACE {
 	struct __fill_fn : private __niebloid {
 		template<class T, output_iterator<const T&> O, sentinel_for<O> S>
 		constexpr O operator()(O first, S last, const T& value) const {
+			if constexpr (sized_sentinel_for<S, O> && detail::memfillable<O, T>) {
+				if (!detail::is_constant_evaluated()) {
+					auto const n = last - first;
+					if (detail::memfill(first, n, [&](auto& e) { e = value; })) {
+						return detail::memory_walk<O>::advance(first, n);
+					}
+				}
+			}
 			for (; first != last; ++first) {
 				*first = value;
 			}
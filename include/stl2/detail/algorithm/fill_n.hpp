@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_FILL_N_HPP
 #define STL2_DETAIL_ALGORITHM_FILL_N_HPP
 
+#include <stl2/detail/algorithm/memfill.hpp>
 #include <stl2/detail/iterator/concepts.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -22,6 +23,13 @@ STL2_OPEN_NAMESPACE {
 		template<class T, output_iterator<const T&> O>
 		constexpr O
 		operator()(O first, iter_difference_t<O> n, const T& value) const {
+			if constexpr (detail::memfillable<O, T>) {
+				if (!detail::is_constant_evaluated() &&
+					detail::memfill(first, n, [&](auto& e) { e = value; }))
+				{
+					return detail::memory_walk<O>::advance(first, n);
+				}
+			}
 			for (; n > 0; --n, (void)++first) {
 				*first = value;
 			}
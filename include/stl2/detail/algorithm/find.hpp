@@ -14,6 +14,7 @@
 
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // find [alg.find]
@@ -24,6 +25,11 @@ STL2_OPEN_NAMESPACE {
 		requires indirect_relation<equal_to, projected<I, Proj>, const T*>
 		constexpr I
 		operator()(I first, S last, const T& value, Proj proj = {}) const {
+			if constexpr (detail::simd::value_scannable<I, S, Proj, T>) {
+				if (!detail::is_constant_evaluated()) {
+					return detail::simd::find_value<true>(std::move(first), last, value);
+				}
+			}
 			for (; first != last; ++first) {
 				if (__stl2::invoke(proj, *first) == value) {
 					break;
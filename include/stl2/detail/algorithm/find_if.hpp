@@ -14,6 +14,7 @@
 
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // find_if [alg.find]
@@ -24,6 +25,13 @@ STL2_OPEN_NAMESPACE {
 			indirect_unary_predicate<projected<I, Proj>> Pred>
 		constexpr I
 		operator()(I first, S last, Pred pred, Proj proj = {}) const {
+			if constexpr (detail::simd::predicate_scannable<I, S, Proj, Pred>) {
+				if (!detail::is_constant_evaluated()) {
+					using VP = detail::simd::value_predicate<Pred>;
+					return detail::simd::find_value<VP::equal>(std::move(first), last,
+						VP::value(pred));
+				}
+			}
 			for (; first != last; ++first) {
 				if (__stl2::invoke(pred, __stl2::invoke(proj, *first))) {
 					break;
@@ -15,6 +15,7 @@
 #include <stl2/detail/algorithm/find_if.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // find_if_not [alg.find]
@@ -25,6 +26,13 @@ STL2_OPEN_NAMESPACE {
 			indirect_unary_predicate<projected<I, Proj>> Pred>
 		constexpr I
 		operator()(I first, S last, Pred pred, Proj proj = {}) const {
+			if constexpr (detail::simd::predicate_scannable<I, S, Proj, Pred>) {
+				if (!detail::is_constant_evaluated()) {
+					using VP = detail::simd::value_predicate<Pred>;
+					return detail::simd::find_value<!VP::equal>(std::move(first), last,
+						VP::value(pred));
+				}
+			}
 			return find_if(std::move(first), std::move(last),
 				__stl2::not_fn(__stl2::ref(pred)), __stl2::ref(proj));
 		}
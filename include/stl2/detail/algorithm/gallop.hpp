@@ -0,0 +1,66 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_GALLOP_HPP
+#define STL2_DETAIL_ALGORITHM_GALLOP_HPP
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/partition_point.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Galloping search, for the algorithms over sorted ranges
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Ranges in which a galloping search can skip ahead.
+		template<class I, class S>
+		META_CONCEPT gallopable = random_access_iterator<I> && sized_sentinel_for<S, I>;
+
+		// The elements a galloping search tries one by one before skipping.
+		inline constexpr int gallop_linear = 8;
+
+		// The first position in [first, last) whose element does not
+		// satisfy pred, which the elements before it all do: the position
+		// a loop of ++first would stop at. Where the range allows, after
+		// the first few elements the search probes ahead at doubling
+		// distances, then halves the last gap: a skip of d elements takes
+		// O(log d) evaluations of pred rather than d.
+		template<forward_iterator I, sentinel_for<I> S, class Pred, class Proj>
+		constexpr I skip_while(I first, const S last, Pred& pred, Proj& proj) {
+			if constexpr (gallopable<I, S>) {
+				using D = iter_difference_t<I>;
+				const D n = last - first;
+				D at = 0;
+				for (; at < n && at < gallop_linear; ++at) {
+					if (!__stl2::invoke(pred, __stl2::invoke(proj, first[at]))) {
+						return first + at;
+					}
+				}
+				D step = 1;
+				while (step <= n - at &&
+					__stl2::invoke(pred, __stl2::invoke(proj, first[at + step - 1])))
+				{
+					at += step;
+					step *= 2;
+				}
+				const D gap = step - 1 < n - at ? step - 1 : n - at;
+				return ext::partition_point_n(first + at, gap, __stl2::ref(pred),
+					__stl2::ref(proj));
+			} else {
+				while (first != last && __stl2::invoke(pred, __stl2::invoke(proj, *first))) {
+					++first;
+				}
+				return first;
+			}
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_INCLUDES_HPP
 #define STL2_DETAIL_ALGORITHM_INCLUDES_HPP
 
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/concepts.hpp>
 
@@ -27,6 +28,27 @@ STL2_OPEN_NAMESPACE {
 		constexpr bool operator()(I1 first1, S1 last1, I2 first2, S2 last2,
 			Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (forward_iterator<I1> && forward_iterator<I2> &&
+				detail::gallopable<I1, S1>)
+			{
+				// Skip each run of elements of the first range less than the
+				// current element of the second in one galloping search.
+				while (true) {
+					if (first2 == last2) return true;
+					iter_reference_t<I2>&& v2 = *first2;
+					auto&& p2 = __stl2::invoke(proj2, v2);
+					auto less = [&](auto&& p1) -> bool {
+						return __stl2::invoke(comp, p1, p2);
+					};
+					first1 = detail::skip_while(std::move(first1), last1, less, proj1);
+					if (first1 == last1) return false;
+					if (__stl2::invoke(comp, p2, __stl2::invoke(proj1, *first1))) {
+						return false;
+					}
+					++first1;
+					++first2;
+				}
+			}
 			while (true) {
 				if (first2 == last2) return true;
 				if (first1 == last1) return false;
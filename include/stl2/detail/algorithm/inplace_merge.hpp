@@ -33,6 +33,7 @@
 #include <stl2/detail/algorithm/upper_bound.hpp>
 #include <stl2/detail/iterator/insert_iterators.hpp>
 #include <stl2/detail/iterator/move_iterator.hpp>
+#include <stl2/detail/memory/relocate.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // inplace_merge [alg.merge]
@@ -139,27 +140,89 @@ STL2_OPEN_NAMESPACE {
 			{
 				STL2_EXPENSIVE_ASSERT(len1 == distance(first, midddle));
 				STL2_EXPENSIVE_ASSERT(len2 == distance(middle, last));
-				temporary_vector<iter_value_t<I>> vec{buf};
-				if (len1 <= len2) {
-					move(first, middle, __stl2::back_inserter(vec));
-					merge(
-						__stl2::make_move_iterator(begin(vec)),
-						__stl2::make_move_iterator(end(vec)),
-						__stl2::make_move_iterator(std::move(middle)),
-						__stl2::make_move_iterator(std::move(last)),
-						std::move(first), __stl2::ref(pred),
-						__stl2::ref(proj), __stl2::ref(proj));
+				if constexpr (byte_relocatable<I>) {
+					iter_value_t<I>* const data = buf.data();
+					if (len1 <= len2) {
+						ext::uninitialized_relocate_n(first, len1, data);
+						relocate_buffered(data, len1, std::move(middle), std::move(last),
+							std::move(first), pred, proj);
+					} else {
+						ext::uninitialized_relocate_n(middle, len2, data);
+						using RBi = reverse_iterator<I>;
+						using RB = reverse_iterator<iter_value_t<I>*>;
+						// Backwards, the first range is taken while it is greater.
+						auto rpred = [&pred](auto&& x, auto&& y) -> bool {
+							return __stl2::invoke(pred, static_cast<decltype(y)&&>(y),
+								static_cast<decltype(x)&&>(x));
+						};
+						relocate_buffered(RB{data + len2}, len2, RBi{std::move(middle)},
+							RBi{std::move(first)}, RBi{std::move(last)}, rpred, proj);
+					}
 				} else {
-					move(middle, last, __stl2::back_inserter(vec));
-					using RBi = reverse_iterator<I>;
-					merge(
-						__stl2::make_move_iterator(RBi{std::move(middle)}),
-						__stl2::make_move_iterator(RBi{std::move(first)}),
-						__stl2::make_move_iterator(rbegin(vec)),
-						__stl2::make_move_iterator(rend(vec)),
-						RBi{std::move(last)},
-						__stl2::not_fn(__stl2::ref(pred)),
-						__stl2::ref(proj), __stl2::ref(proj));
+					temporary_vector<iter_value_t<I>> vec{buf};
+					if (len1 <= len2) {
+						move(first, middle, __stl2::back_inserter(vec));
+						merge_buffered(begin(vec), end(vec), std::move(middle), std::move(last),
+							std::move(first), pred, proj);
+					} else {
+						move(middle, last, __stl2::back_inserter(vec));
+						using RBi = reverse_iterator<I>;
+						// Backwards, the first range is taken while it is greater.
+						auto rpred = [&pred](auto&& x, auto&& y) -> bool {
+							return __stl2::invoke(pred, static_cast<decltype(y)&&>(y),
+								static_cast<decltype(x)&&>(x));
+						};
+						merge_buffered(rbegin(vec), rend(vec), RBi{std::move(middle)},
+							RBi{std::move(first)}, RBi{std::move(last)}, rpred, proj);
+					}
+				}
+			}
+
+			// Merges [first1, last1), moved out to the buffer, with [first2,
+			// last2) into [out, last2). Stops once the buffer is exhausted:
+			// the rest of [first2, last2) is then already in place, and moving
+			// it onto itself would empty types like std::string.
+			template<class B, class I, class C, class P>
+			static void merge_buffered(B first1, const B last1, I first2, const I last2,
+				I out, C& pred, P& proj)
+			{
+				for (; first1 != last1; ++out) {
+					if (first2 == last2) {
+						move(std::move(first1), last1, std::move(out));
+						return;
+					}
+					if (__stl2::invoke(pred, __stl2::invoke(proj, *first2),
+						__stl2::invoke(proj, *first1)))
+					{
+						*out = iter_move(first2);
+						++first2;
+					} else {
+						*out = iter_move(first1);
+						++first1;
+					}
+				}
+			}
+
+			// As merge_buffered, for the n1 elements relocated out to the
+			// buffer from first1: as many holes as are left in the buffer
+			// precede first2, which relocations fill, and which the
+			// remainder of the buffer fills however the merge ends.
+			template<class B, class I, class C, class P>
+			static void relocate_buffered(B first1, iter_difference_t<B> n1, I first2,
+				const I last2, I out, C& pred, P& proj)
+			{
+				detail::relocate_on_exit rest{first1, n1, out};
+				for (; n1 != 0 && first2 != last2; ++out) {
+					if (__stl2::invoke(pred, __stl2::invoke(proj, *first2),
+						__stl2::invoke(proj, *first1)))
+					{
+						detail::relocate_bytes(*out, *first2);
+						++first2;
+					} else {
+						detail::relocate_bytes(*out, *first1);
+						++first1;
+						--n1;
+					}
 				}
 			}
 		};
@@ -191,7 +254,9 @@ STL2_OPEN_NAMESPACE {
 			auto len2_and_end = ext::enumerate(middle, std::move(last));
 			auto buf_size = min(len1, len2_and_end.count);
 			detail::temporary_buffer<iter_value_t<I>> buf;
-			if (std::is_trivially_move_assignable_v<iter_value_t<I>> && 8 < buf_size) {
+			if ((std::is_trivially_move_assignable_v<iter_value_t<I>> ||
+				detail::byte_relocatable<I>) && 8 < buf_size)
+			{
 				buf = detail::temporary_buffer<iter_value_t<I>>{buf_size};
 			}
 			detail::merge_adaptive(std::move(first), std::move(middle), len2_and_end.end,
@@ -13,8 +13,13 @@
 #ifndef STL2_DETAIL_ALGORITHM_IS_PERMUTATION_HPP
 #define STL2_DETAIL_ALGORITHM_IS_PERMUTATION_HPP
 
+#include <bit>
+#include <cstddef>
 #include <limits>
 
+#include <stl2/detail/hash.hpp>
+#include <stl2/detail/simd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
 #include <stl2/detail/algorithm/count_if.hpp>
 #include <stl2/detail/algorithm/find_if.hpp>
 #include <stl2/detail/algorithm/mismatch.hpp>
@@ -26,6 +31,18 @@
 // is_permutation [alg.is_permutation]
 //
 STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Ranges whose elements is_permutation can count in a hash table:
+		// compared with equal_to, and projected to the same Hashable type,
+		// whose std::hash agrees with its ==.
+		template<class I1, class I2, class Pred, class Proj1, class Proj2>
+		META_CONCEPT hash_countable =
+			same_as<__uncvref<indirect_result_t<Proj1&, I1>>,
+				__uncvref<indirect_result_t<Proj2&, I2>>> &&
+			ext::Hashable<__uncvref<indirect_result_t<Proj1&, I1>>> &&
+			simd::is_equal_to<Pred, __uncvref<indirect_result_t<Proj1&, I1>>>;
+	}
+
 	struct __is_permutation_fn : private __niebloid {
 		template<forward_iterator I1, sentinel_for<I1> S1, forward_iterator I2,
 			sentinel_for<I2> S2, class Pred = equal_to, class Proj1 = identity,
@@ -106,7 +123,7 @@ STL2_OPEN_NAMESPACE {
 
 		// Does distance(first, last) == n?
 		template<input_or_output_iterator I, sentinel_for<I> S, signed_integral D>
-		static constexpr bool __has_length(const I first, const S last, const D n) {
+		static constexpr bool __has_length(I first, const S last, const D n) {
 			STL2_EXPECT(n >= 0);
 			if constexpr (sized_sentinel_for<S, I>) {
 				return n == last - first;
@@ -181,6 +198,21 @@ STL2_OPEN_NAMESPACE {
 			STL2_ASSERT(!__stl2::invoke(pred, __stl2::invoke(proj1, *first1), __stl2::invoke(proj2, *first2)));
 			if (n == 1) return false;
 
+			if constexpr (detail::hash_countable<I1, I2, Pred, Proj1, Proj2>) {
+				if (n > __hash_threshold) {
+					// Twice as many slots as elements, a power of two
+					const auto capacity = std::bit_ceil(2 * static_cast<std::size_t>(n));
+					using S = __hash_slot<I1>;
+					detail::temporary_buffer<S> buf{static_cast<std::ptrdiff_t>(capacity)};
+					if (static_cast<std::size_t>(buf.size()) >= capacity) {
+						detail::temporary_vector<S> table{buf};
+						for (std::size_t i = 0; i < capacity; ++i) table.emplace_back();
+						return __is_permutation_hash(first1, first2, n, pred, proj1, proj2,
+							table.begin(), capacity);
+					}
+				}
+			}
+
 			// For each element in [first1, n), see if there are the same number of
 			// equal elements in [first2, n)
 			counted_iterator<I1> i{first1, n};
@@ -213,6 +245,72 @@ STL2_OPEN_NAMESPACE {
 			return true;
 		}
 
+		// Beyond this many elements, counting them in a hash table beats
+		// the quadratic search.
+		static constexpr std::ptrdiff_t __hash_threshold = 32;
+
+		// A slot of the table: the first element of the first range of
+		// some value, its hash, and the number of elements of the first
+		// range of that value less those of the second, or -1 if empty.
+		template<class I>
+		struct __hash_slot {
+			I rep{};
+			std::size_t hash = 0;
+			iter_difference_t<I> count = -1;
+		};
+
+		// Counts the elements of the first range by value in the open
+		// addressing table, then counts down the elements of the second:
+		// expected linear time. The ranges have the same length, so if no
+		// count drops below zero, all end at zero.
+		template<forward_iterator I1, forward_iterator I2,
+			class Pred, class Proj1, class Proj2>
+		static bool __is_permutation_hash(I1 first1, I2 first2,
+			const iter_difference_t<I1> n, Pred& pred, Proj1& proj1, Proj2& proj2,
+			__hash_slot<I1>* const table, const std::size_t capacity)
+		{
+			using V = __uncvref<indirect_result_t<Proj1&, I1>>;
+			constexpr int digits = std::numeric_limits<std::size_t>::digits;
+			// Fibonacci hashing spreads hashes that differ only in their
+			// high bits, as std::hash of integers may, over the table.
+			constexpr auto golden = static_cast<std::size_t>(
+				digits > 32 ? 0x9e3779b97f4a7c15ull : 0x9e3779b9ull);
+			const int shift = digits - std::countr_zero(capacity);
+			const std::size_t mask = capacity - 1;
+
+			// The slot for the element of the given value and hash
+			auto find = [&](auto&& v, const std::size_t h) -> __hash_slot<I1>& {
+				std::size_t i = (h * golden) >> shift;
+				for (;; i = (i + 1) & mask) {
+					__hash_slot<I1>& slot = table[i];
+					if (slot.count < 0) return slot;
+					if (slot.hash == h && __stl2::invoke(pred,
+						__stl2::invoke(proj1, *slot.rep), v))
+					{
+						return slot;
+					}
+				}
+			};
+
+			for (auto i = n; i > 0; --i, ++first1) {
+				auto&& v = __stl2::invoke(proj1, *first1);
+				const std::size_t h = std::hash<V>{}(v);
+				__hash_slot<I1>& slot = find(v, h);
+				if (slot.count < 0) {
+					slot = {first1, h, 1};
+				} else {
+					++slot.count;
+				}
+			}
+			for (auto i = n; i > 0; --i, ++first2) {
+				auto&& v = __stl2::invoke(proj2, *first2);
+				__hash_slot<I1>& slot = find(v, std::hash<V>{}(v));
+				if (slot.count <= 0) return false;
+				--slot.count;
+			}
+			return true;
+		}
+
 		template<forward_iterator I1, forward_iterator I2,
 			class Pred, class Proj1, class Proj2>
 		requires indirectly_comparable<I1, I2, Pred, Proj1, Proj2>
@@ -14,6 +14,7 @@
 
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // is_sorted_until [is.sorted]
@@ -24,6 +25,14 @@ STL2_OPEN_NAMESPACE {
 			indirect_strict_weak_order<projected<I, Proj>> Comp = less>
 		constexpr I
 		operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+			if constexpr (detail::simd::adjacent_order_scannable<I, S, Comp, Proj>) {
+				if (!detail::is_constant_evaluated()) {
+					constexpr int order = detail::simd::order_of<Comp, iter_value_t<I>>;
+					const auto n = static_cast<std::size_t>(last - first);
+					const std::size_t k = detail::simd::adjacent_n<order>(first, n);
+					return first + static_cast<iter_difference_t<I>>(k == n ? n : k + 1);
+				}
+			}
 			if (first != last) {
 				while (true) {
 					auto prev = first;
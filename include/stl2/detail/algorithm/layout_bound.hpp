@@ -0,0 +1,84 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_LAYOUT_BOUND_HPP
+#define STL2_DETAIL_ALGORITHM_LAYOUT_BOUND_HPP
+
+#include <cstddef>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/search_layout.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/functional/comparisons.hpp>
+#include <stl2/view/iota.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// layout_lower_bound, layout_upper_bound, layout_equal_range [Extension]
+//
+// The binary searches over an eytzinger_layout or btree_layout. Each
+// yields ranks, indices in the sorted sequence the layout was built from;
+// the comparison and projection must order it.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class L>
+		META_CONCEPT search_layout = requires(const L& l) {
+			typename L::value_type;
+			{ l.size() } -> same_as<std::size_t>;
+		};
+
+		struct __layout_lower_bound_fn : private __niebloid {
+			template<search_layout L, class T, class Proj = identity,
+				indirect_strict_weak_order<const T*,
+					projected<const typename L::value_type*, Proj>> Comp = less>
+			std::size_t operator()(const L& layout, const T& value, Comp comp = {},
+				Proj proj = {}) const
+			{
+				return layout.partition_point([&](const auto& e) -> bool {
+					return __stl2::invoke(comp, __stl2::invoke(proj, e), value);
+				});
+			}
+		};
+
+		inline constexpr __layout_lower_bound_fn layout_lower_bound{};
+
+		struct __layout_upper_bound_fn : private __niebloid {
+			template<search_layout L, class T, class Proj = identity,
+				indirect_strict_weak_order<const T*,
+					projected<const typename L::value_type*, Proj>> Comp = less>
+			std::size_t operator()(const L& layout, const T& value, Comp comp = {},
+				Proj proj = {}) const
+			{
+				return layout.partition_point([&](const auto& e) -> bool {
+					return !__stl2::invoke(comp, value, __stl2::invoke(proj, e));
+				});
+			}
+		};
+
+		inline constexpr __layout_upper_bound_fn layout_upper_bound{};
+
+		struct __layout_equal_range_fn : private __niebloid {
+			template<search_layout L, class T, class Proj = identity,
+				indirect_strict_weak_order<const T*,
+					projected<const typename L::value_type*, Proj>> Comp = less>
+			iota_view<std::size_t, std::size_t>
+			operator()(const L& layout, const T& value, Comp comp = {},
+				Proj proj = {}) const
+			{
+				return {
+					layout_lower_bound(layout, value, __stl2::ref(comp), __stl2::ref(proj)),
+					layout_upper_bound(layout, value, __stl2::ref(comp), __stl2::ref(proj))
+				};
+			}
+		};
+
+		inline constexpr __layout_equal_range_fn layout_equal_range{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
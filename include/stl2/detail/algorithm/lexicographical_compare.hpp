@@ -14,6 +14,7 @@
 
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // lexicographical_compare [alg.lex.comparison]
@@ -27,6 +28,16 @@ STL2_OPEN_NAMESPACE {
 		constexpr bool operator()(I1 first1, S1 last1, I2 first2, S2 last2,
 			Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (sized_sentinel_for<S1, I1> && sized_sentinel_for<S2, I2> &&
+				detail::simd::order_scannable<I1, I2, Comp, Proj1, Proj2>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					constexpr int order = detail::simd::order_of<Comp, iter_value_t<I1>>;
+					return detail::simd::lexicographical_compare_n<order>(
+						first1, static_cast<std::size_t>(last1 - first1),
+						first2, static_cast<std::size_t>(last2 - first2));
+				}
+			}
 			while (true) {
 				const bool at_end2 = first2 == last2;
 
@@ -0,0 +1,235 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_LOWER_BOUND_BATCH_HPP
+#define STL2_DETAIL_ALGORITHM_LOWER_BOUND_BATCH_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/prefetch.hpp>
+#include <stl2/detail/algorithm/partition_point.hpp>
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// lower_bound_batch [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		// How lower_bound_batch goes about its searches: interleave runs
+		// groups of them in lockstep, while merge sorts the queries and
+		// makes one pass over the sorted range; automatic chooses.
+		enum class batch_strategy : unsigned char { automatic, interleave, merge };
+
+		template<class I, class O>
+		using lower_bound_batch_result = __in_out_result<I, O>;
+	}
+
+	namespace detail {
+		template<class I1, class I2, class O, class Comp, class Proj>
+		META_CONCEPT batch_searchable = random_access_iterator<I1> &&
+			input_iterator<I2> && weakly_incrementable<O> && writable<O, I1> &&
+			copyable<iter_value_t<I2>> && default_initializable<iter_value_t<I2>> &&
+			constructible_from<iter_value_t<I2>, iter_reference_t<I2>> &&
+			indirect_strict_weak_order<Comp, const iter_value_t<I2>*, projected<I1, Proj>>;
+
+		// Searches in groups of this many: enough to keep the memory system
+		// busy with one line for each.
+		inline constexpr std::ptrdiff_t batch_group = 16;
+
+		// The searches of a group halve ranges of the same length, so they
+		// take the same number of steps: each step probes every search of
+		// the group, and prefetches the line each will probe next, which
+		// arrives while the others are probed.
+		template<class I, class D, class Q, class QS, class O, class Comp, class Proj>
+		ext::lower_bound_batch_result<Q, O>
+		lower_bound_interleave(I first, const D n, Q q, QS ql, O out,
+			Comp& comp, Proj& proj)
+		{
+			using V = iter_value_t<Q>;
+			auto const base = ext::uncounted(first);
+			V values[batch_group];
+			D offsets[batch_group];
+			for (bool more = true; more;) {
+				std::ptrdiff_t g = 0;
+				for (; g < batch_group && q != ql; ++g, ++q) {
+					values[g] = V(*q);
+					offsets[g] = 0;
+				}
+				more = g == batch_group;
+
+				D len = n;
+				while (len > 1) {
+					auto const half = len / 2;
+					auto const next_half = (len - half) / 2;
+					for (std::ptrdiff_t j = 0; j < g; ++j) {
+						offsets[j] += __stl2::invoke(comp,
+							__stl2::invoke(proj, base[offsets[j] + half]), values[j])
+							? half : 0;
+						if constexpr (contiguous_iterator<decltype(base)>) {
+							detail::prefetch(std::addressof(base[offsets[j] + next_half]));
+						}
+					}
+					len -= half;
+				}
+				for (std::ptrdiff_t j = 0; j < g; ++j, ++out) {
+					if (len == 1 && __stl2::invoke(comp,
+						__stl2::invoke(proj, base[offsets[j]]), values[j]))
+					{
+						++offsets[j];
+					}
+					*out = first + offsets[j];
+				}
+			}
+			return {std::move(q), std::move(out)};
+		}
+
+		// Sorts the queries, remembering their order, then finds their
+		// bounds in order by galloping forward from the last bound found:
+		// a single pass over the sorted range when the queries are dense
+		// in it. The bounds are written out in the order of the queries.
+		template<class I, class D, class Q, class QS, class O, class Comp, class Proj>
+		ext::lower_bound_batch_result<Q, O>
+		lower_bound_merge(I first, const D n, Q q, QS ql, O out,
+			Comp& comp, Proj& proj)
+		{
+			using V = iter_value_t<Q>;
+			struct query {
+				V value;
+				std::size_t index;
+			};
+			std::vector<query> queries;
+			if constexpr (sized_sentinel_for<QS, Q>) {
+				queries.reserve(static_cast<std::size_t>(ql - q));
+			}
+			for (; q != ql; ++q) {
+				const std::size_t index = queries.size();
+				queries.push_back({V(*q), index});
+			}
+			sort(queries, __stl2::ref(comp), &query::value);
+
+			auto const base = ext::uncounted(first);
+			std::vector<D> bounds(queries.size());
+			D at = 0;
+			for (const query& x : queries) {
+				auto pred = [&](auto&& e) -> bool {
+					return __stl2::invoke(comp, e, x.value);
+				};
+				D step = 1;
+				while (step <= n - at &&
+					pred(__stl2::invoke(proj, base[at + step - 1])))
+				{
+					at += step;
+					step *= 2;
+				}
+				auto const len = step - 1 < n - at ? step - 1 : n - at;
+				at = ext::partition_point_n(base + at, len, pred, __stl2::ref(proj)) - base;
+				bounds[x.index] = at;
+			}
+			for (const D b : bounds) {
+				*out = first + b;
+				++out;
+			}
+			return {std::move(q), std::move(out)};
+		}
+
+		template<class I, class D, class Q, class QS, class O, class Comp, class Proj>
+		ext::lower_bound_batch_result<Q, O>
+		lower_bound_batch(const ext::batch_strategy strategy, I first, const D n,
+			Q q, QS ql, O out, Comp& comp, Proj& proj)
+		{
+			bool merge = strategy == ext::batch_strategy::merge;
+			if constexpr (sized_sentinel_for<QS, Q>) {
+				// When there are enough queries to touch most lines of a
+				// range that exceeds the cache, a pass over it beats that many
+				// random accesses.
+				if (strategy == ext::batch_strategy::automatic) {
+					auto const bytes = static_cast<std::size_t>(n) * sizeof(iter_value_t<I>);
+					auto const lines = bytes / detail::cache_line;
+					merge = bytes > (std::size_t{1} << 22) &&
+						static_cast<std::size_t>(ql - q) >= lines / 4;
+				}
+			}
+			if (merge) {
+				return detail::lower_bound_merge(std::move(first), n, std::move(q),
+					std::move(ql), std::move(out), comp, proj);
+			}
+			return detail::lower_bound_interleave(std::move(first), n, std::move(q),
+				std::move(ql), std::move(out), comp, proj);
+		}
+	}
+
+	namespace ext {
+		// Writes to out, for each query in turn, the position lower_bound
+		// would find for it in the sorted range: the same results as a loop
+		// of lower_bound, without waiting on one miss after another.
+		struct __lower_bound_batch_fn : private __niebloid {
+			template<random_access_iterator I1, sentinel_for<I1> S1, input_iterator I2,
+				sentinel_for<I2> S2, weakly_incrementable O, class Comp = less,
+				class Proj = identity>
+			requires detail::batch_searchable<I1, I2, O, Comp, Proj>
+			lower_bound_batch_result<I2, O>
+			operator()(batch_strategy strategy, I1 first1, S1 last1, I2 first2,
+				S2 last2, O out, Comp comp = {}, Proj proj = {}) const
+			{
+				auto const n = distance(first1, std::move(last1));
+				return detail::lower_bound_batch(strategy, std::move(first1), n,
+					std::move(first2), std::move(last2), std::move(out), comp, proj);
+			}
+
+			template<random_access_iterator I1, sentinel_for<I1> S1, input_iterator I2,
+				sentinel_for<I2> S2, weakly_incrementable O, class Comp = less,
+				class Proj = identity>
+			requires detail::batch_searchable<I1, I2, O, Comp, Proj>
+			lower_bound_batch_result<I2, O>
+			operator()(I1 first1, S1 last1, I2 first2, S2 last2, O out,
+				Comp comp = {}, Proj proj = {}) const
+			{
+				return (*this)(batch_strategy::automatic, std::move(first1),
+					std::move(last1), std::move(first2), std::move(last2),
+					std::move(out), __stl2::ref(comp), __stl2::ref(proj));
+			}
+
+			template<random_access_range R1, input_range R2, weakly_incrementable O,
+				class Comp = less, class Proj = identity>
+			requires _ForwardingRange<R1> &&
+				detail::batch_searchable<iterator_t<R1>, iterator_t<R2>, O, Comp, Proj>
+			lower_bound_batch_result<safe_iterator_t<R2>, O>
+			operator()(batch_strategy strategy, R1&& sorted, R2&& queries, O out,
+				Comp comp = {}, Proj proj = {}) const
+			{
+				return detail::lower_bound_batch(strategy, begin(sorted),
+					distance(sorted), begin(queries), end(queries), std::move(out),
+					comp, proj);
+			}
+
+			template<random_access_range R1, input_range R2, weakly_incrementable O,
+				class Comp = less, class Proj = identity>
+			requires _ForwardingRange<R1> &&
+				detail::batch_searchable<iterator_t<R1>, iterator_t<R2>, O, Comp, Proj>
+			lower_bound_batch_result<safe_iterator_t<R2>, O>
+			operator()(R1&& sorted, R2&& queries, O out, Comp comp = {},
+				Proj proj = {}) const
+			{
+				return (*this)(batch_strategy::automatic, sorted,
+					static_cast<R2&&>(queries), std::move(out), __stl2::ref(comp),
+					__stl2::ref(proj));
+			}
+		};
+
+		inline constexpr __lower_bound_batch_fn lower_bound_batch{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
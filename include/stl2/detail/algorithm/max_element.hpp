@@ -14,6 +14,7 @@
 
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // max_element [alg.min.max]
@@ -24,6 +25,15 @@ STL2_OPEN_NAMESPACE {
 			indirect_strict_weak_order<projected<I, Proj>> Comp = less>
 		constexpr I
 		operator()(I first, S last, Comp comp = {}, Proj proj = {}) const {
+			if constexpr (detail::simd::extremum_scannable<I, S, Comp, Proj>) {
+				if (!detail::is_constant_evaluated()) {
+					constexpr int order = detail::simd::order_of<Comp, iter_value_t<I>>;
+					const auto n = last - first;
+					return first + static_cast<iter_difference_t<I>>(
+						detail::simd::extrema_n<order, false, true>(first,
+							static_cast<std::size_t>(n)).max);
+				}
+			}
 			if (first != last) {
 				for (auto i = next(first); i != last; ++i) {
 					if (!__stl2::invoke(comp,
@@ -0,0 +1,131 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_MEMCOPY_HPP
+#define STL2_DETAIL_ALGORITHM_MEMCOPY_HPP
+
+#include <memory>
+#include <type_traits>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/simd.hpp>
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
+#include <stl2/detail/iterator/move_iterator.hpp>
+#include <stl2/detail/iterator/reverse_iterator.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Block copies, for the copy and move algorithms
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// How an iterator walks an array of element_type: in increasing
+		// (direction 1) or decreasing (-1) order of address, through any
+		// move_iterator, reverse_iterator and counted_iterator about a
+		// contiguous iterator. For other iterators, the direction is 0.
+		template<class I>
+		struct memory_walk {
+			static constexpr int direction = 0;
+		};
+
+		template<contiguous_iterator I>
+		struct memory_walk<I> {
+			using element_type = std::remove_reference_t<iter_reference_t<I>>;
+			static constexpr int direction = 1;
+
+			static element_type* address(const I& i) {
+				return std::addressof(*i);
+			}
+			static I advance(const I& i, const iter_difference_t<I> n) {
+				return i + n;
+			}
+		};
+
+		template<class I>
+		requires (memory_walk<I>::direction != 0)
+		struct memory_walk<move_iterator<I>> : memory_walk<I> {
+			static auto address(const move_iterator<I>& i) {
+				return memory_walk<I>::address(i.base());
+			}
+			static move_iterator<I> advance(const move_iterator<I>& i,
+				const iter_difference_t<I> n)
+			{
+				return move_iterator<I>{memory_walk<I>::advance(i.base(), n)};
+			}
+		};
+
+		template<class I>
+		requires (memory_walk<I>::direction != 0)
+		struct memory_walk<reverse_iterator<I>> : memory_walk<I> {
+			static constexpr int direction = -memory_walk<I>::direction;
+
+			static auto address(const reverse_iterator<I>& i) {
+				return memory_walk<I>::address(memory_walk<I>::advance(i.base(), -1));
+			}
+			static reverse_iterator<I> advance(const reverse_iterator<I>& i,
+				const iter_difference_t<I> n)
+			{
+				return reverse_iterator<I>{memory_walk<I>::advance(i.base(), -n)};
+			}
+		};
+
+		// counted_iterators about contiguous iterators are contiguous.
+		template<class I>
+		requires (!contiguous_iterator<I> && memory_walk<I>::direction != 0)
+		struct memory_walk<counted_iterator<I>> : memory_walk<I> {
+			static auto address(const counted_iterator<I>& i) {
+				return memory_walk<I>::address(i.base());
+			}
+			static counted_iterator<I> advance(const counted_iterator<I>& i,
+				const iter_difference_t<I> n)
+			{
+				return counted_iterator<I>{memory_walk<I>::advance(i.base(), n),
+					i.count() - n};
+			}
+		};
+
+		// Element-wise assignments from the elements of I, as R, to those of
+		// O, that a block copy of their bytes can make instead: both walk
+		// the same way over arrays of the same trivially copyable type,
+		// which R assigns trivially.
+		template<class I, class O, class R>
+		META_CONCEPT memcopyable = memory_walk<I>::direction != 0 &&
+			memory_walk<I>::direction == memory_walk<O>::direction &&
+			same_as<std::remove_const_t<typename memory_walk<I>::element_type>,
+				typename memory_walk<O>::element_type> &&
+			!std::is_volatile_v<typename memory_walk<O>::element_type> &&
+			std::is_trivially_copyable_v<typename memory_walk<O>::element_type> &&
+			std::is_trivially_assignable_v<typename memory_walk<O>::element_type&, R>;
+
+		// The least address of the n > 0 elements of the walk from i.
+		template<class I>
+		auto* block_address(const I& i, const iter_difference_t<I> n) {
+			using W = memory_walk<I>;
+			return W::direction > 0 ? W::address(i) : W::address(W::advance(i, n - 1));
+		}
+
+		// Copies the n elements of the walk from first over those of the
+		// walk from result, forward (!Backward) or to those that end at
+		// result, as one block, which may overlap the source either way.
+		// Returns the ends of the two walks.
+		template<bool Backward = false, class I, class O>
+		__in_out_result<I, O> memcopy(I first, const iter_difference_t<I> n, O result) {
+			const auto m = static_cast<iter_difference_t<O>>(Backward ? -n : n);
+			if (n <= 0) return {std::move(first), std::move(result)};
+			I last = memory_walk<I>::advance(first, n);
+			O out = memory_walk<O>::advance(result, m);
+			using T = typename memory_walk<O>::element_type;
+			simd::copy_bytes(detail::block_address(Backward ? out : result, n),
+				detail::block_address(first, n), static_cast<std::size_t>(n) * sizeof(T));
+			return {std::move(last), std::move(out)};
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,67 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_MEMFILL_HPP
+#define STL2_DETAIL_ALGORITHM_MEMFILL_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/simd.hpp>
+#include <stl2/detail/algorithm/memcopy.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Block fills, for the fill and uninitialized fill algorithms
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Walks of arrays of a trivially copyable type, whose elements may be
+		// made copies of one another by copying bytes.
+		template<class O>
+		META_CONCEPT memfill_walk = memory_walk<O>::direction != 0 &&
+			!std::is_const_v<typename memory_walk<O>::element_type> &&
+			!std::is_volatile_v<typename memory_walk<O>::element_type> &&
+			std::is_trivially_copyable_v<typename memory_walk<O>::element_type>;
+
+		// ... whose elements are assigned a T trivially,
+		template<class O, class T>
+		META_CONCEPT memfillable = memfill_walk<O> &&
+			std::is_trivially_assignable_v<typename memory_walk<O>::element_type&, const T&>;
+
+		// ... or constructed from Args trivially.
+		template<class O, class... Args>
+		META_CONCEPT memconstructible = memfill_walk<O> &&
+			std::is_trivially_constructible_v<typename memory_walk<O>::element_type, Args...>;
+
+		// Sets the first of the n elements of the walk from first by
+		// init(element), which is free of side effects, and if its bytes
+		// are all alike, as those of zero and of any byte are, fills the
+		// others with the same byte: by memset, or streaming stores for
+		// many. Returns whether it did; if not, only the first element
+		// has been set, and the others are untouched.
+		template<class O, class Init>
+		bool memfill(const O& first, const iter_difference_t<O> n, Init init) {
+			using W = memory_walk<O>;
+			using T = typename W::element_type;
+			if (n <= 0) return false;
+			T* const p = W::address(first);
+			init(*p);
+			const auto bytes = reinterpret_cast<const unsigned char*>(p);
+			const unsigned char byte = bytes[0];
+			for (std::size_t k = 1; k < sizeof(T); ++k) {
+				if (bytes[k] != byte) return false;
+			}
+			simd::fill_bytes(detail::block_address(first, n), byte,
+				static_cast<std::size_t>(n) * sizeof(T));
+			return true;
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
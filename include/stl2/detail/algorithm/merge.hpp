@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_MERGE_HPP
 #define STL2_DETAIL_ALGORITHM_MERGE_HPP
 
+#include <type_traits>
 #include <stl2/detail/algorithm/copy.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
@@ -24,6 +25,21 @@ STL2_OPEN_NAMESPACE {
 	template<class I1, class I2, class O>
 	using merge_result = __in_in_out_result<I1, I2, O>;
 
+	namespace detail {
+		// Sized random-access ranges of the same small, trivially copyable
+		// elements, which the merge can copy out and choose between without
+		// a branch.
+		template<class I1, class S1, class I2, class S2>
+		META_CONCEPT branchless_mergeable = random_access_iterator<I1> &&
+			sized_sentinel_for<S1, I1> && random_access_iterator<I2> &&
+			sized_sentinel_for<S2, I2> &&
+			same_as<iter_value_t<I1>, iter_value_t<I2>> &&
+			std::is_trivially_copyable_v<iter_value_t<I1>> &&
+			sizeof(iter_value_t<I1>) <= 2 * sizeof(void*) &&
+			same_as<iter_reference_t<I1>, iter_value_t<I1>&> &&
+			same_as<iter_reference_t<I2>, iter_value_t<I1>&>;
+	}
+
 	struct __merge_fn : private __niebloid {
 		template<input_iterator I1, sentinel_for<I1> S1, input_iterator I2, sentinel_for<I2> S2,
 			weakly_incrementable O, class Comp = less, class Proj1 = identity,
@@ -33,6 +49,11 @@ STL2_OPEN_NAMESPACE {
 		operator()(I1 first1, S1 last1, I2 first2, S2 last2, O result,
 			Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (detail::branchless_mergeable<I1, S1, I2, S2>) {
+				return branchless(std::move(first1), std::move(last1),
+					std::move(first2), std::move(last2), std::move(result),
+					comp, proj1, proj2);
+			}
 			while (true) {
 				if (first1 == last1) {
 					auto cresult = copy(std::move(first2), std::move(last2), std::move(result));
@@ -48,12 +69,12 @@ STL2_OPEN_NAMESPACE {
 				}
 				iter_reference_t<I1>&& v1 = *first1;
 				iter_reference_t<I2>&& v2 = *first2;
-				if (__stl2::invoke(comp, __stl2::invoke(proj1, v1), __stl2::invoke(proj2, v2))) {
-					*result = std::forward<iter_reference_t<I1>>(v1);
-					++first1;
-				} else {
+				if (__stl2::invoke(comp, __stl2::invoke(proj2, v2), __stl2::invoke(proj1, v1))) {
 					*result = std::forward<iter_reference_t<I2>>(v2);
 					++first2;
+				} else {
+					*result = std::forward<iter_reference_t<I1>>(v1);
+					++first1;
 				}
 				++result;
 			}
@@ -70,6 +91,45 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r1), end(r1), begin(r2), end(r2),
 				std::move(result), __stl2::ref(comp), __stl2::ref(proj1), __stl2::ref(proj2));
 		}
+	private:
+		// The loop above, with the comparison selecting the element to copy
+		// and the input to advance rather than branching on it: a merge of
+		// inputs that interleave at random otherwise mispredicts half its
+		// branches. Neither input can run out within as many steps as the
+		// shorter has left, so only every so many steps check the bounds.
+		template<class I1, class S1, class I2, class S2, class O, class Comp,
+			class Proj1, class Proj2>
+		static constexpr merge_result<I1, I2, O>
+		branchless(I1 first1, S1 last1, I2 first2, S2 last2, O result,
+			Comp& comp, Proj1& proj1, Proj2& proj2)
+		{
+			using T = iter_value_t<I1>;
+			using D1 = iter_difference_t<I1>;
+			using D2 = iter_difference_t<I2>;
+			const D1 n1 = last1 - first1;
+			const D2 n2 = last2 - first2;
+			D1 i = 0;
+			D2 j = 0;
+			while (i < n1 && j < n2) {
+				const D1 left1 = n1 - i;
+				const D2 left2 = n2 - j;
+				for (auto steps = left1 < left2 ? left1 : static_cast<D1>(left2);
+					steps > 0; --steps)
+				{
+					T x = first1[i];
+					T y = first2[j];
+					const bool second = __stl2::invoke(comp,
+						__stl2::invoke(proj2, y), __stl2::invoke(proj1, x));
+					*result = second ? y : x;
+					++result;
+					j += second;
+					i += !second;
+				}
+			}
+			auto rest1 = copy(first1 + i, std::move(last1), std::move(result));
+			auto rest2 = copy(first2 + j, std::move(last2), std::move(rest1.out));
+			return {std::move(rest1.in), std::move(rest2.in), std::move(rest2.out)};
+		}
 	};
 
 	inline constexpr __merge_fn merge{};
@@ -19,6 +19,7 @@
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // minmax_element [alg.min.max]
@@ -30,6 +31,16 @@ STL2_OPEN_NAMESPACE {
 		constexpr minmax_result<I>
 		operator()(I first, S last, Comp comp = {}, Proj proj = {}) const
 		{
+			if constexpr (detail::simd::extremum_scannable<I, S, Comp, Proj>) {
+				if (!detail::is_constant_evaluated()) {
+					constexpr int order = detail::simd::order_of<Comp, iter_value_t<I>>;
+					const auto n = last - first;
+					const auto r = detail::simd::extrema_n<order, true, true>(first,
+						static_cast<std::size_t>(n));
+					return {first + static_cast<iter_difference_t<I>>(r.min),
+						first + static_cast<iter_difference_t<I>>(r.max)};
+				}
+			}
 			minmax_result<I> result{first, first};
 			if (first == last || ++first == last) return result;
 
@@ -15,6 +15,7 @@
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // mismatch [mismatch]
@@ -32,6 +33,19 @@ STL2_OPEN_NAMESPACE {
 		operator()(I1 first1, S1 last1, I2 first2, S2 last2, Pred pred = {},
 			Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (sized_sentinel_for<S1, I1> && sized_sentinel_for<S2, I2> &&
+				detail::simd::equality_scannable<I1, I2, Pred, Proj1, Proj2>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					const auto n1 = last1 - first1;
+					const auto n2 = last2 - first2;
+					const auto n = static_cast<std::size_t>(n1 < n2 ? n1 : n2);
+					const auto i = detail::simd::mismatch_n(first1, first2, n);
+					first1 += i;
+					first2 += static_cast<iter_difference_t<I2>>(i);
+					return {std::move(first1), std::move(first2)};
+				}
+			}
 			while (true) {
 				if (first1 == last1) break;
 				if (first2 == last2) break;
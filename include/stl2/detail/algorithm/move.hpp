@@ -13,6 +13,7 @@
 #define STL2_DETAIL_ALGORITHM_MOVE_HPP
 
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/memcopy.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
@@ -28,6 +29,14 @@ STL2_OPEN_NAMESPACE {
 		requires indirectly_movable<I, O>
 		constexpr move_result<I, O>
 		operator()(I first, S last, O result) const {
+			if constexpr (sized_sentinel_for<S, I> &&
+				detail::memcopyable<I, O, iter_rvalue_reference_t<I>>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					auto const n = last - first;
+					return detail::memcopy(std::move(first), n, std::move(result));
+				}
+			}
 			for (; first != last; (void) ++first, (void) ++result) {
 				*result = iter_move(first);
 			}
@@ -50,6 +59,14 @@ STL2_OPEN_NAMESPACE {
 			requires indirectly_movable<I, O>
 			constexpr move_result<I, O>
 			operator()(I first, S last, O result) const {
+				if constexpr (sized_sentinel_for<S, I> &&
+					detail::memcopyable<I, O, iter_rvalue_reference_t<I>>)
+				{
+					if (!detail::is_constant_evaluated()) {
+						auto const n = last - first;
+						return detail::memcopy(std::move(first), n, std::move(result));
+					}
+				}
 				for (; first != last; (void) ++first, (void) ++result) {
 					*result = iter_move(first);
 				}
@@ -71,6 +88,17 @@ STL2_OPEN_NAMESPACE {
 			requires indirectly_movable<I1, I2>
 			constexpr move_result<I1, I2>
 			operator()(I1 first1, S1 last1, I2 first2, S2 last2) const {
+				if constexpr (sized_sentinel_for<S1, I1> && sized_sentinel_for<S2, I2> &&
+					detail::memcopyable<I1, I2, iter_rvalue_reference_t<I1>>)
+				{
+					if (!detail::is_constant_evaluated()) {
+						auto const n1 = last1 - first1;
+						auto const n2 = last2 - first2;
+						return detail::memcopy(std::move(first1),
+							n2 < n1 ? static_cast<iter_difference_t<I1>>(n2) : n1,
+							std::move(first2));
+					}
+				}
 				while (true) {
 					if (first1 == last1) break;
 					if (first2 == last2) break;
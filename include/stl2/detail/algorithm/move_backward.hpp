@@ -12,6 +12,7 @@
 #ifndef STL2_DETAIL_ALGORITHM_MOVE_BACKWARD_HPP
 #define STL2_DETAIL_ALGORITHM_MOVE_BACKWARD_HPP
 
+#include <stl2/detail/algorithm/memcopy.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
@@ -28,6 +29,14 @@ STL2_OPEN_NAMESPACE {
 		requires indirectly_movable<I1, I2>
 		constexpr move_backward_result<I1, I2>
 		operator()(I1 first, S1 s, I2 result) const {
+			if constexpr (sized_sentinel_for<S1, I1> &&
+				detail::memcopyable<I1, I2, iter_rvalue_reference_t<I1>>)
+			{
+				if (!detail::is_constant_evaluated()) {
+					auto const n = s - first;
+					return detail::memcopy<true>(std::move(first), n, std::move(result));
+				}
+			}
 			auto last = next(first, std::move(s));
 			auto i = last;
 			while (i != first) {
@@ -22,6 +22,9 @@
 #ifndef STL2_DETAIL_ALGORITHM_NTH_ELEMENT_HPP
 #define STL2_DETAIL_ALGORITHM_NTH_ELEMENT_HPP
 
+#include <cmath>
+#include <utility>
+#include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/min_element.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -31,13 +34,33 @@
 //
 STL2_OPEN_NAMESPACE {
 	struct __nth_element_fn : private __niebloid {
-		// TODO: refactor this monstrosity.
 		template<random_access_iterator I, sentinel_for<I> S, class Comp = less,
 			class Proj = identity>
 		requires sortable<I, Comp, Proj>
 		constexpr I operator()(I first, I nth, S last, Comp comp = {},
 			Proj proj = {}) const
 		{
+			I end = next(nth, last);
+			select(std::move(first), std::move(nth), end, comp, proj);
+			return end;
+		}
+
+		template<random_access_range Rng, class Comp = less, class Proj = identity>
+		requires sortable<iterator_t<Rng>, Comp, Proj>
+		constexpr safe_iterator_t<Rng> operator()(Rng&& rng, iterator_t<Rng> nth,
+			Comp comp = {}, Proj proj = {}) const
+		{
+			return (*this)(begin(rng), std::move(nth), end(rng),
+				__stl2::ref(comp), __stl2::ref(proj));
+		}
+	private:
+		// Quickselect with median-of-3 pivots, or for large ranges a pivot
+		// chosen by Floyd and Rivest's sampling. Should two partitions in a
+		// row fail to halve the range, the rest falls back to median of
+		// medians, which bounds the worst case to linear time.
+		template<random_access_iterator I, class C, class P>
+		requires sortable<I, C, P>
+		static constexpr void select(I first, I nth, I end, C& comp, P& proj) {
 			constexpr iter_difference_t<I> limit = 7;
 			static_assert(limit >= 3);
 
@@ -47,35 +70,63 @@ STL2_OPEN_NAMESPACE {
 					__stl2::invoke(proj, static_cast<decltype(rhs)>(rhs)));
 			};
 
-			I end_orig = next(nth, last);
-			I end = end_orig;
+			// The range must halve every two partitions.
+			auto checkpoint = end - first;
+			int steps = 0;
 			while (true) {
-				if (nth == end) return end_orig;
+				if (nth == end) return;
 
 				iter_difference_t<I> len = end - first;
 				STL2_EXPECT(len >= 0);
 				switch (len) {
 				case 0:
 				case 1:
-					return end_orig;
+					return;
 				case 2:
 					if (pred(*--end, *first)) iter_swap(first, end);
-					return end_orig;
+					return;
 				case 3:
 					{
 						I m = first;
 						sort3(first, ++m, --end, comp, proj);
-						return end_orig;
+						return;
 					}
 				default: break;
 				}
 				if (len <= limit) {
 					selection_sort(first, end, comp, proj);
-					return end_orig;
+					return;
 				}
 				// Post: len > limit
 
+				if (steps == 2) {
+					if (len > checkpoint / 2) {
+						select_linear(first, nth, end, comp, proj);
+						return;
+					}
+					checkpoint = len;
+					steps = 0;
+				}
+				++steps;
+
 				I m = first + len / 2;
+				if (len > floyd_rivest_threshold && first < nth && nth < end - 1 &&
+					!detail::is_constant_evaluated())
+				{
+					// Floyd and Rivest: select nth within a sample around it,
+					// so that the pivot lands just past nth on the side of
+					// the smaller partition. The sample is gathered from
+					// across the range, which patterned input needs.
+					auto [lo, hi] = floyd_rivest_sample(len, nth - first);
+					if (hi - lo < len) {
+						const auto stride = len / (hi - lo);
+						for (auto k = lo; k < hi; ++k) {
+							iter_swap(first + k, first + (k - lo) * stride);
+						}
+						select(first + lo, nth, first + hi, comp, proj);
+						m = nth;
+					}
+				}
 				I lm1 = end;
 				unsigned n_swaps = sort3(first, m, --lm1, comp, proj);
 				// Post: *m is median
@@ -100,7 +151,7 @@ STL2_OPEN_NAMESPACE {
 							if (!pred(*first, *--j)) {  // we need a guard if *first == *(end-1)
 								while (true) {
 									if (i == j) {
-										return end_orig;  // [first, end) all equivalent elements
+										return;  // [first, end) all equivalent elements
 									}
 									if (pred(*first, *i)) {
 										iter_swap(i, j);
@@ -112,7 +163,7 @@ STL2_OPEN_NAMESPACE {
 								}
 							}
 							// [first, i) == *first and *first < [j, end) and j == end - 1
-							if (i == j) return end_orig;
+							if (i == j) return;
 
 							while (true) {
 								while (!pred(*first, *i)) { ++i; }
@@ -124,7 +175,7 @@ STL2_OPEN_NAMESPACE {
 							}
 							// [first, i) == *first and *first < [i, end)
 							// The first part is sorted,
-							if (nth < i) return end_orig;
+							if (nth < i) return;
 
 							// nth_element the second part
 							// nth_element<C>(i, nth, end, comp);
@@ -167,7 +218,7 @@ STL2_OPEN_NAMESPACE {
 					++n_swaps;
 				}
 				// [first, i) < *i and *i <= [i+1, end)
-				if (nth == i) return end_orig;
+				if (nth == i) return;
 
 				if (n_swaps == 0) {
 					// We were given a perfectly partitioned sequence.  Coincidence?
@@ -177,7 +228,7 @@ STL2_OPEN_NAMESPACE {
 						while (true) {
 							if (++j == i) {
 								// [first, i) sorted
-								return end_orig;
+								return;
 							}
 							if (pred(*j, *m)) {
 								// not yet sorted, so sort
@@ -191,7 +242,7 @@ STL2_OPEN_NAMESPACE {
 						while (true) {
 							if (++j == end) {
 								// [i, end) sorted
-								return end_orig;
+								return;
 							}
 							if (pred(*j, *m)) {
 								// not yet sorted, so sort
@@ -211,18 +262,90 @@ STL2_OPEN_NAMESPACE {
 					first = ++i;
 				}
 			}
-			return end_orig;
 		}
 
-		template<random_access_range Rng, class Comp = less, class Proj = identity>
-		requires sortable<iterator_t<Rng>, Comp, Proj>
-		constexpr safe_iterator_t<Rng> operator()(Rng&& rng, iterator_t<Rng> nth,
-			Comp comp = {}, Proj proj = {}) const
-		{
-			return (*this)(begin(rng), std::move(nth), end(rng),
-				__stl2::ref(comp), __stl2::ref(proj));
+		static constexpr std::ptrdiff_t floyd_rivest_threshold = 600;
+
+		// The bounds [lo, hi) of Floyd and Rivest's sample around k in a
+		// range of n elements.
+		template<class D>
+		static std::pair<D, D> floyd_rivest_sample(const D n, const D k) {
+			const double dn = static_cast<double>(n);
+			const double i = static_cast<double>(k + 1);
+			const double z = std::log(dn);
+			const double s = 0.5 * std::exp(2 * z / 3);
+			const double sd = 0.5 * std::sqrt(z * s * (dn - s) / dn) * (2 * i < dn ? -1 : 1);
+			D lo = static_cast<D>(static_cast<double>(k) - i * s / dn + sd);
+			D hi = static_cast<D>(static_cast<double>(k) + (dn - i) * s / dn + sd) + 1;
+			lo = lo < 0 ? 0 : (lo > k ? k : lo);
+			hi = hi > n ? n : (hi <= k ? k + 1 : hi);
+			return {lo, hi};
 		}
-	private:
+
+		// Blum, Floyd, Pratt, Rivest and Tarjan's median of medians: the
+		// pivot is the median of the medians of groups of five, which has
+		// at least 3/10 of the range on either side of it. Equivalent
+		// elements are gathered around the pivot, so duplicates cannot
+		// unbalance the partition.
+		template<random_access_iterator I, class C, class P>
+		requires sortable<I, C, P>
+		static constexpr void select_linear(I first, I nth, I end, C& comp, P& proj) {
+			constexpr iter_difference_t<I> limit = 7;
+			auto pred = [&](auto&& lhs, auto&& rhs) -> bool {
+				return __stl2::invoke(comp,
+					__stl2::invoke(proj, static_cast<decltype(lhs)>(lhs)),
+					__stl2::invoke(proj, static_cast<decltype(rhs)>(rhs)));
+			};
+
+			while (nth != end) {
+				const auto len = end - first;
+				if (len <= limit) {
+					if (len > 1) {
+						selection_sort(first, end, comp, proj);
+					}
+					return;
+				}
+
+				// Gather the medians of the groups at the front, and find
+				// their median.
+				const auto groups = len / 5;
+				for (iter_difference_t<I> g = 0; g < groups; ++g) {
+					I group = first + 5 * g;
+					selection_sort(group, group + 5, comp, proj);
+					iter_swap(first + g, group + 2);
+				}
+				I pivot = first + groups / 2;
+				select_linear(first, pivot, first + groups, comp, proj);
+
+				// Partition into [first + 1, lt) < *first, [lt, i) equivalent
+				// to *first, and [gt, end) > *first.
+				iter_swap(first, pivot);
+				I lt = first + 1;
+				I i = lt;
+				I gt = end;
+				while (i < gt) {
+					if (pred(*i, *first)) {
+						iter_swap(lt, i);
+						++lt;
+						++i;
+					} else if (pred(*first, *i)) {
+						iter_swap(i, --gt);
+					} else {
+						++i;
+					}
+				}
+				iter_swap(first, --lt);
+
+				if (nth < lt) {
+					end = lt;
+				} else if (nth >= gt) {
+					first = gt;
+				} else {
+					return;
+				}
+			}
+		}
+
 		// stable, 2-3 compares, 0-2 swaps
 		template<class I, class C, class P>
 		requires sortable<I, C, P>
@@ -15,6 +15,8 @@
 
 #include <stl2/detail/algorithm/heap_sift.hpp>
 #include <stl2/detail/algorithm/make_heap.hpp>
+#include <stl2/detail/algorithm/nth_element.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
 #include <stl2/detail/algorithm/sort_heap.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -22,6 +24,11 @@
 ///////////////////////////////////////////////////////////////////////////
 // partial_sort [partial.sort]
 //
+// Small prefixes are selected through a heap, which sifts only the few
+// elements that beat its root; once the prefix is more than a small
+// fraction of the range, selecting it with nth_element and sorting it is
+// cheaper.
+//
 STL2_OPEN_NAMESPACE {
 	struct __partial_sort_fn : private __niebloid {
 		template<random_access_iterator I, sentinel_for<I> S, class Comp = less,
@@ -30,10 +37,17 @@ STL2_OPEN_NAMESPACE {
 		constexpr I operator()(I first, I middle, S last, Comp comp = {},
 			Proj proj = {}) const
 		{
-			make_heap(first, middle, __stl2::ref(comp), __stl2::ref(proj));
 			const auto len = distance(first, middle);
+			I end = next(middle, std::move(last));
+			if (len > heap_select_limit && (end - first) / heap_select_ratio < len) {
+				nth_element(first, middle, end, __stl2::ref(comp), __stl2::ref(proj));
+				sort(first, middle, __stl2::ref(comp), __stl2::ref(proj));
+				return end;
+			}
+
+			make_heap(first, middle, __stl2::ref(comp), __stl2::ref(proj));
 			I i = middle;
-			for(; i != last; ++i) {
+			for(; i != end; ++i) {
 				if(__stl2::invoke(comp,
 						__stl2::invoke(proj, *i),
 						__stl2::invoke(proj, *first))) {
@@ -55,6 +69,11 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r), std::move(middle), end(r),
 				__stl2::ref(comp), __stl2::ref(proj));
 		}
+	private:
+		// nth_element and sort take over once the prefix is longer than both
+		// of these and than 1 / heap_select_ratio of the range.
+		static constexpr std::ptrdiff_t heap_select_limit = 64;
+		static constexpr std::ptrdiff_t heap_select_ratio = 256;
 	};
 
 	inline constexpr __partial_sort_fn partial_sort{};
@@ -22,6 +22,8 @@
 #ifndef STL2_DETAIL_ALGORITHM_PARTITION_POINT_HPP
 #define STL2_DETAIL_ALGORITHM_PARTITION_POINT_HPP
 
+#include <memory>
+#include <stl2/detail/prefetch.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -38,17 +40,51 @@ STL2_OPEN_NAMESPACE {
 				Proj proj = {}) const
 			{
 				STL2_EXPECT(0 <= n);
-				while (n != 0) {
+				if constexpr (random_access_iterator<I>) {
+					return branchless(std::move(first), n, pred, proj);
+				} else {
+					while (n != 0) {
+						auto const half = n / 2;
+						auto middle = next(ext::uncounted(first), half);
+						if (__stl2::invoke(pred, __stl2::invoke(proj, *middle))) {
+							first = ext::recounted(first, std::move(++middle), half + 1);
+							n -= half + 1;
+						} else {
+							n = half;
+						}
+					}
+					return first;
+				}
+			}
+		private:
+			// Halves the range by moving its base, rather than by branching
+			// on the predicate, so that the loop runs a fixed number of
+			// times with nothing to mispredict. Over contiguous elements,
+			// both candidates for the next probe are prefetched: on arrays
+			// larger than the cache, the misses of successive levels then
+			// overlap.
+			template<random_access_iterator I, class Pred, class Proj>
+			static constexpr I branchless(I first, iter_difference_t<I> n,
+				Pred& pred, Proj& proj)
+			{
+				auto const base = ext::uncounted(first);
+				auto middle = base;
+				while (n > 1) {
 					auto const half = n / 2;
-					auto middle = next(ext::uncounted(first), half);
-					if (__stl2::invoke(pred, __stl2::invoke(proj, *middle))) {
-						first = ext::recounted(first, std::move(++middle), half + 1);
-						n -= half + 1;
-					} else {
-						n = half;
+					if constexpr (contiguous_iterator<decltype(middle)>) {
+						auto const next_half = (n - half) / 2;
+						detail::prefetch(std::addressof(middle[next_half]));
+						detail::prefetch(std::addressof(middle[half + next_half]));
 					}
+					middle += __stl2::invoke(pred, __stl2::invoke(proj, middle[half]))
+						? half : 0;
+					n -= half;
+				}
+				if (n == 1 && __stl2::invoke(pred, __stl2::invoke(proj, *middle))) {
+					++middle;
 				}
-				return first;
+				auto const offset = middle - base;
+				return ext::recounted(first, std::move(middle), offset);
 			}
 		};
 
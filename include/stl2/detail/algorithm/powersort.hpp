@@ -0,0 +1,368 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_POWERSORT_HPP
+#define STL2_DETAIL_ALGORITHM_POWERSORT_HPP
+
+#include <array>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/move_backward.hpp>
+#include <stl2/detail/algorithm/reverse.hpp>
+#include <stl2/detail/algorithm/upper_bound.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/insert_iterators.hpp>
+#include <stl2/detail/iterator/reverse_iterator.hpp>
+#include <stl2/detail/memory/relocate.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Run-adaptive stable merge sort [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// A natural merge sort after Munro and Wild's powersort. The range is
+		// split into maximal ascending or strictly descending runs - the
+		// latter reversed - and adjacent runs are merged in the order given
+		// by the "power" of the boundary between them, which keeps the merge
+		// tree within a few percent of optimal for the run lengths. Runs
+		// shorter than min_run are not worth merging individually: each
+		// stretch of them is sorted as a unit, by binary insertion sort when
+		// it is short, else by the caller's sort_stretch. Merges first skip
+		// the elements already in place at both ends, then move the shorter
+		// run into the buffer and gallop (McIlroy, Peters) through stretches
+		// taken from one side; elements better relocated than moved are
+		// relocated, to the buffer and back. Sorted input costs n - 1
+		// comparisons and no moves.
+		struct powersort {
+			// Sorts [first, first + n) stably; buf has room for n elements.
+			// sort_stretch(f, l) stably sorts [f, l), and may use buf.
+			template<random_access_iterator I, class C, class P, class F>
+			requires sortable<I, C, P>
+			static void sort(I first, const iter_difference_t<I> n, iter_value_t<I>* const buf,
+				C& comp, P& proj, F& sort_stretch)
+			{
+				using D = iter_difference_t<I>;
+				struct entry {
+					D begin;
+					D size;
+					int power;
+				};
+				std::array<entry, 8 * sizeof(D) + 2> stack;
+				int top = 0;
+				int min_gallop = initial_min_gallop;
+				const D min_size = min_run(n);
+
+				auto push = [&](const D begin, const D size) {
+					if (top > 0) {
+						const int power = node_power(stack[top - 1].begin,
+							stack[top - 1].size, size, n);
+						while (top > 1 && stack[top - 2].power > power) {
+							merge_top(first, stack[top - 2], stack[top - 1], buf,
+								min_gallop, comp, proj);
+							--top;
+						}
+						stack[top - 1].power = power;
+					}
+					stack[top++] = entry{begin, size, 0};
+				};
+
+				D i = 0;
+				auto r = run_at(first, n, comp, proj);
+				while (i < n) {
+					D size = r.size;
+					if (size >= min_size) {
+						if (r.descending) {
+							reverse(first + i, first + (i + size));
+						}
+						if (i + size < n) {
+							r = run_at(first + (i + size), n - (i + size), comp, proj);
+						}
+						push(i, size);
+					} else {
+						const auto head = r;
+						while (i + size < n) {
+							r = run_at(first + (i + size), n - (i + size), comp, proj);
+							if (r.size >= min_size) break;
+							size += r.size;
+						}
+						if (size <= min_size) {
+							if (head.descending) {
+								reverse(first + i, first + (i + head.size));
+							}
+							binary_insertion_sort(first + i, head.size, size, comp, proj);
+							push(i, size);
+						} else {
+							// Sorted in halves, each pass over a stretch stays
+							// in cache for longer.
+							const D half = size / 2;
+							sort_stretch(first + i, first + (i + half));
+							sort_stretch(first + (i + half), first + (i + size));
+							push(i, half);
+							push(i + half, size - half);
+						}
+					}
+					i += size;
+				}
+				for (; top > 1; --top) {
+					merge_top(first, stack[top - 2], stack[top - 1], buf, min_gallop, comp, proj);
+				}
+			}
+
+		private:
+			static constexpr int initial_min_gallop = 7;
+
+			// n if n < 64, else a value in [32, 64] such that n / min_run(n)
+			// is a power of two or just below one.
+			template<class D>
+			static D min_run(D n) noexcept {
+				D r = 0;
+				while (n >= 64) {
+					r |= n & 1;
+					n >>= 1;
+				}
+				return n + r;
+			}
+
+			// The depth in the ideal merge tree of the boundary between
+			// [s1, s1 + n1) and [s1 + n1, s1 + n1 + n2): the number of
+			// leading binary digits shared by the midpoints of the two runs
+			// as fractions of n, plus one.
+			template<class D>
+			static int node_power(const D s1, const D n1, const D n2, const D n) noexcept {
+				D a = 2 * s1 + n1;
+				D b = a + n1 + n2;
+				int power = 0;
+				while (true) {
+					++power;
+					if (a >= n) {
+						a -= n;
+						b -= n;
+					} else if (b >= n) {
+						return power;
+					}
+					a *= 2;
+					b *= 2;
+				}
+			}
+
+			template<class D>
+			struct run {
+				D size;
+				bool descending;
+			};
+
+			// The maximal ascending or strictly descending run at the front of
+			// [first, first + n), which is not empty.
+			template<random_access_iterator I, class C, class P>
+			static run<iter_difference_t<I>> run_at(const I first,
+				const iter_difference_t<I> n, C& comp, P& proj)
+			{
+				if (n < 2) {
+					return {n, false};
+				}
+				const I last = first + n;
+				I i = first + 1;
+				const bool descending = __stl2::invoke(comp, __stl2::invoke(proj, *i),
+					__stl2::invoke(proj, *first));
+				for (++i; i != last; ++i) {
+					if (descending != bool(__stl2::invoke(comp, __stl2::invoke(proj, *i),
+						__stl2::invoke(proj, *(i - 1)))))
+					{
+						break;
+					}
+				}
+				return {i - first, descending};
+			}
+
+			template<random_access_iterator I, class E, class C, class P>
+			static void merge_top(const I first, E& a, const E& b, iter_value_t<I>* const buf,
+				int& min_gallop, C& comp, P& proj)
+			{
+				merge_runs(first + a.begin, a.size, b.size, buf, min_gallop, comp, proj);
+				a.size += b.size;
+			}
+
+			// Extends the sorted prefix [first, first + sorted) to [first,
+			// first + n).
+			template<random_access_iterator I, class C, class P>
+			static void binary_insertion_sort(const I first, iter_difference_t<I> sorted,
+				const iter_difference_t<I> n, C& comp, P& proj)
+			{
+				for (; sorted < n; ++sorted) {
+					const I i = first + sorted;
+					const I pos = upper_bound(first, i, __stl2::invoke(proj, *i),
+						__stl2::ref(comp), __stl2::ref(proj));
+					if (pos != i) {
+						iter_value_t<I> tmp = iter_move(i);
+						move_backward(pos, i, i + 1);
+						*pos = std::move(tmp);
+					}
+				}
+			}
+
+			// The number of leading elements of [first, first + n) that
+			// satisfy pred, which holds for a prefix, found by exponential
+			// then binary search.
+			template<class It, class D, class Pred>
+			static D gallop(const It first, const D n, Pred pred) {
+				D lo = 0;
+				D hi = 1;
+				while (hi <= n && pred(*(first + (hi - 1)))) {
+					lo = hi;
+					hi = 2 * hi + 1;
+				}
+				if (hi > n) {
+					hi = n;
+				} else {
+					--hi;
+				}
+				while (lo < hi) {
+					const D mid = lo + (hi - lo) / 2;
+					if (pred(*(first + mid))) {
+						lo = mid + 1;
+					} else {
+						hi = mid;
+					}
+				}
+				return lo;
+			}
+
+			// Merges [first, first + n1) and [first + n1, first + n1 + n2).
+			template<random_access_iterator I, class C, class P>
+			static void merge_runs(I first, iter_difference_t<I> n1, iter_difference_t<I> n2,
+				iter_value_t<I>* const buf, int& min_gallop, C& comp, P& proj)
+			{
+				I middle = first + n1;
+				// Elements of the first run that precede the second are in place,
+				// as are elements of the second run that follow the first.
+				const auto skip = gallop(first, n1, [&](auto&& x) {
+					return !__stl2::invoke(comp, __stl2::invoke(proj, *middle),
+						__stl2::invoke(proj, x));
+				});
+				first += skip;
+				n1 -= skip;
+				if (n1 == 0) {
+					return;
+				}
+				n2 = gallop(middle, n2, [&](auto&& y) {
+					return __stl2::invoke(comp, __stl2::invoke(proj, y),
+						__stl2::invoke(proj, *(middle - 1)));
+				});
+				if (n2 == 0) {
+					return;
+				}
+
+				// Relocated elements leave the buffer as they are merged;
+				// moved ones are destroyed with vec.
+				temporary_vector<iter_value_t<I>> vec{buf, static_cast<std::ptrdiff_t>(n1 + n2)};
+				auto move_out = [&](I f, I l) {
+					if constexpr (byte_relocatable<I>) {
+						ext::uninitialized_relocate(std::move(f), std::move(l), buf);
+					} else {
+						move(std::move(f), std::move(l), __stl2::back_inserter(vec));
+					}
+				};
+				if (n1 <= n2) {
+					move_out(first, middle);
+					gallop_merge(buf, n1, middle, n2, first, min_gallop,
+						[&](auto&& y, auto&& x) {
+							return __stl2::invoke(comp, __stl2::invoke(proj, y),
+								__stl2::invoke(proj, x));
+						});
+				} else {
+					// Merge from the back: reversed, the first run is taken
+					// while it is greater than the second.
+					move_out(middle, middle + n2);
+					using RI = reverse_iterator<I>;
+					using RB = reverse_iterator<iter_value_t<I>*>;
+					gallop_merge(RB{buf + n2}, n2, RI{middle}, n1, RI{middle + n2},
+						min_gallop,
+						[&](auto&& y, auto&& x) {
+							return __stl2::invoke(comp, __stl2::invoke(proj, x),
+								__stl2::invoke(proj, y));
+						});
+				}
+			}
+
+			// Merges the run moved out to [x, x + nx) with the run [y, y + ny)
+			// into [dest, y + ny), where dest + nx == y; take_y(*y, *x) is
+			// true when *y is to be output before *x. After min_gallop
+			// consecutive elements from one side, each step gallops over the
+			// next stretch from either side until the stretches are short
+			// again; min_gallop adapts to how often galloping pays off.
+			template<class X, class Y, class D, class TakeY>
+			static void gallop_merge(X x, D nx, Y y, D ny, Y dest, int& min_gallop,
+				TakeY take_y)
+			{
+				constexpr bool relocate = byte_relocatable<Y>;
+				auto take = [&](auto& it, D& n) {
+					if constexpr (relocate) {
+						detail::relocate_bytes(*dest, *it);
+					} else {
+						*dest = iter_move(it);
+					}
+					++dest;
+					++it;
+					return --n == 0;
+				};
+				auto take_n = [&](auto& it, D& n, const D count) {
+					if constexpr (relocate) {
+						dest = ext::uninitialized_relocate_n(it, count, dest).out;
+					} else {
+						dest = move(it, it + count, dest).out;
+					}
+					it += count;
+					return (n -= count) == 0;
+				};
+				auto loop = [&] {
+					while (true) {
+						D count_x = 0;
+						D count_y = 0;
+						do {
+							if (take_y(*y, *x)) {
+								if (take(y, ny)) return;
+								++count_y;
+								count_x = 0;
+							} else {
+								if (take(x, nx)) return;
+								++count_x;
+								count_y = 0;
+							}
+						} while (count_x < min_gallop && count_y < min_gallop);
+
+						++min_gallop;
+						do {
+							min_gallop -= min_gallop > 1;
+							count_x = gallop(x, nx, [&](auto&& e) { return !take_y(*y, e); });
+							if (count_x != 0 && take_n(x, nx, count_x)) return;
+							if (take(y, ny)) return;
+							count_y = gallop(y, ny, [&](auto&& e) { return take_y(e, *x); });
+							if (count_y != 0 && take_n(y, ny, count_y)) return;
+							if (take(x, nx)) return;
+						} while (count_x >= initial_min_gallop || count_y >= initial_min_gallop);
+						++min_gallop;
+					}
+				};
+				if constexpr (relocate) {
+					// The holes in [dest, y) are as many as the elements left
+					// in the buffer, which fill them however the merge ends.
+					detail::relocate_on_exit rest{x, nx, dest};
+					loop();
+				} else {
+					loop();
+					// Whatever remains of the second run is already in place.
+					move(x, x + nx, dest);
+				}
+			}
+		};
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,295 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_RADIX_SORT_HPP
+#define STL2_DETAIL_ALGORITHM_RADIX_SORT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/concepts/fundamental.hpp>
+#include <stl2/detail/functional/comparisons.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// radix_sort [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Keys whose order under < is the order of an unsigned integer
+		// obtained by a bijective bit transform.
+		template<class K>
+		META_CONCEPT radix_key = (integral<K> && sizeof(K) <= 8) ||
+			(floating_point<K> && std::numeric_limits<K>::is_iec559 &&
+				(sizeof(K) == 4 || sizeof(K) == 8));
+
+		// 1 if Comp orders keys of type K ascending, -1 if descending,
+		// 0 if it is not known to be equivalent to < or >.
+		template<class Comp, class K>
+		inline constexpr int radix_order = 0;
+		template<class K>
+		inline constexpr int radix_order<less, K> = 1;
+		template<class K>
+		inline constexpr int radix_order<std::less<K>, K> = 1;
+		template<class K>
+		inline constexpr int radix_order<std::less<>, K> = 1;
+		template<class K>
+		inline constexpr int radix_order<greater, K> = -1;
+		template<class K>
+		inline constexpr int radix_order<std::greater<K>, K> = -1;
+		template<class K>
+		inline constexpr int radix_order<std::greater<>, K> = -1;
+
+		template<class I, class Proj>
+		using radix_key_t = __uncvref<indirect_result_t<Proj&, I>>;
+
+		template<class I, class Comp, class Proj>
+		META_CONCEPT radix_sortable = radix_key<radix_key_t<I, Proj>> &&
+			radix_order<Comp, radix_key_t<I, Proj>> != 0;
+
+		template<std::size_t> struct radix_uint_;
+		template<> struct radix_uint_<1> { using type = std::uint8_t; };
+		template<> struct radix_uint_<2> { using type = std::uint16_t; };
+		template<> struct radix_uint_<4> { using type = std::uint32_t; };
+		template<> struct radix_uint_<8> { using type = std::uint64_t; };
+
+		template<class K>
+		using radix_uint = typename radix_uint_<sizeof(K)>::type;
+
+		// Maps a key to an unsigned integer such that the unsigned order of
+		// the results is the order of the keys under Comp: flip the sign bit
+		// of signed integers; for IEEE-754 values, flip every bit of negative
+		// numbers and the sign bit of non-negative numbers; complement the
+		// result for descending orders. -0.0 sorts before +0.0.
+		template<int Order, radix_key K>
+		radix_uint<K> radix_bits(const K k) noexcept {
+			using U = radix_uint<K>;
+			constexpr int shift = std::numeric_limits<U>::digits - 1;
+			U u;
+			if constexpr (integral<K>) {
+				u = static_cast<U>(k);
+				if constexpr (signed_integral<K>) {
+					u ^= U(U(1) << shift);
+				}
+			} else {
+				std::memcpy(&u, &k, sizeof(U));
+				u ^= U(U(-U(u >> shift)) | U(U(1) << shift));
+			}
+			if constexpr (Order < 0) {
+				u = U(~u);
+			}
+			return u;
+		}
+
+		// Radix sort engine. LSD through a temporary_buffer for trivially
+		// copyable elements with narrow keys (or modest n); otherwise an
+		// in-place MSD American flag sort, which needs no element storage
+		// and stops refining buckets as soon as they become small.
+		struct radix {
+			template<int Order, random_access_iterator I, class Proj>
+			requires permutable<I>
+			static void sort(I first, iter_difference_t<I> n, Proj& proj) {
+				using K = radix_key_t<I, Proj>;
+				using V = iter_value_t<I>;
+				if (n <= insertion_sort_threshold) {
+					insertion_sort<Order>(first, first + n, proj);
+					return;
+				}
+				if constexpr (ext::trivially_copyable<V>) {
+					if (sizeof(K) <= 4 || n <= lsd_limit) {
+						temporary_buffer<V> buf{n};
+						if (buf.size() >= n) {
+							lsd<Order>(first, n, buf.data(), proj);
+							return;
+						}
+					}
+				}
+				msd<Order>(first, n, int(sizeof(K)) - 1, proj);
+			}
+
+		private:
+			// Buckets no larger than this are insertion sorted.
+			static constexpr std::ptrdiff_t insertion_sort_threshold = 48;
+			// Above this many elements, MSD sorts wide keys in fewer passes
+			// over memory than LSD.
+			static constexpr std::ptrdiff_t lsd_limit = std::ptrdiff_t{1} << 16;
+			static constexpr std::size_t radix_size = 256;
+
+			template<int Order, class Proj, class T>
+			static auto key(Proj& proj, T&& t) {
+				return radix_bits<Order>(__stl2::invoke(proj, std::forward<T>(t)));
+			}
+
+			template<class U>
+			static std::size_t digit(const U u, const int byte) noexcept {
+				return static_cast<std::size_t>((u >> (8 * byte)) & 0xff);
+			}
+
+			template<int Order, random_access_iterator I, class Proj>
+			requires permutable<I>
+			static void insertion_sort(I first, I last, Proj& proj) {
+				if (first == last) return;
+				for (I i = first + 1; i != last; ++i) {
+					auto k = key<Order>(proj, *i);
+					I j = i;
+					if (k < key<Order>(proj, *(j - 1))) {
+						iter_value_t<I> v = iter_move(i);
+						do {
+							*j = iter_move(j - 1);
+							--j;
+						} while (j != first && k < key<Order>(proj, *(j - 1)));
+						*j = std::move(v);
+					}
+				}
+			}
+
+			template<int Order, random_access_iterator I, random_access_iterator O, class Proj>
+			static void scatter(I first, I last, O out, std::ptrdiff_t (&offsets)[radix_size],
+				const int byte, Proj& proj)
+			{
+				for (; first != last; ++first) {
+					*(out + iter_difference_t<O>(offsets[digit(key<Order>(proj, *first), byte)]++)) =
+						iter_move(first);
+				}
+			}
+
+			// Pre: buf has room for n trivially copyable elements.
+			template<int Order, random_access_iterator I, class Proj>
+			requires permutable<I>
+			static void lsd(I first, const iter_difference_t<I> n, iter_value_t<I>* buf,
+				Proj& proj)
+			{
+				using K = radix_key_t<I, Proj>;
+				constexpr int passes = int(sizeof(K));
+				std::ptrdiff_t counts[passes][radix_size] = {};
+
+				// One read pass builds the histograms of every digit.
+				const auto first_key = key<Order>(proj, *first);
+				for (I i = first, last = first + n; i != last; ++i) {
+					const auto k = key<Order>(proj, *i);
+					for (int p = 0; p < passes; ++p) {
+						++counts[p][digit(k, p)];
+					}
+				}
+
+				bool in_buf = false;
+				for (int p = 0; p < passes; ++p) {
+					auto& offsets = counts[p];
+					// Skip passes in which every key has the same digit.
+					if (offsets[digit(first_key, p)] == n) continue;
+
+					std::ptrdiff_t sum = 0;
+					for (auto& c : offsets) {
+						const auto t = c;
+						c = sum;
+						sum += t;
+					}
+					if (in_buf) {
+						scatter<Order>(buf, buf + n, first, offsets, p, proj);
+					} else {
+						scatter<Order>(first, first + n, buf, offsets, p, proj);
+					}
+					in_buf = !in_buf;
+				}
+
+				if (in_buf) {
+					for (std::ptrdiff_t i = 0; i < n; ++i, ++first) {
+						*first = std::move(buf[i]);
+					}
+				}
+			}
+
+			template<int Order, random_access_iterator I, class Proj>
+			requires permutable<I>
+			static void msd(I first, iter_difference_t<I> n, int byte, Proj& proj) {
+				using D = iter_difference_t<I>;
+				while (true) {
+					if (n <= insertion_sort_threshold) {
+						insertion_sort<Order>(first, first + n, proj);
+						return;
+					}
+
+					std::ptrdiff_t counts[radix_size] = {};
+					for (iter_difference_t<I> i = 0; i < n; ++i) {
+						++counts[digit(key<Order>(proj, *(first + i)), byte)];
+					}
+					if (counts[digit(key<Order>(proj, *first), byte)] == n) {
+						// Every key has the same digit: go on to the next.
+						if (byte-- == 0) return;
+						continue;
+					}
+
+					std::ptrdiff_t next[radix_size];
+					std::ptrdiff_t ends[radix_size];
+					std::ptrdiff_t sum = 0;
+					for (std::size_t b = 0; b < radix_size; ++b) {
+						next[b] = sum;
+						sum += counts[b];
+						ends[b] = sum;
+					}
+
+					// Permute in place: each swap moves an element into its
+					// bucket, so the loop does at most n swaps.
+					for (std::size_t b = 0; b < radix_size; ++b) {
+						while (next[b] < ends[b]) {
+							auto d = digit(key<Order>(proj, *(first + D(next[b]))), byte);
+							while (d != b) {
+								iter_swap(first + D(next[b]), first + D(next[d]++));
+								d = digit(key<Order>(proj, *(first + D(next[b]))), byte);
+							}
+							++next[b];
+						}
+					}
+
+					if (byte == 0) return;
+					for (std::size_t b = 0; b < radix_size; ++b) {
+						if (counts[b] > 1) {
+							msd<Order>(first + D(ends[b] - counts[b]), D(counts[b]), byte - 1, proj);
+						}
+					}
+					return;
+				}
+			}
+		};
+	}
+
+	namespace ext {
+		// Sorts by the projected key, which must be an integral or IEEE-754
+		// floating-point scalar, under less or greater. The sort is not
+		// stable, and orders -0.0 before +0.0.
+		struct __radix_sort_fn : private __niebloid {
+			template<random_access_iterator I, sentinel_for<I> S, class Comp = less,
+				class Proj = identity>
+			requires sortable<I, Comp, Proj> && detail::radix_sortable<I, Comp, Proj>
+			I operator()(I first, S sent, Comp = {}, Proj proj = {}) const {
+				auto last = next(first, static_cast<S&&>(sent));
+				constexpr int order = detail::radix_order<Comp, detail::radix_key_t<I, Proj>>;
+				detail::radix::sort<order>(first, last - first, proj);
+				return last;
+			}
+
+			template<random_access_range R, class Comp = less, class Proj = identity>
+			requires sortable<iterator_t<R>, Comp, Proj> &&
+				detail::radix_sortable<iterator_t<R>, Comp, Proj>
+			safe_iterator_t<R> operator()(R&& r, Comp comp = {}, Proj proj = {}) const {
+				return (*this)(begin(r), end(r), static_cast<Comp&&>(comp),
+					static_cast<Proj&&>(proj));
+			}
+		};
+
+		inline constexpr __radix_sort_fn radix_sort{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -26,11 +26,16 @@
 #include <stl2/detail/algorithm/move_backward.hpp>
 #include <stl2/detail/algorithm/swap_ranges.hpp>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/memory/relocate.hpp>
 #include <stl2/view/subrange.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // rotate [alg.rotate]
 //
+// Elements better relocated than moved, such as std::unique_ptrs, are
+// shifted along one place by copying their bytes, as trivially move
+// assignable elements are.
+//
 STL2_OPEN_NAMESPACE {
 	struct __sean_parent_fn : private __niebloid {
 		template<permutable I, sentinel_for<I> S>
@@ -42,20 +47,27 @@ STL2_OPEN_NAMESPACE {
 			if (middle == last) {
 				return {std::move(first), std::move(middle)};
 			}
-			if constexpr (std::is_trivially_move_assignable_v<iter_value_t<I>>) {
-				if (next(first) == middle) {
-					return __rotate_left(std::move(first), std::move(last));
-				}
-				if constexpr (same_as<I, S>) {
-					if constexpr (bidirectional_iterator<I>) {
-						if (next(middle) == last) {
-							return __rotate_right(std::move(first), std
-								::move(last));
-						}
+			if constexpr (std::is_trivially_move_assignable_v<iter_value_t<I>> ||
+				detail::byte_relocatable<I>)
+			{
+				if (!__relocates<I> || !detail::is_constant_evaluated()) {
+					if (next(first) == middle) {
+						return __rotate_left(std::move(first), std::move(last));
 					}
-					if constexpr (random_access_iterator<I>) {
-						return __rotate_gcd(std::move(first), std::move(middle),
-							std::move(last));
+					if constexpr (same_as<I, S>) {
+						if constexpr (bidirectional_iterator<I>) {
+							if (next(middle) == last) {
+								return __rotate_right(std::move(first), std
+									::move(last));
+							}
+						}
+						// The cycles of the gcd rotation stride through the range,
+						// and the swaps of the forward rotation are as cheap as
+						// moves for elements to be relocated.
+						if constexpr (random_access_iterator<I> && !__relocates<I>) {
+							return __rotate_gcd(std::move(first), std::move(middle),
+								std::move(last));
+						}
 					}
 				}
 			}
@@ -70,13 +82,29 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r), std::move(middle), end(r));
 		}
 	private:
+		// Whether the shifts by one place relocate the elements rather than
+		// move them: those that are not trivially move assignable are
+		// byte_relocatable.
+		template<class I>
+		static constexpr bool __relocates =
+			!std::is_trivially_move_assignable_v<iter_value_t<I>>;
+
 		template<permutable I, sentinel_for<I> S>
 		static constexpr subrange<I> __rotate_left(I first, S sent) {
 			STL2_EXPECT(first != sent);
-			iter_value_t<I> tmp = iter_move(first);
-			auto [last, last_but_one] = move(next(first), sent, first);
-			*last_but_one = std::move(tmp);
-			return {std::move(last_but_one), std::move(last)};
+			if constexpr (__relocates<I>) {
+				detail::relocation_slot<iter_value_t<I>> tmp;
+				detail::relocate_bytes(tmp.get(), *first);
+				auto [last, last_but_one] =
+					ext::uninitialized_relocate(next(first), sent, first);
+				detail::relocate_bytes(*last_but_one, tmp.get());
+				return {std::move(last_but_one), std::move(last)};
+			} else {
+				iter_value_t<I> tmp = iter_move(first);
+				auto [last, last_but_one] = move(next(first), sent, first);
+				*last_but_one = std::move(tmp);
+				return {std::move(last_but_one), std::move(last)};
+			}
 		}
 
 		template<permutable I>
@@ -84,10 +112,19 @@ STL2_OPEN_NAMESPACE {
 		static constexpr subrange<I> __rotate_right(I first, I last) {
 			STL2_EXPECT(first != last);
 			I last_but_one = prev(last);
-			iter_value_t<I> tmp = iter_move(last_but_one);
-			I fp1 = move_backward(first, std::move(last_but_one), last).out;
-			*first = std::move(tmp);
-			return {std::move(fp1), std::move(last)};
+			if constexpr (__relocates<I>) {
+				using RI = reverse_iterator<I>;
+				detail::relocation_slot<iter_value_t<I>> tmp;
+				detail::relocate_bytes(tmp.get(), *last_but_one);
+				ext::uninitialized_relocate(RI{last_but_one}, RI{first}, RI{last});
+				detail::relocate_bytes(*first, tmp.get());
+				return {next(std::move(first)), std::move(last)};
+			} else {
+				iter_value_t<I> tmp = iter_move(last_but_one);
+				I fp1 = move_backward(first, std::move(last_but_one), last).out;
+				*first = std::move(tmp);
+				return {std::move(fp1), std::move(last)};
+			}
 		}
 
 		template<permutable I, sentinel_for<I> S>
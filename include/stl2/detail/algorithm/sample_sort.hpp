@@ -0,0 +1,503 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SAMPLE_SORT_HPP
+#define STL2_DETAIL_ALGORITHM_SAMPLE_SORT_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stl2/detail/construct_destruct.hpp>
+#include <stl2/detail/execution.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Parallel in-place samplesort [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// A parallel in-place super scalar samplesort, after Axtmann, Witt,
+		// Ferizovic and Sanders' IPS4o. Each level draws k - 1 splitters
+		// from a sorted random sample and distributes the elements into
+		// 2k - 1 buckets - one between each pair of adjacent splitters and
+		// one of elements equivalent to each splitter, which need no further
+		// sorting - by descending a branchless search tree:
+		//  1. each thread classifies a stripe of the range into per-bucket
+		//     buffers of one block each, flushing full buffers to the front
+		//     of its stripe;
+		//  2. the threads move the blocks into the block-aligned regions of
+		//     their buckets, swapping them along cycles;
+		//  3. the contents of the partially filled buffers, and the blocks
+		//     that straddle the end of their bucket, fill the gaps left at
+		//     the ends of the buckets.
+		// Buckets too large to be sorted by one thread are sorted by
+		// recursive parallel levels; the rest are handed to the sequential
+		// sort, several at a time.
+		struct sample_sort {
+			// Sorts [first, first + n) on at most `threads` threads. seq(f, l,
+			// comp, proj) sorts [f, l) sequentially.
+			template<random_access_iterator I, class Comp, class Proj, class Seq>
+			requires sortable<I, Comp, Proj>
+			static void sort(I first, const std::ptrdiff_t n, unsigned threads,
+				Comp& comp, Proj& proj, Seq& seq, const int depth = 0)
+			{
+				using D = iter_difference_t<I>;
+				if (static_cast<std::ptrdiff_t>(threads) > n / min_stripe) {
+					threads = static_cast<unsigned>(n / min_stripe);
+				}
+				if (threads < 2 || depth >= max_depth) {
+					seq(first, first + D(n), comp, proj);
+					return;
+				}
+
+				std::vector<std::ptrdiff_t> bounds;
+				{
+					level<I, Comp, Proj> l{first, n, threads, comp, proj};
+					if (!l.partition(seq)) {
+						seq(first, first + D(n), comp, proj);
+						return;
+					}
+					bounds = std::move(l.bounds);
+				}
+
+				// Odd buckets hold elements equivalent to a splitter.
+				std::vector<std::ptrdiff_t> rest;
+				const auto buckets = static_cast<std::ptrdiff_t>(bounds.size()) - 1;
+				for (std::ptrdiff_t b = 0; b < buckets; b += 2) {
+					const auto size = bounds[b + 1] - bounds[b];
+					if (size >= n / threads && size >= 2 * min_stripe) {
+						sort(first + D(bounds[b]), size, threads, comp, proj, seq, depth + 1);
+					} else if (size > 1) {
+						rest.push_back(b);
+					}
+				}
+
+				std::atomic<std::size_t> next{0};
+				fork_join(threads, [&](unsigned) noexcept {
+					Comp c = comp;
+					Proj p = proj;
+					for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < rest.size();) {
+						const auto b = rest[i];
+						seq(first + D(bounds[b]), first + D(bounds[b + 1]), c, p);
+					}
+				});
+			}
+
+		private:
+			// Ranges are split into stripes of at least this many elements,
+			// one per thread.
+			static constexpr std::ptrdiff_t min_stripe = std::ptrdiff_t{1} << 14;
+			// Levels of parallel recursion before buckets are sorted by the
+			// sequential sort regardless of their size.
+			static constexpr int max_depth = 4;
+			static constexpr int max_log_buckets = 8;
+			static constexpr std::size_t block_bytes = 2048;
+
+			template<random_access_iterator I, class Comp, class Proj>
+			requires sortable<I, Comp, Proj>
+			class level {
+				using V = iter_value_t<I>;
+				using D = iter_difference_t<I>;
+				using index = std::ptrdiff_t;
+
+				struct thread_state {
+					temporary_buffer<V> buffers; // a block for each bucket
+					temporary_buffer<V> swap;    // a block in transit
+					std::vector<index> fill;     // elements buffered, per bucket
+					std::vector<index> count;    // elements classified, per bucket
+					index full_end = 0;          // end of the flushed blocks
+				};
+
+				I first_;
+				const index n_;
+				const unsigned threads_;
+				Comp& comp_;
+				Proj& proj_;
+				const index block_;
+				int log_k_ = 1;
+				index k_ = 2;
+				index splitter_count_ = 0;
+				index buckets_ = 0;
+				index stripe_ = 0;
+				temporary_buffer<V> splitters_;
+				std::vector<V*> tree_;
+				std::vector<thread_state> state_;
+				std::vector<index> delims_;
+				std::vector<index> blocks_;
+				std::vector<index> write_;
+				std::vector<index> read_;
+				std::unique_ptr<std::mutex[]> locks_;
+				std::unique_ptr<std::atomic<int>[]> reading_;
+				temporary_buffer<V> overflow_;
+				index overflow_bucket_ = -1;
+
+			public:
+				// Start of each bucket, followed by n.
+				std::vector<index> bounds;
+
+				level(I first, const index n, const unsigned threads, Comp& comp, Proj& proj)
+				: first_{first}, n_{n}, threads_{threads}, comp_{comp}, proj_{proj}
+				, block_{static_cast<index>(sizeof(V) < block_bytes ? block_bytes / sizeof(V) : 1)}
+				{
+					while (log_k_ < max_log_buckets && n_ / (4 * k_) >= block_) {
+						++log_k_;
+						k_ *= 2;
+					}
+				}
+
+				// Distributes the elements into buckets and sets bounds;
+				// returns false without touching the range if scratch memory
+				// is short.
+				template<class Seq>
+				bool partition(Seq& seq) {
+					const index max_buckets = 2 * k_ - 1;
+					splitters_ = temporary_buffer<V>{k_ - 1};
+					if (splitters_.size() < k_ - 1) return false;
+					state_.resize(threads_);
+					for (auto& s : state_) {
+						s.buffers = temporary_buffer<V>{max_buckets * block_};
+						s.swap = temporary_buffer<V>{block_};
+						if (s.buffers.size() < max_buckets * block_ || s.swap.size() < block_) {
+							return false;
+						}
+					}
+					if (n_ % block_ != 0) {
+						overflow_ = temporary_buffer<V>{block_};
+						if (overflow_.size() < block_) return false;
+					}
+					tree_.resize(static_cast<std::size_t>(k_));
+					locks_.reset(new std::mutex[static_cast<std::size_t>(max_buckets)]);
+					reading_.reset(new std::atomic<int>[static_cast<std::size_t>(max_buckets)]);
+
+					const auto size = static_cast<std::size_t>(max_buckets);
+					for (auto& s : state_) {
+						s.fill.assign(size, 0);
+						s.count.assign(size, 0);
+					}
+					bounds.assign(size + 1, 0);
+					delims_.assign(size + 1, 0);
+					blocks_.assign(size, 0);
+					write_.assign(size, 0);
+					read_.assign(size, 0);
+					for (index b = 0; b < max_buckets; ++b) {
+						reading_[b].store(0, std::memory_order_relaxed);
+					}
+
+					sample(seq);
+					stripe_ = round_up((n_ - splitter_count_ + threads_ - 1) / threads_);
+
+					fork_join(threads_, [this](unsigned t) noexcept { classify_stripe(t); });
+					compute_bounds();
+					fork_join(threads_, [this](unsigned t) noexcept { permute(t); });
+					cleanup();
+					return true;
+				}
+
+			private:
+				index round_up(const index x) const noexcept {
+					return (x + block_ - 1) / block_ * block_;
+				}
+
+				static std::uint64_t random(std::uint64_t& state) noexcept {
+					// xorshift64*
+					state ^= state >> 12;
+					state ^= state << 25;
+					state ^= state >> 27;
+					return state * 0x2545f4914f6cdd1dull;
+				}
+
+				// Sorts a random sample at the back of the range and moves
+				// the distinct splitters out of it, leaving their vacated
+				// positions at the very end.
+				template<class Seq>
+				void sample(Seq& seq) {
+					index log_n = 0;
+					while ((index{1} << (log_n + 1)) <= n_) ++log_n;
+					const index oversampling = log_n / 5 > 1 ? log_n / 5 : 1;
+					const index s = oversampling * k_ - 1;
+
+					std::uint64_t state = 0x9e3779b97f4a7c15ull ^ static_cast<std::uint64_t>(n_);
+					for (index i = 0; i < s; ++i) {
+						const index j = n_ - 1 - i;
+						const auto r = static_cast<index>(random(state) %
+							static_cast<std::uint64_t>(j + 1));
+						if (r != j) {
+							iter_swap(first_ + D(r), first_ + D(j));
+						}
+					}
+					seq(first_ + D(n_ - s), first_ + D(n_), comp_, proj_);
+
+					std::vector<index> picks;
+					picks.reserve(static_cast<std::size_t>(k_));
+					for (index j = 1; j < k_; ++j) {
+						const index x = n_ - s + j * oversampling - 1;
+						if (picks.empty() || __stl2::invoke(comp_,
+							__stl2::invoke(proj_, *(first_ + D(picks.back()))),
+							__stl2::invoke(proj_, *(first_ + D(x)))))
+						{
+							picks.push_back(x);
+						}
+					}
+					splitter_count_ = static_cast<index>(picks.size());
+					buckets_ = 2 * splitter_count_ + 1;
+
+					V* const splitters = splitters_.data();
+					for (index i = 0; i < splitter_count_; ++i) {
+						construct(splitters[i], iter_move(first_ + D(picks[i])));
+					}
+					index w = n_ - s;
+					std::size_t p = 0;
+					for (index x = n_ - s; x < n_; ++x) {
+						if (p < picks.size() && x == picks[p]) {
+							++p;
+							continue;
+						}
+						if (w != x) {
+							*(first_ + D(w)) = iter_move(first_ + D(x));
+						}
+						++w;
+					}
+
+					// Pad the k - 1 tree slots by repeating the last splitter.
+					build_tree(1, 0, k_ - 1);
+				}
+
+				void build_tree(const index node, const index lo, const index hi) {
+					if (lo >= hi) return;
+					const index mid = lo + (hi - lo) / 2;
+					tree_[node] = splitters_.data() +
+						(mid < splitter_count_ ? mid : splitter_count_ - 1);
+					build_tree(2 * node, lo, mid);
+					build_tree(2 * node + 1, mid + 1, hi);
+				}
+
+				// Bucket 2i holds the elements strictly between splitters i - 1
+				// and i; bucket 2i + 1 those equivalent to splitter i.
+				template<class X>
+				index classify(X&& x, Comp& comp, Proj& proj) const {
+					index j = 1;
+					for (int l = 0; l < log_k_; ++l) {
+						j = 2 * j + !__stl2::invoke(comp,
+							__stl2::invoke(proj, static_cast<X&&>(x)),
+							__stl2::invoke(proj, *tree_[j]));
+					}
+					index b = j - k_;
+					if (b > splitter_count_) b = splitter_count_;
+					if (b > 0 && !__stl2::invoke(comp,
+						__stl2::invoke(proj, splitters_.data()[b - 1]),
+						__stl2::invoke(proj, static_cast<X&&>(x))))
+					{
+						return 2 * b - 1;
+					}
+					return 2 * b;
+				}
+
+				void classify_stripe(const unsigned t) noexcept {
+					Comp comp = comp_;
+					Proj proj = proj_;
+					auto& s = state_[t];
+					V* const buffers = s.buffers.data();
+					const index n = n_ - splitter_count_;
+					const index begin = t * stripe_ < n ? t * stripe_ : n;
+					const index end = begin + stripe_ < n ? begin + stripe_ : n;
+					index w = begin;
+					for (index x = begin; x < end; ++x) {
+						const I i = first_ + D(x);
+						const index b = classify(*i, comp, proj);
+						V* const buf = buffers + b * block_;
+						construct(buf[s.fill[b]], iter_move(i));
+						++s.count[b];
+						if (++s.fill[b] == block_) {
+							for (index j = 0; j < block_; ++j) {
+								*(first_ + D(w + j)) = std::move(buf[j]);
+								destruct(buf[j]);
+							}
+							s.fill[b] = 0;
+							w += block_;
+						}
+					}
+					s.full_end = w;
+				}
+
+				// Whether the block at q holds classified elements that have
+				// not yet been moved.
+				bool is_full(const index q) const noexcept {
+					index t = q / stripe_;
+					if (t >= static_cast<index>(threads_)) t = threads_ - 1;
+					return q + block_ <= state_[t].full_end;
+				}
+
+				// The greatest full block at or before q, or a negative value.
+				index prev_full(index q) const noexcept {
+					while (q >= 0) {
+						index t = q / stripe_;
+						if (t >= static_cast<index>(threads_)) t = threads_ - 1;
+						const index full_end = state_[t].full_end;
+						if (q + block_ <= full_end) return q;
+						if (full_end > t * stripe_) return full_end - block_;
+						q = t * stripe_ - block_;
+					}
+					return q;
+				}
+
+				void compute_bounds() {
+					bounds.resize(static_cast<std::size_t>(buckets_ + 1));
+					for (index b = 0; b < buckets_; ++b) {
+						index size = b % 2; // room for the splitter
+						for (auto& s : state_) {
+							size += s.count[b];
+							blocks_[b] += (s.count[b] - s.fill[b]) / block_;
+						}
+						bounds[b + 1] = bounds[b] + size;
+					}
+					for (index b = 0; b <= buckets_; ++b) {
+						delims_[b] = round_up(bounds[b]);
+					}
+					for (index b = 0; b < buckets_; ++b) {
+						write_[b] = delims_[b];
+						read_[b] = prev_full(delims_[b + 1] - block_);
+					}
+				}
+
+				// Takes the last unmoved block from the region of bucket b.
+				bool take(const index b, index& q) noexcept {
+					std::lock_guard<std::mutex> guard{locks_[b]};
+					if (read_[b] < write_[b]) return false;
+					q = read_[b];
+					read_[b] = prev_full(q - block_);
+					reading_[b].fetch_add(1, std::memory_order_relaxed);
+					return true;
+				}
+
+				void permute(const unsigned t) noexcept {
+					Comp comp = comp_;
+					Proj proj = proj_;
+					V* const block = state_[t].swap.data();
+					const index start = static_cast<index>(t) * buckets_ / threads_;
+					for (index i = 0; i < buckets_; ++i) {
+						const index b = (start + i) % buckets_;
+						index q;
+						while (take(b, q)) {
+							for (index j = 0; j < block_; ++j) {
+								construct(block[j], iter_move(first_ + D(q + j)));
+							}
+							reading_[b].fetch_sub(1, std::memory_order_release);
+							while (place(block, comp, proj)) {}
+						}
+					}
+				}
+
+				// Moves the block into the next free block of its bucket's
+				// region. If that held an unmoved block, the two are swapped
+				// and place returns true.
+				bool place(V* const block, Comp& comp, Proj& proj) noexcept {
+					const index b = classify(block[0], comp, proj);
+					index q;
+					bool unmoved;
+					{
+						std::lock_guard<std::mutex> guard{locks_[b]};
+						q = write_[b];
+						write_[b] += block_;
+						unmoved = q <= read_[b];
+					}
+					if (unmoved && is_full(q)) {
+						for (index j = 0; j < block_; ++j) {
+							const I i = first_ + D(q + j);
+							V tmp = iter_move(i);
+							*i = std::move(block[j]);
+							block[j] = std::move(tmp);
+						}
+						return true;
+					}
+					if (!unmoved) {
+						// The block at q may still be being read.
+						while (reading_[b].load(std::memory_order_acquire) != 0) {
+							std::this_thread::yield();
+						}
+					}
+					if (q + block_ > n_) {
+						V* const overflow = overflow_.data();
+						for (index j = 0; j < block_; ++j) {
+							construct(overflow[j], std::move(block[j]));
+							destruct(block[j]);
+						}
+						overflow_bucket_ = b;
+					} else {
+						for (index j = 0; j < block_; ++j) {
+							*(first_ + D(q + j)) = std::move(block[j]);
+							destruct(block[j]);
+						}
+					}
+					return false;
+				}
+
+				// Each bucket's blocks start at its delimiter, the first
+				// block boundary at or after its start. Fill the gap between
+				// start and delimiter, and that after the last block, with the
+				// part of the last block that extends into the next bucket,
+				// the buffered elements and the splitter.
+				void cleanup() noexcept {
+					const index overflow_at = n_ - n_ % block_;
+					V* const overflow = overflow_.data();
+					if (overflow_bucket_ >= 0) {
+						for (index x = overflow_at; x < n_; ++x) {
+							*(first_ + D(x)) = std::move(overflow[x - overflow_at]);
+							destruct(overflow[x - overflow_at]);
+						}
+					}
+
+					for (index b = 0; b < buckets_; ++b) {
+						const index lo = bounds[b];
+						const index hi = bounds[b + 1];
+						const index d = delims_[b];
+						const index e = d + blocks_[b] * block_;
+						const index head_end = d < hi ? d : hi;
+						const index tail = e > head_end ? e : head_end;
+						index pos = lo;
+						auto next = [&]() noexcept {
+							if (pos == head_end) pos = tail;
+							return first_ + D(pos++);
+						};
+
+						for (index x = d > hi ? d : hi, stop = e < n_ ? e : n_; x < stop; ++x) {
+							*next() = iter_move(first_ + D(x));
+						}
+						if (b == overflow_bucket_) {
+							for (index j = n_ - overflow_at; j < block_; ++j) {
+								*next() = std::move(overflow[j]);
+								destruct(overflow[j]);
+							}
+						}
+						for (auto& s : state_) {
+							V* const buf = s.buffers.data() + b * block_;
+							for (index j = 0; j < s.fill[b]; ++j) {
+								*next() = std::move(buf[j]);
+								destruct(buf[j]);
+							}
+						}
+						if (b % 2 != 0) {
+							V& splitter = splitters_.data()[b / 2];
+							*next() = std::move(splitter);
+							destruct(splitter);
+						}
+						STL2_EXPECT(pos == (tail < hi ? hi : head_end));
+					}
+				}
+			};
+		};
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -24,8 +24,10 @@
 #define STL2_DETAIL_ALGORITHM_SEARCH_HPP
 
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/algorithm/searchers.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/view/subrange.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // search [alg.search]
@@ -65,7 +67,59 @@ STL2_OPEN_NAMESPACE {
 					__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2));
 			}
 		}
+
+		template<forward_iterator I, sentinel_for<I> S, ext::searcher<I, S> Searcher>
+		constexpr subrange<I> operator()(I first, S last, const Searcher& searcher) const {
+			return searcher(std::move(first), std::move(last));
+		}
+
+		template<forward_range R, ext::searcher<iterator_t<R>, sentinel_t<R>> Searcher>
+		constexpr safe_subrange_t<R> operator()(R&& r, const Searcher& searcher) const {
+			return searcher(begin(r), end(r));
+		}
 	private:
+		// Patterns found in linear time: those of a random-access range of
+		// totally ordered values matched with equal_to, which the Two-Way
+		// algorithm handles, and which for contiguous bytes a vector filter
+		// on their first and last elements handles first.
+		template<class I1, class I2, class Pred, class Proj1, class Proj2>
+		static constexpr bool linear_searchable =
+			random_access_iterator<I1> && random_access_iterator<I2> &&
+			detail::simd::identity_projection<Proj1> &&
+			detail::simd::identity_projection<Proj2> &&
+			same_as<iter_value_t<I1>, iter_value_t<I2>> &&
+			detail::simd::is_equal_to<Pred, iter_value_t<I1>> &&
+			totally_ordered<iter_value_t<I1>>;
+
+		template<class I1, class I2>
+		static constexpr bool byte_searchable = contiguous_iterator<I1> &&
+			contiguous_iterator<I2> && detail::simd::bitwise_comparable<iter_value_t<I1>> &&
+			sizeof(iter_value_t<I1>) == 1;
+
+		// The position of the d2 elements at first2 among the d1 >= d2 >= 1
+		// elements at first1, or d1.
+		template<class I1, class I2>
+		static iter_difference_t<I1> linear(const I1 first1, const iter_difference_t<I1> d1,
+			const I2 first2, const iter_difference_t<I2> d2)
+		{
+			iter_difference_t<I1> from = 0;
+			if constexpr (byte_searchable<I1, I2>) {
+				const auto h = reinterpret_cast<const unsigned char*>(std::addressof(*first1));
+				const auto s = reinterpret_cast<const unsigned char*>(std::addressof(*first2));
+				if (d2 == 1) {
+					return static_cast<iter_difference_t<I1>>(detail::simd::find<true>(h,
+						static_cast<std::size_t>(d1), *s));
+				}
+				detail::simd::byte_search b{h, static_cast<std::size_t>(d1),
+					s, static_cast<std::size_t>(d2)};
+				from = static_cast<iter_difference_t<I1>>(detail::simd::search(b));
+				if (!b.gave_up) {
+					return from + d2 <= d1 ? from : d1;
+				}
+			}
+			return detail::two_way<I2, less>{first2, d2, less{}}.search(first1, d1, from);
+		}
+
 		template<forward_iterator I1, sentinel_for<I1> S1,
 			forward_iterator I2, sentinel_for<I2> S2, class Pred = equal_to,
 			class Proj1 = identity, class Proj2 = identity>
@@ -115,6 +169,19 @@ STL2_OPEN_NAMESPACE {
 
 			auto d1 = d1_;
 			auto first1 = ext::uncounted(first1_);
+			if constexpr (linear_searchable<decltype(first1), I2, Pred, Proj1, Proj2>) {
+				if (!detail::is_constant_evaluated() && d1 >= d2) {
+					const auto pos = linear(first1, d1, first2, d2);
+					if (pos == d1) {
+						auto end = ext::recounted(first1_, first1 + d1, d1);
+						return {end, end};
+					}
+					return {
+						ext::recounted(first1_, first1 + pos, pos),
+						ext::recounted(first1_, first1 + (pos + d2), pos + d2)
+					};
+				}
+			}
 			for(; d1 >= d2; ++first1, --d1) {
 				if (__stl2::invoke(pred, __stl2::invoke(proj1, *first1),
 						__stl2::invoke(proj2, *first2)))
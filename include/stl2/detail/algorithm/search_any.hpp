@@ -0,0 +1,92 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SEARCH_ANY_HPP
+#define STL2_DETAIL_ALGORITHM_SEARCH_ANY_HPP
+
+#include <stl2/detail/aho_corasick.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/iterator/operations.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/dangling.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// search_any [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		// Finds the leftmost occurrence of any of the patterns of an
+		// aho_corasick automaton, the longest if several start there, in one
+		// pass over the text. Having found a match, the scan goes on only as
+		// far as a longer pattern starting no later could still end. If
+		// there is none, the result is empty at the end of the text, with
+		// pattern the number of patterns.
+		struct __search_any_fn : private __niebloid {
+			template<forward_iterator I, sentinel_for<I> S>
+			requires detail::byte_like<iter_value_t<I>>
+			pattern_match<I> operator()(I first, S last, const aho_corasick& ac) const {
+				constexpr std::size_t npos = ~std::size_t{0};
+				if (ac.max_length() == 0) {
+					// Nothing can match: no pattern, or only empty ones.
+					auto end = __stl2::next(std::move(first), std::move(last));
+					return {{end, end}, ac.size()};
+				}
+				detail::scan_history<I> history(ac.max_length());
+				auto state = ac.start();
+				pattern_match<I> best{{first, first}, ac.size()};
+				std::size_t best_start = npos;
+				std::size_t stop = npos;
+				for (std::size_t pos = 0; first != last && pos < stop;) {
+					history.push(first);
+					state = ac.next(state, static_cast<unsigned char>(*first));
+					++first;
+					++pos;
+					if (ac.accepting(state)) {
+						// The longest pattern ending here starts first.
+						const std::size_t p = ac.pattern(ac.first_output(state));
+						const std::size_t length = ac.length(p);
+						if (pos - length < best_start) {
+							best_start = pos - length;
+							best = {{history.start(first, length), first}, p};
+							stop = best_start + ac.max_length();
+						} else if (pos - length == best_start) {
+							best = {{best.begin(), first}, p};
+						}
+					}
+				}
+				if (best_start == npos) {
+					auto end = __stl2::next(std::move(first), std::move(last));
+					best = {{end, end}, ac.size()};
+				}
+				return best;
+			}
+
+			template<forward_range R>
+			requires detail::byte_like<range_value_t<R>>
+			__maybe_dangling<R, pattern_match<iterator_t<R>>>
+			operator()(R&& r, const aho_corasick& ac) const {
+				return (*this)(begin(r), end(r), ac);
+			}
+
+			template<forward_range R, forward_range Patterns>
+			requires detail::byte_like<range_value_t<R>> &&
+				constructible_from<aho_corasick, Patterns>
+			__maybe_dangling<R, pattern_match<iterator_t<R>>>
+			operator()(R&& r, Patterns&& patterns) const {
+				return (*this)(begin(r), end(r), aho_corasick{patterns});
+			}
+		};
+
+		inline constexpr __search_any_fn search_any{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
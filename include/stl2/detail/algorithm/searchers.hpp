@@ -0,0 +1,288 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SEARCHERS_HPP
+#define STL2_DETAIL_ALGORITHM_SEARCHERS_HPP
+
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/simd.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
+#include <stl2/view/subrange.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Searchers [Extension]
+//
+// Preprocessed patterns to pass to search in place of a second range, as
+// std::search accepts the searchers of <functional>. Each refers to, and
+// must not outlive, the pattern it was made from.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class Searcher, class I, class S>
+		META_CONCEPT searcher = requires(const Searcher& s, I first, S last) {
+			{ s(std::move(first), std::move(last)) } -> same_as<subrange<I>>;
+		};
+	} // namespace ext
+
+	namespace detail {
+		// The Two-Way string matching algorithm of Crochemore and Perrin,
+		// for patterns of elements ordered by a strict weak order Comp and
+		// matched when equivalent. The pattern is split at a critical
+		// factorization, found from its two maximal suffixes; matching its
+		// right part left to right and then its left part right to left,
+		// while remembering how much of a periodic pattern is known to match
+		// after a shift by its period, makes at most 2n comparisons of
+		// elements over a text of length n, in constant space.
+		template<random_access_iterator I, class Comp>
+		struct two_way {
+			using D = iter_difference_t<I>;
+
+			I pattern_;
+			D m_;
+			D split_;        // The start of the right part
+			D period_;       // The shift after a match of the right part
+			D memory_;       // The prefix known to match after such a shift
+			Comp comp_;
+
+			constexpr two_way(I pattern, const D m, Comp comp)
+			: pattern_(std::move(pattern)), m_(m), split_(0), period_(1), memory_(0)
+			, comp_(std::move(comp))
+			{
+				const auto [ms1, p1] = maximal_suffix<false>();
+				const auto [ms2, p2] = maximal_suffix<true>();
+				split_ = ms1 < ms2 ? ms2 + 1 : ms1 + 1;
+				period_ = ms1 < ms2 ? p2 : p1;
+
+				D k = 0;
+				while (k < split_ && equivalent(pattern_[k], pattern_[k + period_])) ++k;
+				if (k == split_) {
+					memory_ = m_ - period_;
+				} else {
+					period_ = (split_ < m_ - split_ ? m_ - split_ : split_) + 1;
+				}
+			}
+
+			// The least position of the pattern in the n elements at text,
+			// no earlier than from, or n if there is none.
+			template<random_access_iterator T>
+			constexpr iter_difference_t<T> search(const T text, const iter_difference_t<T> n,
+				iter_difference_t<T> from = 0) const
+			{
+				using DT = iter_difference_t<T>;
+				if (n < m_) return n;
+				const DT last = n - static_cast<DT>(m_);
+				D mem = 0;
+				for (DT pos = from; pos <= last;) {
+					const T t = text + pos;
+					D k = split_ < mem ? mem : split_;
+					while (k < m_ && equivalent(pattern_[k], t[k])) ++k;
+					if (k < m_) {
+						pos += static_cast<DT>(k - split_ + 1);
+						mem = 0;
+						continue;
+					}
+					k = split_;
+					while (k > mem && equivalent(pattern_[k - 1], t[k - 1])) --k;
+					if (k <= mem) return pos;
+					pos += static_cast<DT>(period_);
+					mem = memory_;
+				}
+				return n;
+			}
+
+		private:
+			// Elements match when equivalent, which less reduces to equality.
+			template<class A, class B>
+			constexpr bool equivalent(A&& a, B&& b) const {
+				if constexpr (same_as<Comp, less>) {
+					return static_cast<bool>(a == b);
+				} else {
+					return !__stl2::invoke(comp_, a, b) && !__stl2::invoke(comp_, b, a);
+				}
+			}
+
+			// The position before the maximal suffix of the pattern under
+			// comp_, or its converse, and the period of that suffix.
+			template<bool Converse>
+			constexpr std::pair<D, D> maximal_suffix() const {
+				D i = -1, j = 0, k = 1, p = 1;
+				while (j + k < m_) {
+					auto&& a = pattern_[i + k];
+					auto&& b = pattern_[j + k];
+					if (equivalent(a, b)) {
+						if (k == p) {
+							j += p;
+							k = 1;
+						} else {
+							++k;
+						}
+					} else if (Converse ? __stl2::invoke(comp_, a, b) : __stl2::invoke(comp_, b, a)) {
+						j += k;
+						k = 1;
+						p = j - i;
+					} else {
+						i = j++;
+						k = p = 1;
+					}
+				}
+				return {i, p};
+			}
+		};
+	} // namespace detail
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// two_way_searcher [Extension]
+		//
+		// Finds a pattern in linear time and constant space, at most 2n
+		// comparisons over a text of length n, with elements matched when
+		// equivalent under the strict weak order Comp.
+		template<random_access_iterator I, class Comp = less>
+		requires indirect_strict_weak_order<Comp, I>
+		class two_way_searcher {
+			detail::two_way<I, Comp> impl_;
+		public:
+			template<sized_sentinel_for<I> S>
+			constexpr two_way_searcher(I first, S last, Comp comp = {})
+			: impl_(first, last - first, std::move(comp)) {}
+
+			template<random_access_range R>
+			requires _ForwardingRange<R> && same_as<iterator_t<R>, I> && sized_range<R>
+			constexpr explicit two_way_searcher(R&& r, Comp comp = {})
+			: impl_(begin(r), distance(r), std::move(comp)) {}
+
+			template<random_access_iterator T, sized_sentinel_for<T> S>
+			requires indirect_strict_weak_order<Comp, T, I>
+			constexpr subrange<T> operator()(T first, S last) const {
+				const auto n = last - first;
+				const auto m = static_cast<iter_difference_t<T>>(impl_.m_);
+				if (m == 0) return {first, first};
+				const auto pos = impl_.search(first, n);
+				if (pos == n) {
+					auto end = first + n;
+					return {end, end};
+				}
+				return {first + pos, first + (pos + m)};
+			}
+		};
+
+		template<random_access_iterator I, sized_sentinel_for<I> S, class Comp = less>
+		two_way_searcher(I, S, Comp = {}) -> two_way_searcher<I, Comp>;
+
+		template<random_access_range R, class Comp = less>
+		two_way_searcher(R&&, Comp = {}) -> two_way_searcher<iterator_t<R>, Comp>;
+
+		///////////////////////////////////////////////////////////////////////////
+		// boyer_moore_horspool_searcher [Extension]
+		//
+		// Compares each alignment of the pattern from its end, and on a
+		// mismatch shifts by as far as the last element of the alignment
+		// allows: sublinear on average for longer patterns, though O(n m) at
+		// worst. Shifts are kept in a table for single bytes compared with
+		// equal_to, and in a hash map keyed on Hash and Pred otherwise.
+		template<random_access_iterator I,
+			class Hash = std::hash<iter_value_t<I>>, class Pred = equal_to>
+		requires indirect_equivalence_relation<Pred, I> &&
+			copy_constructible<iter_value_t<I>>
+		class boyer_moore_horspool_searcher {
+			using D = iter_difference_t<I>;
+			using V = iter_value_t<I>;
+
+			static constexpr bool bytes = detail::simd::bitwise_comparable<V> &&
+				sizeof(V) == 1 && detail::simd::is_equal_to<Pred, V>;
+			using table_t = std::conditional_t<bytes, std::array<D, 256>,
+				std::unordered_map<V, D, Hash, Pred>>;
+
+			I pattern_;
+			D m_;
+			table_t table_;
+			Pred pred_;
+
+			static constexpr std::size_t byte_of(const V& v) noexcept {
+				return static_cast<unsigned char>(v);
+			}
+
+			// The shift when the last element of an alignment is v.
+			D shift(const V& v) const {
+				if constexpr (bytes) {
+					return table_[byte_of(v)];
+				} else {
+					const auto i = table_.find(v);
+					return i == table_.end() ? m_ : i->second;
+				}
+			}
+		public:
+			template<sized_sentinel_for<I> S>
+			boyer_moore_horspool_searcher(I first, S last, Hash hash = {}, Pred pred = {})
+			: pattern_(first), m_(last - first)
+			, table_(make_table(first, m_, std::move(hash), pred))
+			, pred_(std::move(pred)) {}
+
+			template<random_access_range R>
+			requires _ForwardingRange<R> && same_as<iterator_t<R>, I> && sized_range<R>
+			explicit boyer_moore_horspool_searcher(R&& r, Hash hash = {}, Pred pred = {})
+			: boyer_moore_horspool_searcher(begin(r), end(r), std::move(hash), std::move(pred)) {}
+
+			template<random_access_iterator T, sized_sentinel_for<T> S>
+			requires same_as<iter_value_t<T>, V> && indirect_equivalence_relation<Pred, T, I>
+			subrange<T> operator()(T first, S last) const {
+				const auto n = last - first;
+				const auto m = static_cast<iter_difference_t<T>>(m_);
+				if (m == 0) return {first, first};
+				for (iter_difference_t<T> pos = 0; pos <= n - m;) {
+					const T t = first + pos;
+					D k = m_ - 1;
+					while (__stl2::invoke(pred_, t[k], pattern_[k])) {
+						if (k == 0) return {t, t + m};
+						--k;
+					}
+					pos += static_cast<iter_difference_t<T>>(shift(t[m - 1]));
+				}
+				auto end = first + n;
+				return {end, end};
+			}
+
+		private:
+			static table_t make_table(const I first, const D m, Hash hash, const Pred& pred) {
+				if constexpr (bytes) {
+					table_t table;
+					table.fill(m);
+					for (D i = 0; i + 1 < m; ++i) {
+						table[byte_of(first[i])] = m - 1 - i;
+					}
+					return table;
+				} else {
+					table_t table(static_cast<std::size_t>(m), std::move(hash), pred);
+					for (D i = 0; i + 1 < m; ++i) {
+						table.insert_or_assign(first[i], m - 1 - i);
+					}
+					return table;
+				}
+			}
+		};
+
+		template<random_access_iterator I, sized_sentinel_for<I> S,
+			class Hash = std::hash<iter_value_t<I>>, class Pred = equal_to>
+		boyer_moore_horspool_searcher(I, S, Hash = {}, Pred = {}) ->
+			boyer_moore_horspool_searcher<I, Hash, Pred>;
+
+		template<random_access_range R,
+			class Hash = std::hash<range_value_t<R>>, class Pred = equal_to>
+		boyer_moore_horspool_searcher(R&&, Hash = {}, Pred = {}) ->
+			boyer_moore_horspool_searcher<iterator_t<R>, Hash, Pred>;
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
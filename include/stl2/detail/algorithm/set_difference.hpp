@@ -13,6 +13,7 @@
 #define STL2_DETAIL_ALGORITHM_SET_DIFFERENCE_HPP
 
 #include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
@@ -33,6 +34,38 @@ STL2_OPEN_NAMESPACE {
 		operator()(I1 first1, S1 last1, I2 first2, S2 last2, O result,
 			Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (forward_iterator<I1> && forward_iterator<I2> &&
+				(detail::gallopable<I1, S1> || detail::gallopable<I2, S2>))
+			{
+				// Skip each run of elements of either range less than the
+				// other's current element in one galloping search; those of
+				// the first range are copied in one go.
+				while (bool(first1 != last1) && bool(first2 != last2)) {
+					{
+						iter_reference_t<I2>&& v2 = *first2;
+						auto&& p2 = __stl2::invoke(proj2, v2);
+						auto less = [&](auto&& p1) -> bool {
+							return __stl2::invoke(comp, p1, p2);
+						};
+						auto run = detail::skip_while(first1, last1, less, proj1);
+						result = copy(std::move(first1), run, std::move(result)).out;
+						first1 = std::move(run);
+					}
+					if (first1 == last1) break;
+					iter_reference_t<I1>&& v1 = *first1;
+					auto&& p1 = __stl2::invoke(proj1, v1);
+					auto less = [&](auto&& p2) -> bool {
+						return __stl2::invoke(comp, p2, p1);
+					};
+					first2 = detail::skip_while(std::move(first2), last2, less, proj2);
+					if (first2 == last2) break;
+					if (!__stl2::invoke(comp, p1, __stl2::invoke(proj2, *first2))) {
+						++first1;
+						++first2;
+					}
+				}
+				return copy(std::move(first1), std::move(last1), std::move(result));
+			}
 			while (bool(first1 != last1) && bool(first2 != last2)) {
 				iter_reference_t<I1>&& v1 = *first1;
 				iter_reference_t<I2>&& v2 = *first2;
@@ -12,9 +12,12 @@
 #ifndef STL2_DETAIL_ALGORITHM_SET_INTERSECTION_HPP
 #define STL2_DETAIL_ALGORITHM_SET_INTERSECTION_HPP
 
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/gallop.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/simd.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // set_intersection [set.intersection]
@@ -32,6 +35,23 @@ STL2_OPEN_NAMESPACE {
 		operator()(I1 first1, S1 last1, I2 first2, S2 last2, O result,
 			Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (detail::simd::intersectable<I1, S1, I2, S2, O, Comp, Proj1, Proj2>) {
+				if (!detail::is_constant_evaluated()) {
+					auto const n1 = last1 - first1;
+					auto const n2 = last2 - first2;
+					// Galloping wins when one range is much the shorter.
+					if (n1 / skewed <= n2 && n2 / skewed <= n1) {
+						return blocks(std::move(first1), n1, std::move(first2), n2,
+							std::move(result));
+					}
+				}
+			}
+			if constexpr (forward_iterator<I1> && forward_iterator<I2> &&
+				(detail::gallopable<I1, S1> || detail::gallopable<I2, S2>))
+			{
+				return gallop(std::move(first1), std::move(last1), std::move(first2),
+					std::move(last2), std::move(result), comp, proj1, proj2);
+			}
 			while (bool(first1 != last1) && bool(first2 != last2)) {
 				iter_reference_t<I1>&& v1 = *first1;
 				iter_reference_t<I2>&& v2 = *first2;
@@ -63,6 +83,102 @@ STL2_OPEN_NAMESPACE {
 				std::move(result), __stl2::ref(comp), __stl2::ref(proj1),
 				__stl2::ref(proj2));
 		}
+	private:
+		// The ratio of lengths beyond which galloping beats the kernels.
+		static constexpr int skewed = 32;
+
+		// Skips each run of elements of either range that are less than
+		// the other's current element in one galloping search: the same
+		// steps as the loop above, in fewer comparisons when the ranges
+		// differ in length or interleave in long runs.
+		template<class I1, class S1, class I2, class S2, class O, class Comp,
+			class Proj1, class Proj2>
+		static constexpr set_intersection_result<I1, I2, O>
+		gallop(I1 first1, S1 last1, I2 first2, S2 last2, O result, Comp& comp,
+			Proj1& proj1, Proj2& proj2)
+		{
+			while (bool(first1 != last1) && bool(first2 != last2)) {
+				{
+					iter_reference_t<I2>&& v2 = *first2;
+					auto&& p2 = __stl2::invoke(proj2, v2);
+					auto less = [&](auto&& p1) -> bool {
+						return __stl2::invoke(comp, p1, p2);
+					};
+					first1 = detail::skip_while(std::move(first1), last1, less, proj1);
+				}
+				if (first1 == last1) break;
+				iter_reference_t<I1>&& v1 = *first1;
+				auto&& p1 = __stl2::invoke(proj1, v1);
+				auto less = [&](auto&& p2) -> bool {
+					return __stl2::invoke(comp, p2, p1);
+				};
+				first2 = detail::skip_while(std::move(first2), last2, less, proj2);
+				if (first2 == last2) break;
+				if (__stl2::invoke(comp, p1, __stl2::invoke(proj2, *first2))) continue;
+				*result = std::forward<iter_reference_t<I1>>(v1);
+				++result;
+				++first1;
+				++first2;
+			}
+			return {std::move(first1), std::move(first2), std::move(result)};
+		}
+
+		// Contiguous integers, compared a block at a time by the kernels
+		// while the blocks hold no duplicates; the loop above takes over
+		// for the blocks that do, and for the last of each range.
+		template<class I1, class I2, class O>
+		static set_intersection_result<I1, I2, O>
+		blocks(I1 first1, const iter_difference_t<I1> n1, I2 first2,
+			const iter_difference_t<I2> n2, O result)
+		{
+			using T = iter_value_t<I1>;
+			namespace simd = detail::simd;
+			if (n1 == 0 || n2 == 0) {
+				return {std::move(first1), std::move(first2), std::move(result)};
+			}
+			T buffer[simd::intersection_buffer];
+			simd::block_intersection<T> s{std::addressof(*first1),
+				static_cast<std::size_t>(n1), std::addressof(*first2),
+				static_cast<std::size_t>(n2), buffer};
+			for (;;) {
+				const auto stop = simd::intersect(s);
+				result = copy(static_cast<const T*>(buffer), buffer + s.count,
+					std::move(result)).out;
+				s.count = 0;
+				if (stop == simd::intersection_stop::full) continue;
+				if (stop == simd::intersection_stop::tail) break;
+				// Past the blocks holding the duplicates, in either range
+				merge(s, result, s.i + simd::intersection_block<T>,
+					s.j + simd::intersection_block<T>);
+			}
+			merge(s, result, s.na, s.nb);
+			return {first1 + static_cast<iter_difference_t<I1>>(s.i),
+				first2 + static_cast<iter_difference_t<I2>>(s.j), std::move(result)};
+		}
+
+		// The loop above, until either range reaches its bound.
+		template<class T, class O>
+		static void merge(detail::simd::block_intersection<T>& s, O& result,
+			const std::size_t bound1, const std::size_t bound2)
+		{
+			std::size_t i = s.i, j = s.j;
+			const std::size_t m1 = bound1 < s.na ? bound1 : s.na;
+			const std::size_t m2 = bound2 < s.nb ? bound2 : s.nb;
+			while (i < m1 && j < m2) {
+				if (s.a[i] < s.b[j]) {
+					++i;
+				} else if (s.b[j] < s.a[i]) {
+					++j;
+				} else {
+					*result = s.a[i];
+					++result;
+					++i;
+					++j;
+				}
+			}
+			s.i = i;
+			s.j = j;
+		}
 	};
 
 	inline constexpr __set_intersection_fn set_intersection{};
@@ -35,8 +35,12 @@
 #ifndef STL2_DETAIL_ALGORITHM_SORT_HPP
 #define STL2_DETAIL_ALGORITHM_SORT_HPP
 
+#include <stl2/detail/algorithm/make_heap.hpp>
 #include <stl2/detail/algorithm/move_backward.hpp>
-#include <stl2/detail/algorithm/partial_sort.hpp>
+#include <stl2/detail/algorithm/radix_sort.hpp>
+#include <stl2/detail/algorithm/sample_sort.hpp>
+#include <stl2/detail/algorithm/sorting_network.hpp>
+#include <stl2/detail/algorithm/sort_heap.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
@@ -85,6 +89,37 @@ STL2_OPEN_NAMESPACE {
 		};
 	}
 
+	namespace detail {
+		// Comparisons that are known to be cheap and free of side effects
+		// when applied to arithmetic keys; for these, sort uses the
+		// branchless block partition.
+		template<class Comp>
+		inline constexpr bool is_builtin_order = false;
+		template<>
+		inline constexpr bool is_builtin_order<less> = true;
+		template<>
+		inline constexpr bool is_builtin_order<greater> = true;
+		template<class T>
+		inline constexpr bool is_builtin_order<std::less<T>> = true;
+		template<class T>
+		inline constexpr bool is_builtin_order<std::greater<T>> = true;
+
+		template<class I, class Comp, class Proj>
+		META_CONCEPT branchless_sortable = is_builtin_order<Comp> &&
+			ext::Arithmetic<__uncvref<indirect_result_t<Proj&, I>>>;
+	}
+
+	// sort is a pattern-defeating quicksort (after Orson Peters' pdqsort):
+	// introsort with ninther pivot selection, detection of already
+	// partitioned inputs, deterministic shuffling of unbalanced partitions,
+	// and a branchless block partition (Edelkamp & Weiss' BlockQuicksort)
+	// for cheap comparisons. Heapsort remains the worst-case fallback.
+	// Small partitions are insertion sorted, or, for contiguous scalars
+	// ordered by value, sorted by a sorting network.
+	// Large ranges ordered by less or greater on an integral or IEEE-754
+	// floating-point key are radix sorted instead. With ext::par, the
+	// range is distributed by a parallel samplesort, and the buckets are
+	// sorted as above.
 	struct __sort_fn : private __niebloid {
 		template<random_access_iterator I, sentinel_for<I> S, class Comp = less,
 			class Proj = identity>
@@ -94,8 +129,16 @@ STL2_OPEN_NAMESPACE {
 			if (first == sent) return first;
 			auto last = next(first, static_cast<S&&>(sent));
 			auto n = distance(first, last);
-			introsort_loop(first, last, log2(n) * 2, comp, proj);
-			final_insertion_sort(first, last, comp, proj);
+			if constexpr (detail::radix_sortable<I, Comp, Proj>) {
+				if (n >= radix_sort_threshold && !detail::is_constant_evaluated()) {
+					constexpr int order =
+						detail::radix_order<Comp, detail::radix_key_t<I, Proj>>;
+					detail::radix::sort<order>(first, n, proj);
+					return last;
+				}
+			}
+			pdq_loop<detail::branchless_sortable<I, Comp, Proj>>(
+				first, last, log2(n), true, comp, proj);
 			return last;
 		}
 
@@ -106,65 +149,429 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r), end(r), static_cast<Comp&&>(comp),
 				static_cast<Proj&&>(proj));
 		}
+
+		template<class EP, random_access_iterator I, sentinel_for<I> S,
+			class Comp = less, class Proj = identity>
+		requires ext::execution_policy<EP> && sortable<I, Comp, Proj>
+		I operator()(EP&& policy, I first, S sent, Comp comp = {}, Proj proj = {}) const {
+			if constexpr (same_as<__uncvref<EP>, ext::parallel_policy>) {
+				auto last = next(first, static_cast<S&&>(sent));
+				auto seq = [this](I f, I l, Comp& c, Proj& p) { (*this)(f, l, c, p); };
+				detail::sample_sort::sort(first, static_cast<std::ptrdiff_t>(last - first),
+					policy.concurrency(), comp, proj, seq);
+				return last;
+			} else {
+				return (*this)(first, static_cast<S&&>(sent), static_cast<Comp&&>(comp),
+					static_cast<Proj&&>(proj));
+			}
+		}
+
+		template<class EP, random_access_range R, class Comp = less, class Proj = identity>
+		requires ext::execution_policy<EP> && sortable<iterator_t<R>, Comp, Proj>
+		safe_iterator_t<R> operator()(EP&& policy, R&& r, Comp comp = {}, Proj proj = {}) const {
+			return (*this)(static_cast<EP&&>(policy), begin(r), end(r),
+				static_cast<Comp&&>(comp), static_cast<Proj&&>(proj));
+		}
 	private:
-		static constexpr std::ptrdiff_t introsort_threshold = 16;
+		// Partitions smaller than this are insertion sorted.
+		static constexpr std::ptrdiff_t insertion_sort_threshold = 24;
+		// Partitions larger than this use Tukey's ninther as the pivot.
+		static constexpr std::ptrdiff_t ninther_threshold = 128;
+		// Moves allowed in partial_insertion_sort before giving up.
+		static constexpr std::ptrdiff_t partial_insertion_sort_limit = 8;
+		// Elements examined per block by the branchless partition; offsets
+		// within a block must fit in an unsigned char.
+		static constexpr std::ptrdiff_t block_size = 64;
+		// Ranges at least this large are radix sorted when possible.
+		static constexpr std::ptrdiff_t radix_sort_threshold = 4096;
 
 		template<random_access_iterator I, class Comp, class Proj>
 		requires sortable<I, Comp, Proj>
-		static constexpr I
+		static constexpr void
+		sort2(I a, I b, Comp& comp, Proj& proj) {
+			if (__stl2::invoke(comp, __stl2::invoke(proj, *b), __stl2::invoke(proj, *a))) {
+				iter_swap(a, b);
+			}
+		}
+
+		template<random_access_iterator I, class Comp, class Proj>
+		requires sortable<I, Comp, Proj>
+		static constexpr void
+		sort3(I a, I b, I c, Comp& comp, Proj& proj) {
+			sort2(a, b, comp, proj);
+			sort2(b, c, comp, proj);
+			sort2(a, b, comp, proj);
+		}
+
+		// Moves the chosen pivot to *first. Post: *(last - 1) is not less
+		// than the pivot, which guards the rightward scans of the partitions.
+		template<random_access_iterator I, class Comp, class Proj>
+		requires sortable<I, Comp, Proj>
+		static constexpr void
 		choose_pivot(I first, I last, Comp& comp, Proj& proj) {
-			STL2_EXPECT(first != last);
-			I mid = first + iter_difference_t<I>(last - first) / 2;
-			--last;
-			// Find the median:
-			return [&](auto&& a, auto&& b, auto&& c) {
-				return __stl2::invoke(comp, a, b)
-					? (__stl2::invoke(comp, b, c) ? mid   : (__stl2::invoke(comp, a, c) ? last : first))
-					: (__stl2::invoke(comp, a, c) ? first : (__stl2::invoke(comp, b, c) ? last : mid  ));
-			}(__stl2::invoke(proj, *first), __stl2::invoke(proj, *mid), __stl2::invoke(proj, *last));
+			using D = iter_difference_t<I>;
+			const D n = last - first;
+			STL2_EXPECT(n >= 3);
+			const D half = n / 2;
+			if (n > ninther_threshold) {
+				sort3(first, first + half, last - 1, comp, proj);
+				sort3(first + 1, first + (half - 1), last - 2, comp, proj);
+				sort3(first + 2, first + (half + 1), last - 3, comp, proj);
+				sort3(first + (half - 1), first + half, first + (half + 1), comp, proj);
+				iter_swap(first, first + half);
+			} else {
+				sort3(first + half, first, last - 1, comp, proj);
+			}
 		}
 
+		// Partitions [first, last) around the pivot *first into elements
+		// less than the pivot followed by elements not less than the pivot.
+		// Returns the final position of the pivot, and whether the range was
+		// already partitioned.
 		template<random_access_iterator I, class Comp, class Proj>
 		requires sortable<I, Comp, Proj>
-		static constexpr I
-		unguarded_partition(I first, I last, Comp& comp, Proj& proj) {
-			I pivot_pnt = choose_pivot(first, last, comp, proj);
+		static constexpr std::pair<I, bool>
+		partition_right(I first, I last, Comp& comp, Proj& proj) {
+			const I base = first;
+			iter_value_t<I> pivot = iter_move(first);
+			auto&& key = __stl2::invoke(proj, pivot);
 
-			// Do the partition:
-			while (true) {
-				auto&& v = *pivot_pnt;
-				auto&& pivot = __stl2::invoke(proj, std::forward<decltype(v)>(v));
-				while (__stl2::invoke(comp, __stl2::invoke(proj, *first), pivot)) {
-					++first;
-				}
-				while (__stl2::invoke(comp, pivot, __stl2::invoke(proj, *--last))) {
-					; // do nothing
+			// *(last - 1) guards the first scan; if there are elements less
+			// than the pivot, the leftmost of them guards the second.
+			while (__stl2::invoke(comp, __stl2::invoke(proj, *++first), key)) {}
+			if (first - 1 == base) {
+				while (first < last && !__stl2::invoke(comp, __stl2::invoke(proj, *--last), key)) {}
+			} else {
+				while (!__stl2::invoke(comp, __stl2::invoke(proj, *--last), key)) {}
+			}
+
+			const bool already_partitioned = first >= last;
+			while (first < last) {
+				iter_swap(first, last);
+				while (__stl2::invoke(comp, __stl2::invoke(proj, *++first), key)) {}
+				while (!__stl2::invoke(comp, __stl2::invoke(proj, *--last), key)) {}
+			}
+
+			I pivot_pos = first - 1;
+			*base = iter_move(pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return {pivot_pos, already_partitioned};
+		}
+
+		// Swaps num pairs of elements between the left block at first and the
+		// right block ending at last, using a cyclic permutation when the
+		// number of misplaced elements on the two sides differ.
+		template<random_access_iterator I>
+		requires permutable<I>
+		static constexpr void
+		swap_offsets(I first, I last, const unsigned char* offsets_l,
+			const unsigned char* offsets_r, std::ptrdiff_t num, bool use_swaps)
+		{
+			if (use_swaps) {
+				// The two sides contain the same number of elements, which
+				// must all be swapped anyway; this avoids the extra
+				// moves of the rotation.
+				for (std::ptrdiff_t i = 0; i < num; ++i) {
+					iter_swap(first + offsets_l[i], last - offsets_r[i]);
 				}
-				if (!(first < last)) {
-					return first;
+			} else if (num > 0) {
+				I l = first + offsets_l[0];
+				I r = last - offsets_r[0];
+				iter_value_t<I> tmp = iter_move(l);
+				*l = iter_move(r);
+				for (std::ptrdiff_t i = 1; i < num; ++i) {
+					l = first + offsets_l[i];
+					*r = iter_move(l);
+					r = last - offsets_r[i];
+					*l = iter_move(r);
 				}
+				*r = std::move(tmp);
+			}
+		}
+
+		// As partition_right, but the comparisons of each block are recorded
+		// in an offset buffer without branching on their results, and the
+		// misplaced elements are swapped afterwards.
+		template<random_access_iterator I, class Comp, class Proj>
+		requires sortable<I, Comp, Proj>
+		static constexpr std::pair<I, bool>
+		partition_right_branchless(I first, I last, Comp& comp, Proj& proj) {
+			using D = iter_difference_t<I>;
+			const I base = first;
+			iter_value_t<I> pivot = iter_move(first);
+			auto&& key = __stl2::invoke(proj, pivot);
+
+			while (__stl2::invoke(comp, __stl2::invoke(proj, *++first), key)) {}
+			if (first - 1 == base) {
+				while (first < last && !__stl2::invoke(comp, __stl2::invoke(proj, *--last), key)) {}
+			} else {
+				while (!__stl2::invoke(comp, __stl2::invoke(proj, *--last), key)) {}
+			}
+
+			const bool already_partitioned = first >= last;
+			if (!already_partitioned) {
+				// Swap the first pair of misplaced elements now so that
+				// [first, last) is exactly the unpartitioned region.
 				iter_swap(first, last);
-				pivot_pnt = pivot_pnt == first ? last : (pivot_pnt == last ? first : pivot_pnt);
 				++first;
+
+				unsigned char offsets_l[block_size] = {};
+				unsigned char offsets_r[block_size] = {};
+				std::ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+				while (last - first > 2 * block_size) {
+					if (num_l == 0) {
+						start_l = 0;
+						I it = first;
+						for (std::ptrdiff_t i = 0; i < block_size; ++i, ++it) {
+							offsets_l[num_l] = static_cast<unsigned char>(i);
+							num_l += !__stl2::invoke(comp, __stl2::invoke(proj, *it), key);
+						}
+					}
+					if (num_r == 0) {
+						start_r = 0;
+						I it = last;
+						for (std::ptrdiff_t i = 0; i < block_size; ++i) {
+							offsets_r[num_r] = static_cast<unsigned char>(i + 1);
+							num_r += __stl2::invoke(comp, __stl2::invoke(proj, *--it), key);
+						}
+					}
+
+					const std::ptrdiff_t num = num_l < num_r ? num_l : num_r;
+					swap_offsets(first, last, offsets_l + start_l, offsets_r + start_r,
+						num, num_l == num_r);
+					num_l -= num;
+					num_r -= num;
+					start_l += num;
+					start_r += num;
+					if (num_l == 0) first += D(block_size);
+					if (num_r == 0) last -= D(block_size);
+				}
+
+				// Fewer than two blocks remain: size the final blocks to cover
+				// what is left, keeping any block with pending offsets.
+				std::ptrdiff_t l_size = 0, r_size = 0;
+				const std::ptrdiff_t unknown_left =
+					(last - first) - ((num_r || num_l) ? block_size : 0);
+				if (num_r) {
+					l_size = unknown_left;
+					r_size = block_size;
+				} else if (num_l) {
+					l_size = block_size;
+					r_size = unknown_left;
+				} else {
+					l_size = unknown_left / 2;
+					r_size = unknown_left - l_size;
+				}
+
+				if (unknown_left && !num_l) {
+					start_l = 0;
+					I it = first;
+					for (std::ptrdiff_t i = 0; i < l_size; ++i, ++it) {
+						offsets_l[num_l] = static_cast<unsigned char>(i);
+						num_l += !__stl2::invoke(comp, __stl2::invoke(proj, *it), key);
+					}
+				}
+				if (unknown_left && !num_r) {
+					start_r = 0;
+					I it = last;
+					for (std::ptrdiff_t i = 0; i < r_size; ++i) {
+						offsets_r[num_r] = static_cast<unsigned char>(i + 1);
+						num_r += __stl2::invoke(comp, __stl2::invoke(proj, *--it), key);
+					}
+				}
+
+				const std::ptrdiff_t num = num_l < num_r ? num_l : num_r;
+				swap_offsets(first, last, offsets_l + start_l, offsets_r + start_r,
+					num, num_l == num_r);
+				num_l -= num;
+				num_r -= num;
+				start_l += num;
+				start_r += num;
+				if (num_l == 0) first += D(l_size);
+				if (num_r == 0) last -= D(r_size);
+
+				// One side may still hold misplaced elements; move them
+				// to the boundary, processing offsets back to front.
+				if (num_l) {
+					while (num_l--) {
+						iter_swap(first + offsets_l[start_l + num_l], --last);
+					}
+					first = last;
+				}
+				if (num_r) {
+					while (num_r--) {
+						iter_swap(last - offsets_r[start_r + num_r], first);
+						++first;
+					}
+					last = first;
+				}
+			}
+
+			I pivot_pos = first - 1;
+			*base = iter_move(pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return {pivot_pos, already_partitioned};
+		}
+
+		// Partitions [first, last) around the pivot *first into elements
+		// equivalent to the pivot followed by elements greater than the
+		// pivot. Used when the pivot is known to be a minimum of the range,
+		// which makes runs of equal elements cost linear time.
+		template<random_access_iterator I, class Comp, class Proj>
+		requires sortable<I, Comp, Proj>
+		static constexpr I
+		partition_left(I first, I last, Comp& comp, Proj& proj) {
+			const I base = first;
+			iter_value_t<I> pivot = iter_move(first);
+			auto&& key = __stl2::invoke(proj, pivot);
+
+			const I end = last;
+
+			// The pivot guards the leftward scans; if there are elements
+			// greater than the pivot, the rightmost of them guards the first
+			// rightward scan.
+			while (__stl2::invoke(comp, key, __stl2::invoke(proj, *--last))) {}
+			if (last + 1 == end) {
+				while (first < last && !__stl2::invoke(comp, key, __stl2::invoke(proj, *++first))) {}
+			} else {
+				while (!__stl2::invoke(comp, key, __stl2::invoke(proj, *++first))) {}
 			}
+
+			while (first < last) {
+				iter_swap(first, last);
+				while (__stl2::invoke(comp, key, __stl2::invoke(proj, *--last))) {}
+				while (!__stl2::invoke(comp, key, __stl2::invoke(proj, *++first))) {}
+			}
+
+			I pivot_pos = last;
+			*base = iter_move(pivot_pos);
+			*pivot_pos = std::move(pivot);
+			return pivot_pos;
 		}
 
+		// Insertion sorts [first, last), giving up if more than
+		// partial_insertion_sort_limit elements have been moved. Returns
+		// true if the range is sorted.
 		template<random_access_iterator I, class Comp, class Proj>
 		requires sortable<I, Comp, Proj>
+		static constexpr bool
+		partial_insertion_sort(I first, I last, Comp& comp, Proj& proj) {
+			if (first == last) return true;
+
+			std::ptrdiff_t limit = 0;
+			for (I cur = first + 1; cur != last; ++cur) {
+				I sift = cur;
+				I sift_1 = cur - 1;
+				if (__stl2::invoke(comp, __stl2::invoke(proj, *sift), __stl2::invoke(proj, *sift_1))) {
+					iter_value_t<I> tmp = iter_move(sift);
+					do {
+						*sift = iter_move(sift_1);
+						--sift;
+					} while (sift != first &&
+						__stl2::invoke(comp, __stl2::invoke(proj, tmp), __stl2::invoke(proj, *--sift_1)));
+					*sift = std::move(tmp);
+					limit += cur - sift;
+					if (limit > partial_insertion_sort_limit) return false;
+				}
+			}
+			return true;
+		}
+
+		template<bool Branchless, random_access_iterator I, class Comp, class Proj>
+		requires sortable<I, Comp, Proj>
 		static constexpr void
-		introsort_loop(I first, I last, iter_difference_t<I> depth_limit, Comp& comp, Proj& proj)
+		pdq_loop(I first, I last, iter_difference_t<I> bad_allowed, bool leftmost,
+			Comp& comp, Proj& proj)
 		{
-			while (distance(first, last) > introsort_threshold) {
-				if (depth_limit == 0) {
-					partial_sort(first, last, last, __stl2::ref(comp), __stl2::ref(proj));
+			using D = iter_difference_t<I>;
+			while (true) {
+				const D n = last - first;
+				if constexpr (detail::network_sortable<I, Comp, Proj>) {
+					if (n <= detail::sorting_network::max_size &&
+						!detail::is_constant_evaluated())
+					{
+						constexpr int order = detail::radix_order<Comp, iter_value_t<I>>;
+						detail::sorting_network::sort<order>(
+							std::addressof(*first), static_cast<std::ptrdiff_t>(n));
+						return;
+					}
+				}
+				if (n < insertion_sort_threshold) {
+					if (leftmost) {
+						detail::rsort::insertion_sort(first, last, comp, proj);
+					} else {
+						unguarded_insertion_sort(first, last, comp, proj);
+					}
+					return;
+				}
+
+				choose_pivot(first, last, comp, proj);
+
+				// If *(first - 1) ends the right partition of a previous
+				// partition operation, no element in [first, last) is less
+				// than it. A pivot equivalent to *(first - 1) is then a
+				// minimum, and all elements equivalent to it can be put in
+				// place at once.
+				if (!leftmost && !__stl2::invoke(comp,
+						__stl2::invoke(proj, *(first - 1)), __stl2::invoke(proj, *first))) {
+					first = partition_left(first, last, comp, proj) + 1;
+					continue;
+				}
+
+				auto [pivot_pos, already_partitioned] = Branchless
+					? partition_right_branchless(first, last, comp, proj)
+					: partition_right(first, last, comp, proj);
+
+				const D l_size = pivot_pos - first;
+				const D r_size = last - (pivot_pos + 1);
+				if (l_size < n / 8 || r_size < n / 8) {
+					// A highly unbalanced partition: once too many of these
+					// have been seen, fall back to heapsort for guaranteed
+					// O(n log n). Otherwise shuffle some elements to break
+					// up the pattern that produced it.
+					if (--bad_allowed == 0) {
+						make_heap(first, last, __stl2::ref(comp), __stl2::ref(proj));
+						sort_heap(first, last, __stl2::ref(comp), __stl2::ref(proj));
+						return;
+					}
+
+					if (l_size >= insertion_sort_threshold) {
+						iter_swap(first, first + l_size / 4);
+						iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+						if (l_size > ninther_threshold) {
+							iter_swap(first + 1, first + (l_size / 4 + 1));
+							iter_swap(first + 2, first + (l_size / 4 + 2));
+							iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+							iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+						}
+					}
+					if (r_size >= insertion_sort_threshold) {
+						iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+						iter_swap(last - 1, last - r_size / 4);
+						if (r_size > ninther_threshold) {
+							iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+							iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+							iter_swap(last - 2, last - (1 + r_size / 4));
+							iter_swap(last - 3, last - (2 + r_size / 4));
+						}
+					}
+				} else if (already_partitioned &&
+					partial_insertion_sort(first, pivot_pos, comp, proj) &&
+					partial_insertion_sort(pivot_pos + 1, last, comp, proj)) {
+					// A well-balanced partition that required no swaps is a
+					// hint that the input is (nearly) sorted.
 					return;
 				}
-				I cut = unguarded_partition(first, last, comp, proj);
-				introsort_loop(cut, last, --depth_limit, comp, proj);
-				last = cut;
+
+				// Recurse into the left partition, loop on the right.
+				pdq_loop<Branchless>(first, pivot_pos, bad_allowed, leftmost, comp, proj);
+				first = pivot_pos + 1;
+				leftmost = false;
 			}
 		}
 
+		// Pre: [first - 1] is not greater than any element of [first, last).
 		template<bidirectional_iterator I, class Comp, class Proj>
 		requires sortable<I, Comp, Proj>
 		static constexpr void
@@ -174,18 +581,6 @@ STL2_OPEN_NAMESPACE {
 			}
 		}
 
-		template<random_access_iterator I, class Comp, class Proj>
-		requires sortable<I, Comp, Proj>
-		static constexpr void
-		final_insertion_sort(I first, I last, Comp &comp, Proj &proj) {
-			if (distance(first, last) > introsort_threshold) {
-				detail::rsort::insertion_sort(first, first + introsort_threshold, comp, proj);
-				unguarded_insertion_sort(first + introsort_threshold, last, comp, proj);
-			} else {
-				detail::rsort::insertion_sort(first, last, comp, proj);
-			}
-		}
-
 		template<integral I>
 		static constexpr auto log2(I n) {
 			STL2_EXPECT(n > 0);
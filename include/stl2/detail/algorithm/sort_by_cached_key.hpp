@@ -0,0 +1,156 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SORT_BY_CACHED_KEY_HPP
+#define STL2_DETAIL_ALGORITHM_SORT_BY_CACHED_KEY_HPP
+
+#include <cstdint>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// sort_by_cached_key [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class K, class Index>
+		struct cached_key {
+			K key;
+			Index index;
+
+			template<class T>
+			cached_key(T&& t, Index i)
+			: key(static_cast<T&&>(t)), index{i} {}
+		};
+
+		template<class I, class Proj>
+		using cached_key_t = __uncvref<indirect_result_t<Proj&, I>>;
+
+		template<class I, class Proj>
+		META_CONCEPT cacheable_key = movable<cached_key_t<I, Proj>> &&
+			constructible_from<cached_key_t<I, Proj>, indirect_result_t<Proj&, I>>;
+
+		// Projects each element of [first, first + n) exactly once into a
+		// buffer of (key, original position), sorts the buffer, and then
+		// moves each element into place by following the cycles of the
+		// resulting permutation: every element not already in place moves
+		// once, plus one move per cycle through a temporary. Ties between
+		// keys are broken by position when Stable. Returns false without
+		// touching the range if the buffer cannot be had.
+		template<bool Stable, class Index, random_access_iterator I, class C, class P>
+		bool sort_by_cached_key(const I first, const iter_difference_t<I> n, C& comp, P& proj) {
+			using E = cached_key<cached_key_t<I, P>, Index>;
+			temporary_buffer<E> buf{static_cast<std::ptrdiff_t>(n)};
+			if (buf.size() < n) {
+				return false;
+			}
+			temporary_vector<E> vec{buf};
+			I it = first;
+			for (Index i = 0; i < static_cast<Index>(n); ++i, ++it) {
+				vec.emplace_back(__stl2::invoke(proj, *it), i);
+			}
+
+			if constexpr (Stable) {
+				sort(vec, [&comp](auto&& a, auto&& b) {
+					if (__stl2::invoke(comp, a.key, b.key)) return true;
+					if (__stl2::invoke(comp, b.key, a.key)) return false;
+					return a.index < b.index;
+				});
+			} else {
+				sort(vec, __stl2::ref(comp), &E::key);
+			}
+
+			for (Index i = 0; i < static_cast<Index>(n); ++i) {
+				if (vec[i].index == i) continue;
+				iter_value_t<I> tmp = iter_move(first + i);
+				Index j = i;
+				while (true) {
+					const Index k = vec[j].index;
+					vec[j].index = j;
+					if (k == i) break;
+					*(first + j) = iter_move(first + k);
+					j = k;
+				}
+				*(first + j) = std::move(tmp);
+			}
+			return true;
+		}
+
+		template<bool Stable, random_access_iterator I, class C, class P>
+		bool sort_by_cached_key(const I first, const iter_difference_t<I> n, C& comp, P& proj) {
+			if (static_cast<std::make_unsigned_t<iter_difference_t<I>>>(n) <= UINT32_MAX) {
+				return sort_by_cached_key<Stable, std::uint32_t>(first, n, comp, proj);
+			}
+			return sort_by_cached_key<Stable, std::ptrdiff_t>(first, n, comp, proj);
+		}
+	}
+
+	namespace ext {
+		// Sorts like sort, but invokes proj exactly once per element rather
+		// than twice per comparison, which pays off when the projection is
+		// expensive next to moving an element. The keys are held in a
+		// temporary buffer of n (key, index) pairs; should that be
+		// unavailable, this falls back to sort, projecting as usual.
+		struct __sort_by_cached_key_fn : private __niebloid {
+			template<random_access_iterator I, sentinel_for<I> S, class Comp = less,
+				class Proj = identity>
+			requires sortable<I, Comp, Proj> && detail::cacheable_key<I, Proj>
+			I operator()(I first, S sent, Comp comp = {}, Proj proj = {}) const {
+				auto last = next(first, static_cast<S&&>(sent));
+				const auto n = distance(first, last);
+				if (n > 1 && !detail::sort_by_cached_key<false>(first, n, comp, proj)) {
+					sort(first, last, __stl2::ref(comp), __stl2::ref(proj));
+				}
+				return last;
+			}
+
+			template<random_access_range R, class Comp = less, class Proj = identity>
+			requires sortable<iterator_t<R>, Comp, Proj> &&
+				detail::cacheable_key<iterator_t<R>, Proj>
+			safe_iterator_t<R> operator()(R&& r, Comp comp = {}, Proj proj = {}) const {
+				return (*this)(begin(r), end(r), static_cast<Comp&&>(comp),
+					static_cast<Proj&&>(proj));
+			}
+		};
+
+		inline constexpr __sort_by_cached_key_fn sort_by_cached_key{};
+
+		// The stable counterpart of sort_by_cached_key, falling back to
+		// stable_sort.
+		struct __stable_sort_by_cached_key_fn : private __niebloid {
+			template<random_access_iterator I, sentinel_for<I> S, class Comp = less,
+				class Proj = identity>
+			requires sortable<I, Comp, Proj> && detail::cacheable_key<I, Proj>
+			I operator()(I first, S sent, Comp comp = {}, Proj proj = {}) const {
+				auto last = next(first, static_cast<S&&>(sent));
+				const auto n = distance(first, last);
+				if (n > 1 && !detail::sort_by_cached_key<true>(first, n, comp, proj)) {
+					stable_sort(first, last, __stl2::ref(comp), __stl2::ref(proj));
+				}
+				return last;
+			}
+
+			template<random_access_range R, class Comp = less, class Proj = identity>
+			requires sortable<iterator_t<R>, Comp, Proj> &&
+				detail::cacheable_key<iterator_t<R>, Proj>
+			safe_iterator_t<R> operator()(R&& r, Comp comp = {}, Proj proj = {}) const {
+				return (*this)(begin(r), end(r), static_cast<Comp&&>(comp),
+					static_cast<Proj&&>(proj));
+			}
+		};
+
+		inline constexpr __stable_sort_by_cached_key_fn stable_sort_by_cached_key{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,116 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SORT_PERMUTATION_HPP
+#define STL2_DETAIL_ALGORITHM_SORT_PERMUTATION_HPP
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// sort_permutation [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class I, class O, class Comp, class Proj>
+		META_CONCEPT permutation_sortable = random_access_iterator<I> &&
+			random_access_iterator<O> && integral<iter_value_t<O>> && permutable<O> &&
+			indirect_strict_weak_order<Comp, projected<I, Proj>>;
+
+		// Writes the indices 0, 1, ..., last - first - 1 to out and sorts
+		// them by the elements of [first, last) they index.
+		template<bool Stable, class I, class S, class O, class C, class P>
+		constexpr __in_out_result<I, O>
+		sort_permutation(I first, S sent, O out, C& comp, P& proj) {
+			using V = iter_value_t<O>;
+			using D = iter_difference_t<I>;
+			auto last = next(first, static_cast<S&&>(sent));
+			const D n = last - first;
+			O o = out;
+			for (D i = 0; i < n; ++i, ++o) {
+				*o = static_cast<V>(i);
+			}
+			auto by_element = [&](const V a, const V b) -> bool {
+				return __stl2::invoke(comp,
+					__stl2::invoke(proj, *(first + static_cast<D>(a))),
+					__stl2::invoke(proj, *(first + static_cast<D>(b))));
+			};
+			if constexpr (Stable) {
+				stable_sort(out, o, by_element);
+			} else {
+				sort(out, o, by_element);
+			}
+			return {std::move(last), std::move(o)};
+		}
+	}
+
+	namespace ext {
+		template<class I, class O>
+		using sort_permutation_result = __in_out_result<I, O>;
+
+		// Writes to out the permutation that sorts [first, last) without
+		// moving any element: the index of the least element, then of the
+		// next, and so on. The indices are stored as iter_value_t<O>, which
+		// must be able to represent last - first - 1. Passing the result to
+		// apply_permutation sorts the range, or any other range of the same
+		// length in parallel with it; that needs an unsigned index type to
+		// represent 2 * (last - first) - 1, as it marks indices in place by
+		// complementing them.
+		struct __sort_permutation_fn : private __niebloid {
+			template<random_access_iterator I, sentinel_for<I> S, random_access_iterator O,
+				class Comp = less, class Proj = identity>
+			requires detail::permutation_sortable<I, O, Comp, Proj>
+			constexpr sort_permutation_result<I, O>
+			operator()(I first, S last, O out, Comp comp = {}, Proj proj = {}) const {
+				return detail::sort_permutation<false>(std::move(first), std::move(last),
+					std::move(out), comp, proj);
+			}
+
+			template<random_access_range R, random_access_iterator O, class Comp = less,
+				class Proj = identity>
+			requires detail::permutation_sortable<iterator_t<R>, O, Comp, Proj>
+			constexpr sort_permutation_result<safe_iterator_t<R>, O>
+			operator()(R&& r, O out, Comp comp = {}, Proj proj = {}) const {
+				return detail::sort_permutation<false>(begin(r), end(r), std::move(out),
+					comp, proj);
+			}
+		};
+
+		inline constexpr __sort_permutation_fn sort_permutation{};
+
+		// As sort_permutation, but equivalent elements keep their order.
+		struct __stable_sort_permutation_fn : private __niebloid {
+			template<random_access_iterator I, sentinel_for<I> S, random_access_iterator O,
+				class Comp = less, class Proj = identity>
+			requires detail::permutation_sortable<I, O, Comp, Proj>
+			sort_permutation_result<I, O>
+			operator()(I first, S last, O out, Comp comp = {}, Proj proj = {}) const {
+				return detail::sort_permutation<true>(std::move(first), std::move(last),
+					std::move(out), comp, proj);
+			}
+
+			template<random_access_range R, random_access_iterator O, class Comp = less,
+				class Proj = identity>
+			requires detail::permutation_sortable<iterator_t<R>, O, Comp, Proj>
+			sort_permutation_result<safe_iterator_t<R>, O>
+			operator()(R&& r, O out, Comp comp = {}, Proj proj = {}) const {
+				return detail::sort_permutation<true>(begin(r), end(r), std::move(out),
+					comp, proj);
+			}
+		};
+
+		inline constexpr __stable_sort_permutation_fn stable_sort_permutation{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
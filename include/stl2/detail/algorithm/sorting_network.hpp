@@ -0,0 +1,324 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SORTING_NETWORK_HPP
+#define STL2_DETAIL_ALGORITHM_SORTING_NETWORK_HPP
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <stl2/functional.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/algorithm/radix_sort.hpp>
+#include <stl2/detail/simd.hpp>
+#include <stl2/detail/concepts/fundamental.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Sorting networks for small arrays of scalars
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Contiguous ranges of arithmetic values sorted by value under less
+		// or greater, which sort can hand to sorting_network.
+		template<class I, class Comp, class Proj>
+		META_CONCEPT network_sortable = contiguous_iterator<I> &&
+			same_as<Proj, identity> && ext::Arithmetic<iter_value_t<I>> &&
+			ext::trivially_copyable<iter_value_t<I>> &&
+			same_as<iter_reference_t<I>, iter_value_t<I>&> &&
+			radix_order<Comp, iter_value_t<I>> != 0;
+
+		// Branch-free sorts of at most max_size scalars by Batcher's odd-even
+		// merge network for exactly n inputs, unrolled at compile time. More
+		// than 8 32-bit integers are instead padded to 16 or 32 lanes and
+		// bitonic sorted in vector registers, with SSE2 or AVX2 as the
+		// processor supports.
+		struct sorting_network {
+			static constexpr std::ptrdiff_t max_size = 32;
+
+			// Sorts [a, a + n) ascending if Order > 0, descending otherwise.
+			template<int Order, class T>
+			static void sort(T* const a, const std::ptrdiff_t n) noexcept {
+				STL2_EXPECT(0 <= n && n <= max_size);
+#if STL2_SIMD_X86
+				if constexpr (integral<T> && sizeof(T) == 4) {
+					if (n > 8) {
+						switch (simd::active_isa()) {
+						case simd::isa::avx512:
+						case simd::isa::avx2: bitonic_avx2<Order>(a, n); return;
+						case simd::isa::sse2: bitonic_sse2<Order>(a, n); return;
+						case simd::isa::scalar: break;
+						}
+					}
+				}
+#endif
+				constexpr auto table = make_table<Order, T>(
+					std::make_index_sequence<max_size + 1>{});
+				table[n](a);
+			}
+
+		private:
+			struct comparator {
+				unsigned char lo, hi;
+			};
+
+			// Batcher's odd-even merge network, generalized to any n: rounds of
+			// merges of sorted runs of p, comparing elements k apart within
+			// each run of 2p.
+			template<class F>
+			static constexpr void batcher(const int n, F f) {
+				for (int p = 1; p < n; p *= 2) {
+					for (int k = p; k >= 1; k /= 2) {
+						for (int j = k % p; j + k < n; j += 2 * k) {
+							for (int i = 0; i < k && i + j + k < n; ++i) {
+								if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+									f(i + j, i + j + k);
+								}
+							}
+						}
+					}
+				}
+			}
+
+			template<std::size_t N>
+			static constexpr std::size_t network_size() {
+				std::size_t size = 0;
+				batcher(int(N), [&](int, int) { ++size; });
+				return size;
+			}
+
+			template<std::size_t N>
+			static constexpr auto network() {
+				std::array<comparator, network_size<N>()> result{};
+				std::size_t i = 0;
+				batcher(int(N), [&](int lo, int hi) {
+					result[i++] = comparator{
+						static_cast<unsigned char>(lo), static_cast<unsigned char>(hi)};
+				});
+				return result;
+			}
+
+			// Orders a pair; floating-point values go through a conditional
+			// rather than min/max so that -0.0, +0.0 and NaNs are permuted,
+			// never duplicated.
+			template<int Order, class T>
+			static void exchange(T& a, T& b) noexcept {
+				const T x = a;
+				const T y = b;
+				if constexpr (integral<T>) {
+					a = Order > 0 ? (y < x ? y : x) : (x < y ? y : x);
+					b = Order > 0 ? (y < x ? x : y) : (x < y ? x : y);
+				} else {
+					const bool swap = Order > 0 ? y < x : x < y;
+					a = swap ? y : x;
+					b = swap ? x : y;
+				}
+			}
+
+			template<int Order, class T, std::size_t N, std::size_t... Is>
+			static void apply([[maybe_unused]] T* const a, std::index_sequence<Is...>) noexcept {
+				[[maybe_unused]] constexpr auto net = network<N>();
+				(exchange<Order>(a[net[Is].lo], a[net[Is].hi]), ...);
+			}
+
+			template<int Order, class T, std::size_t N>
+			static void fixed(T* const a) noexcept {
+				apply<Order, T, N>(a, std::make_index_sequence<network_size<N>()>{});
+			}
+
+			template<int Order, class T, std::size_t... Ns>
+			static constexpr auto make_table(std::index_sequence<Ns...>) {
+				using F = void (*)(T*) noexcept;
+				return std::array<F, sizeof...(Ns)>{{&fixed<Order, T, Ns>...}};
+			}
+
+#if STL2_SIMD_X86
+			// Pads [a, a + n) with the greatest value in the order to
+			// size lanes, which end up last; equal values of T are
+			// indistinguishable, so the padding is simply dropped.
+			template<int Order, class T>
+			static int pad(T* const buf, const T* const a, const std::ptrdiff_t n) noexcept {
+				constexpr T greatest = Order > 0 ? std::numeric_limits<T>::max()
+					: std::numeric_limits<T>::min();
+				const int size = n <= 16 ? 16 : 32;
+				for (std::ptrdiff_t i = 0; i < size; ++i) {
+					buf[i] = i < n ? a[i] : greatest;
+				}
+				return size;
+			}
+
+			// Copies the n least of the size sorted values back to a.
+			template<int Order, class T>
+			static void unpad(T* const a, const T* const buf, const std::ptrdiff_t n,
+				const int size) noexcept
+			{
+				if constexpr (Order > 0) {
+					for (std::ptrdiff_t i = 0; i < n; ++i) {
+						a[i] = buf[i];
+					}
+				} else {
+					// Sorted ascending; the padding is at the front.
+					for (std::ptrdiff_t i = 0; i < n; ++i) {
+						a[i] = buf[size - 1 - i];
+					}
+				}
+			}
+
+			// SSE2 has no 32-bit min and max, so compare, signed or with
+			// the sign bits flipped, and select.
+			template<class T>
+			STL2_TARGET_SSE2 static __m128i greater4(const __m128i x, const __m128i y) noexcept {
+				if constexpr (signed_integral<T>) {
+					return _mm_cmpgt_epi32(x, y);
+				} else {
+					const __m128i sign = _mm_set1_epi32(INT32_MIN);
+					return _mm_cmpgt_epi32(_mm_xor_si128(x, sign), _mm_xor_si128(y, sign));
+				}
+			}
+
+			STL2_TARGET_SSE2 static __m128i select4(const __m128i mask, const __m128i x,
+				const __m128i y) noexcept
+			{
+				return _mm_or_si128(_mm_and_si128(mask, x), _mm_andnot_si128(mask, y));
+			}
+
+			template<int Order, class T>
+			STL2_TARGET_SSE2 static void bitonic_sse2(T* const a, const std::ptrdiff_t n) noexcept {
+				alignas(16) T buf[max_size];
+				const int size = pad<Order>(buf, a, n);
+				const int regs = size / 4;
+				__m128i v[8];
+				for (int r = 0; r < regs; ++r) {
+					v[r] = _mm_load_si128(reinterpret_cast<const __m128i*>(buf + 4 * r));
+				}
+
+				// Lane i of v[r] holds element 4r + i. Each stage orders the
+				// pairs (g, g ^ j), ascending where g & k is zero.
+				const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+				const __m128i zero = _mm_setzero_si128();
+				for (int k = 2; k <= size; k *= 2) {
+					for (int j = k / 2; j > 0; j /= 2) {
+						if (j >= 4) {
+							const int d = j / 4;
+							for (int r = 0; r < regs; ++r) {
+								if ((r & d) != 0) continue;
+								const bool up = ((4 * r) & k) == 0;
+								const __m128i x = v[r], y = v[r + d];
+								const __m128i gt = greater4<T>(x, y);
+								const __m128i lo = select4(gt, y, x);
+								const __m128i hi = select4(gt, x, y);
+								v[r] = up ? lo : hi;
+								v[r + d] = up ? hi : lo;
+							}
+							continue;
+						}
+						const __m128i lower = _mm_cmpeq_epi32(
+							_mm_and_si128(lane, _mm_set1_epi32(j)), zero);
+						for (int r = 0; r < regs; ++r) {
+							const __m128i x = v[r];
+							const __m128i y = j == 2
+								? _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2))
+								: _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+							const __m128i index = _mm_add_epi32(lane, _mm_set1_epi32(4 * r));
+							const __m128i up = _mm_cmpeq_epi32(
+								_mm_and_si128(index, _mm_set1_epi32(k)), zero);
+							const __m128i take_max = _mm_xor_si128(lower, up);
+							const __m128i gt = greater4<T>(x, y);
+							v[r] = select4(take_max, select4(gt, x, y), select4(gt, y, x));
+						}
+					}
+				}
+
+				for (int r = 0; r < regs; ++r) {
+					_mm_store_si128(reinterpret_cast<__m128i*>(buf + 4 * r), v[r]);
+				}
+				unpad<Order>(a, buf, n, size);
+			}
+
+			template<class T>
+			STL2_TARGET_AVX2 static __m256i min8(const __m256i x, const __m256i y) noexcept {
+				if constexpr (signed_integral<T>) {
+					return _mm256_min_epi32(x, y);
+				} else {
+					return _mm256_min_epu32(x, y);
+				}
+			}
+
+			template<class T>
+			STL2_TARGET_AVX2 static __m256i max8(const __m256i x, const __m256i y) noexcept {
+				if constexpr (signed_integral<T>) {
+					return _mm256_max_epi32(x, y);
+				} else {
+					return _mm256_max_epu32(x, y);
+				}
+			}
+
+			template<int Order, class T>
+			STL2_TARGET_AVX2 static void bitonic_avx2(T* const a, const std::ptrdiff_t n) noexcept {
+				alignas(32) T buf[max_size];
+				const int size = pad<Order>(buf, a, n);
+				const int regs = size / 8;
+				__m256i v[4];
+				for (int r = 0; r < regs; ++r) {
+					v[r] = _mm256_load_si256(reinterpret_cast<const __m256i*>(buf + 8 * r));
+				}
+
+				// As bitonic_sse2, eight lanes to a register.
+				const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+				const __m256i zero = _mm256_setzero_si256();
+				for (int k = 2; k <= size; k *= 2) {
+					for (int j = k / 2; j > 0; j /= 2) {
+						if (j >= 8) {
+							const int d = j / 8;
+							for (int r = 0; r < regs; ++r) {
+								if ((r & d) != 0) continue;
+								const bool up = ((8 * r) & k) == 0;
+								const __m256i lo = min8<T>(v[r], v[r + d]);
+								const __m256i hi = max8<T>(v[r], v[r + d]);
+								v[r] = up ? lo : hi;
+								v[r + d] = up ? hi : lo;
+							}
+							continue;
+						}
+						const __m256i lower = _mm256_cmpeq_epi32(
+							_mm256_and_si256(lane, _mm256_set1_epi32(j)), zero);
+						for (int r = 0; r < regs; ++r) {
+							const __m256i x = v[r];
+							__m256i y;
+							if (j == 4) {
+								y = _mm256_permute2x128_si256(x, x, 1);
+							} else if (j == 2) {
+								y = _mm256_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+							} else {
+								y = _mm256_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1));
+							}
+							const __m256i index = _mm256_add_epi32(lane, _mm256_set1_epi32(8 * r));
+							const __m256i up = _mm256_cmpeq_epi32(
+								_mm256_and_si256(index, _mm256_set1_epi32(k)), zero);
+							const __m256i take_max = _mm256_xor_si256(lower, up);
+							v[r] = _mm256_blendv_epi8(min8<T>(x, y), max8<T>(x, y), take_max);
+						}
+					}
+				}
+
+				for (int r = 0; r < regs; ++r) {
+					_mm256_store_si256(reinterpret_cast<__m256i*>(buf + 8 * r), v[r]);
+				}
+				unpad<Order>(a, buf, n, size);
+			}
+#endif
+		};
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
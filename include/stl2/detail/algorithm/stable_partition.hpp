@@ -20,11 +20,15 @@
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/iterator/insert_iterators.hpp>
 #include <stl2/detail/iterator/move_iterator.hpp>
+#include <stl2/detail/memory/relocate.hpp>
 #include <stl2/view/subrange.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // stable_partition [alg.partitions]
 //
+// Elements better relocated than moved, such as std::unique_ptrs, are
+// relocated to the buffer and back by copying their bytes.
+//
 STL2_OPEN_NAMESPACE {
 	namespace ext {
 		struct __stable_partition_n_fn : private __niebloid {
@@ -105,16 +109,50 @@ STL2_OPEN_NAMESPACE {
 				STL2_EXPECT(n >= 2);
 				STL2_EXPECT(n <= buf.size());
 
-				auto&& vec = detail::make_temporary_vector(buf);
-				vec.push_back(iter_move(first));
-				auto counted = counted_iterator{ext::uncounted(next), n - 1};
-				auto pp = partition_copy(
-						__stl2::make_move_iterator(std::move(counted)),
-						move_sentinel<default_sentinel_t>{},
-						std::move(first), __stl2::back_inserter(vec),
-						__stl2::ref(pred), __stl2::ref(proj)).out1;
-				auto last = move(vec, pp).out;
-				return {std::move(pp), std::move(last)};
+				if constexpr (detail::byte_relocatable<I>) {
+					iter_value_t<I>* falses = buf.data();
+					iter_difference_t<I> held = 0;
+					I out = first;
+					I pp;
+					{
+						detail::relocate_on_exit rest{falses, held, out};
+						detail::relocate_bytes(falses[held++], *first);
+						for (--n; n != 0; --n, ++next) {
+							relocate_partitioned(next, falses, held, out, pred, proj);
+						}
+						pp = out;
+					}
+					return {std::move(pp), std::move(out)};
+				} else {
+					auto&& vec = detail::make_temporary_vector(buf);
+					vec.push_back(iter_move(first));
+					auto counted = counted_iterator{ext::uncounted(next), n - 1};
+					auto pp = partition_copy(
+							__stl2::make_move_iterator(std::move(counted)),
+							move_sentinel<default_sentinel_t>{},
+							std::move(first), __stl2::back_inserter(vec),
+							__stl2::ref(pred), __stl2::ref(proj)).out1;
+					auto last = move(vec, pp).out;
+					return {std::move(pp), std::move(last)};
+				}
+			}
+
+			// Relocates the element i to the hole at out if it satisfies pred,
+			// else to the buffer after the held elements there. The holes
+			// before i are as many as the elements held, which fill them
+			// however the partition ends.
+			template<forward_iterator I, class Proj,
+				indirect_unary_predicate<projected<I, Proj>> Pred>
+			static void relocate_partitioned(const I& i, iter_value_t<I>* const falses,
+				iter_difference_t<I>& held, I& out, Pred& pred, Proj& proj)
+			{
+				if (__stl2::invoke(pred, __stl2::invoke(proj, *i))) {
+					detail::relocate_bytes(*out, *i);
+					++out;
+				} else {
+					detail::relocate_bytes(falses[held], *i);
+					++held;
+				}
 			}
 
 			template<permutable I, class Proj,
@@ -186,22 +224,39 @@ STL2_OPEN_NAMESPACE {
 				STL2_EXPECT(n >= 2);
 				STL2_EXPECT(n <= buf.size());
 
-				// Move the false values into the temporary buffer
-				// and the true values to the front of the sequence.
-				auto&& vec = detail::make_temporary_vector(buf);
-				vec.push_back(iter_move(first));
-				auto middle = next(first);
-				middle = partition_copy(
-					__stl2::make_move_iterator(std::move(middle)),
-					__stl2::make_move_iterator(last),
-					std::move(first),
-					__stl2::back_inserter(vec),
-					__stl2::ref(pred),
-					__stl2::ref(proj)).out1;
-				*middle = iter_move(last);
-				++middle;
-				move(vec, middle);
-				return middle;
+				if constexpr (detail::byte_relocatable<I>) {
+					iter_value_t<I>* falses = buf.data();
+					iter_difference_t<I> held = 0;
+					I out = first;
+					I middle;
+					{
+						detail::relocate_on_exit rest{falses, held, out};
+						detail::relocate_bytes(falses[held++], *first);
+						for (++first; first != last; ++first) {
+							relocate_partitioned(first, falses, held, out, pred, proj);
+						}
+						detail::relocate_bytes(*out, *last);
+						middle = ++out;
+					}
+					return middle;
+				} else {
+					// Move the false values into the temporary buffer
+					// and the true values to the front of the sequence.
+					auto&& vec = detail::make_temporary_vector(buf);
+					vec.push_back(iter_move(first));
+					auto middle = next(first);
+					middle = partition_copy(
+						__stl2::make_move_iterator(std::move(middle)),
+						__stl2::make_move_iterator(last),
+						std::move(first),
+						__stl2::back_inserter(vec),
+						__stl2::ref(pred),
+						__stl2::ref(proj)).out1;
+					*middle = iter_move(last);
+					++middle;
+					move(vec, middle);
+					return middle;
+				}
 			}
 
 			template<bidirectional_iterator I, class Proj,
@@ -35,18 +35,34 @@
 #ifndef STL2_DETAIL_ALGORITHM_STABLE_SORT_HPP
 #define STL2_DETAIL_ALGORITHM_STABLE_SORT_HPP
 
+#include <vector>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/algorithm/inplace_merge.hpp>
 #include <stl2/detail/algorithm/merge.hpp>
 #include <stl2/detail/algorithm/min.hpp>
+#include <stl2/detail/algorithm/powersort.hpp>
 #include <stl2/detail/algorithm/sort.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/iterator/insert_iterators.hpp>
 #include <stl2/detail/iterator/move_iterator.hpp>
+#include <stl2/detail/memory/relocate.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // stable_sort [stable.sort]
 //
+// When the whole range fits in the buffer, existing order is exploited:
+// runs already in order are kept and merged by powersort, and only the
+// stretches between them are merge sorted.
+//
+// With ext::par, chunks of the range are sorted concurrently, each with its
+// own slice of the buffer, and then merged pairwise in parallel; each
+// round of merges is divided evenly between the threads by merge path
+// partitioning (Odeh, Green, Mwassi, Shmueli and Birk).
+//
+// Elements better relocated than moved, such as std::unique_ptrs, are
+// relocated between the range and the buffer by copying their bytes.
+//
 STL2_OPEN_NAMESPACE {
 	struct __stable_sort_fn : private __niebloid {
 		template<random_access_iterator I, class S, class Comp = less, class Proj = identity>
@@ -55,10 +71,12 @@ STL2_OPEN_NAMESPACE {
 			auto last = next(first, static_cast<S&&>(last_));
 			auto len = iter_difference_t<I>(last - first);
 			auto buf = len > 256 ? buf_t<I>{len} : buf_t<I>{};
-			if (!buf.size()) {
-				inplace_stable_sort(first, last, comp, proj);
-			} else {
+			if (buf.size() >= len) {
+				natural_merge_sort(first, last, buf.data(), comp, proj);
+			} else if (buf.size()) {
 				stable_sort_adaptive(first, last, buf, comp, proj);
+			} else {
+				inplace_stable_sort(first, last, comp, proj);
 			}
 			return last;
 		}
@@ -68,11 +86,43 @@ STL2_OPEN_NAMESPACE {
 		safe_iterator_t<R> operator()(R&& r, Comp comp = {}, Proj proj = {}) const {
 			return (*this)(begin(r), end(r), static_cast<Comp&&>(comp), static_cast<Proj&&>(proj));
 		}
+
+		template<class EP, random_access_iterator I, class S, class Comp = less,
+			class Proj = identity>
+		requires ext::execution_policy<EP> && sentinel_for<__f<S>, I> &&
+			sortable<I, Comp, Proj>
+		I operator()(EP&& policy, I first, S&& last_, Comp comp = {}, Proj proj = {}) const {
+			auto last = next(first, static_cast<S&&>(last_));
+			if constexpr (same_as<__uncvref<EP>, ext::parallel_policy>) {
+				auto len = static_cast<std::ptrdiff_t>(last - first);
+				auto threads = policy.concurrency();
+				if (static_cast<std::ptrdiff_t>(threads) > len / min_parallel_chunk) {
+					threads = static_cast<unsigned>(len / min_parallel_chunk);
+				}
+				if (threads >= 2) {
+					auto buf = buf_t<I>{len};
+					if (buf.size() >= len) {
+						parallel_merge_sort(first, len, buf.data(), threads, comp, proj);
+						return last;
+					}
+				}
+			}
+			return (*this)(first, last, static_cast<Comp&&>(comp), static_cast<Proj&&>(proj));
+		}
+
+		template<class EP, random_access_range R, class Comp = less, class Proj = identity>
+		requires ext::execution_policy<EP> && sortable<iterator_t<R>, Comp, Proj>
+		safe_iterator_t<R> operator()(EP&& policy, R&& r, Comp comp = {}, Proj proj = {}) const {
+			return (*this)(static_cast<EP&&>(policy), begin(r), end(r),
+				static_cast<Comp&&>(comp), static_cast<Proj&&>(proj));
+		}
 	private:
 		template<class I>
 		using buf_t = detail::temporary_buffer<iter_value_t<I>>;
 
 		static constexpr int merge_sort_chunk_size = 7;
+		// The parallel sort gives each thread at least this many elements.
+		static constexpr std::ptrdiff_t min_parallel_chunk = std::ptrdiff_t{1} << 14;
 
 		template<random_access_iterator I, class C, class P>
 		requires sortable<I, C, P>
@@ -127,27 +177,119 @@ STL2_OPEN_NAMESPACE {
 
 		template<random_access_iterator I, class C, class P>
 		requires sortable<I, C, P>
-		static void merge_sort_with_buffer(I first, I last, buf_t<I>& buf, C &comp, P &proj) {
+		static void merge_sort_with_buffer(I first, I last, iter_value_t<I>* buf,
+			C &comp, P &proj)
+		{
+			// Pre: buf has room for last - first elements.
 			auto len = iter_difference_t<I>(last - first);
 			auto step_size = iter_difference_t<I>(merge_sort_chunk_size);
 			chunk_insertion_sort(first, last, step_size, comp, proj);
 			if (step_size >= len) {
 				return;
 			}
-			detail::temporary_vector<iter_value_t<I>> vec{buf};
-			merge_sort_loop(first, last, __stl2::back_inserter(vec), step_size, comp, proj);
-			step_size *= 2;
-			while (true) {
-				merge_sort_loop(vec.begin(), vec.end(), first, step_size, comp, proj);
+			if constexpr (detail::byte_relocatable<I>) {
+				relocate_merge_passes(first, len, buf, step_size, comp, proj);
+			} else {
+				detail::temporary_vector<iter_value_t<I>> vec{buf, static_cast<std::ptrdiff_t>(len)};
+				merge_sort_loop(first, last, __stl2::back_inserter(vec), step_size, comp, proj);
 				step_size *= 2;
-				if (step_size >= len) {
-					return;
+				while (true) {
+					merge_sort_loop(vec.begin(), vec.end(), first, step_size, comp, proj);
+					step_size *= 2;
+					if (step_size >= len) {
+						return;
+					}
+					merge_sort_loop(first, last, vec.begin(), step_size, comp, proj);
+					step_size *= 2;
 				}
-				merge_sort_loop(first, last, vec.begin(), step_size, comp, proj);
-				step_size *= 2;
 			}
 		}
 
+		// The passes of merge_sort_with_buffer, for elements relocated rather
+		// than moved: each pass relocates them from the range to the buffer
+		// or back, merging runs of step_size. However the passes end, the
+		// elements are left in the range.
+		template<random_access_iterator I, class C, class P>
+		static void relocate_merge_passes(I first, const iter_difference_t<I> len,
+			iter_value_t<I>* const buf, iter_difference_t<I> step_size, C& comp, P& proj)
+		{
+			using D = iter_difference_t<I>;
+			// Whether the pass under way relocates from the buffer, and how
+			// many elements it has placed in the range or buffer it fills.
+			bool from_buf = false;
+			D done = 0;
+			struct reunite {
+				I first;
+				iter_value_t<I>* buf;
+				D len;
+				bool& from_buf;
+				D& done;
+
+				~reunite() {
+					if (from_buf) {
+						ext::uninitialized_relocate_n(buf + done, len - done, first + done);
+					} else {
+						ext::uninitialized_relocate_n(buf, done, first);
+					}
+				}
+			} guard{first, buf, len, from_buf, done};
+			for (; step_size < len; step_size *= 2) {
+				if (from_buf) {
+					relocate_merge_pass(buf, first, len, step_size, done, comp, proj);
+				} else {
+					relocate_merge_pass(first, buf, len, step_size, done, comp, proj);
+				}
+				from_buf = !from_buf;
+				done = 0;
+			}
+		}
+
+		// Relocates the runs of step_size from src, merged pairwise, to the
+		// storage from dst. done is the end of the pairs that are, or will
+		// be however the pass ends, all in dst.
+		template<class Src, class Dst, class D, class C, class P>
+		static void relocate_merge_pass(const Src src, const Dst dst, const D len,
+			const D step_size, D& done, C& comp, P& proj)
+		{
+			for (D lo = 0; lo < len; lo = done) {
+				const D mid = min(D(lo + step_size), len);
+				done = min(D(mid + step_size), len);
+				Src a = src + lo;
+				Src b = src + mid;
+				D na = mid - lo;
+				D nb = done - mid;
+				Dst out = dst + lo;
+				detail::relocate_on_exit rest_a{a, na, out};
+				detail::relocate_on_exit rest_b{b, nb, out};
+				for (; na != 0 && nb != 0; ++out) {
+					if (__stl2::invoke(comp, __stl2::invoke(proj, *b),
+						__stl2::invoke(proj, *a)))
+					{
+						detail::relocate_bytes(*out, *b);
+						++b;
+						--nb;
+					} else {
+						detail::relocate_bytes(*out, *a);
+						++a;
+						--na;
+					}
+				}
+			}
+		}
+
+		// Pre: buf has room for last - first elements.
+		template<random_access_iterator I, class C, class P>
+		requires sortable<I, C, P>
+		static void natural_merge_sort(I first, I last, iter_value_t<I>* buf,
+			C &comp, P &proj)
+		{
+			auto sort_stretch = [&](I f, I l) {
+				merge_sort_with_buffer(f, l, buf, comp, proj);
+			};
+			detail::powersort::sort(first, iter_difference_t<I>(last - first), buf,
+				comp, proj, sort_stretch);
+		}
+
 		template<random_access_iterator I, class C, class P>
 		requires sortable<I, C, P>
 		static void stable_sort_adaptive(I first, I last, buf_t<I>& buf, C &comp, P &proj) {
@@ -157,13 +299,139 @@ STL2_OPEN_NAMESPACE {
 				stable_sort_adaptive(first, middle, buf, comp, proj);
 				stable_sort_adaptive(middle, last, buf, comp, proj);
 			} else {
-				merge_sort_with_buffer(first, middle, buf, comp, proj);
-				merge_sort_with_buffer(middle, last, buf, comp, proj);
+				merge_sort_with_buffer(first, middle, buf.data(), comp, proj);
+				merge_sort_with_buffer(middle, last, buf.data(), comp, proj);
 			}
 			detail::merge_adaptive(first, middle, last,
 				middle - first, last - middle, buf,
 				__stl2::ref(comp), __stl2::ref(proj));
 		}
+
+		template<class It>
+		static It at(It it, std::ptrdiff_t n) {
+			return it + static_cast<iter_difference_t<It>>(n);
+		}
+
+		// The number of elements of [a, a + na) among the first d elements of
+		// the stable merge of [a, a + na) and [b, b + nb).
+		template<random_access_iterator It, class C, class P>
+		static std::ptrdiff_t merge_path(It a, std::ptrdiff_t na, It b, std::ptrdiff_t nb,
+			std::ptrdiff_t d, C& comp, P& proj)
+		{
+			auto lo = d > nb ? d - nb : 0;
+			auto hi = d < na ? d : na;
+			while (lo < hi) {
+				auto mid = lo + (hi - lo) / 2;
+				if (__stl2::invoke(comp, __stl2::invoke(proj, *at(b, d - mid - 1)),
+					__stl2::invoke(proj, *at(a, mid))))
+				{
+					hi = mid;
+				} else {
+					lo = mid + 1;
+				}
+			}
+			return lo;
+		}
+
+		// Merges adjacent pairs of the sorted runs of src delimited by runs
+		// into dst; thread t produces elements [len * t / threads,
+		// len * (t + 1) / threads) of the output. The merge paths are found
+		// before any element is moved.
+		template<random_access_iterator Src, random_access_iterator Dst, class C, class P>
+		static void merge_pass(Src src, Dst dst, const std::vector<std::ptrdiff_t>& runs,
+			std::ptrdiff_t len, unsigned threads, C& comp, P& proj)
+		{
+			// splits[t]: elements of the first run of the pair containing
+			// output position len * t / threads that precede that position.
+			std::vector<std::ptrdiff_t> splits(threads + 1);
+			for (unsigned t = 0, r = 0; t < threads; ++t) {
+				const auto x = len * t / threads;
+				while (r + 2 < runs.size() && runs[r + 2] <= x) {
+					r += 2;
+				}
+				const auto a0 = runs[r];
+				const auto a1 = runs[r + 1];
+				const auto b1 = r + 2 < runs.size() ? runs[r + 2] : a1;
+				splits[t] = merge_path(at(src, a0), a1 - a0, at(src, a1), b1 - a1,
+					x - a0, comp, proj);
+			}
+
+			detail::fork_join(threads, [&](unsigned t) noexcept {
+				C c = comp;
+				P p = proj;
+				const auto out_lo = len * t / threads;
+				const auto out_hi = len * (t + 1) / threads;
+				for (std::size_t r = 0; r + 1 < runs.size(); r += 2) {
+					const auto a0 = runs[r];
+					const auto a1 = runs[r + 1];
+					const auto b1 = r + 2 < runs.size() ? runs[r + 2] : a1;
+					if (b1 <= out_lo || a0 >= out_hi) continue;
+					const auto lo = out_lo > a0 ? out_lo - a0 : 0;
+					const auto hi = out_hi < b1 ? out_hi - a0 : b1 - a0;
+					const auto i_lo = out_lo > a0 ? splits[t] : 0;
+					const auto i_hi = out_hi < b1 ? splits[t + 1] : a1 - a0;
+					merge(
+						__stl2::make_move_iterator(at(src, a0 + i_lo)),
+						__stl2::make_move_iterator(at(src, a0 + i_hi)),
+						__stl2::make_move_iterator(at(src, a1 + (lo - i_lo))),
+						__stl2::make_move_iterator(at(src, a1 + (hi - i_hi))),
+						at(dst, a0 + lo), __stl2::ref(c),
+						__stl2::ref(p), __stl2::ref(p));
+				}
+			});
+		}
+
+		// Pre: buf has room for len elements.
+		template<random_access_iterator I, class C, class P>
+		requires sortable<I, C, P>
+		static void parallel_merge_sort(I first, std::ptrdiff_t len, iter_value_t<I>* buf,
+			unsigned threads, C& comp, P& proj)
+		{
+			std::vector<std::ptrdiff_t> runs(threads + 1);
+			for (unsigned t = 0; t <= threads; ++t) {
+				runs[t] = len * t / threads;
+			}
+
+			// Sort a chunk per thread, then move it into the buffer, which
+			// thereafter holds live elements.
+			detail::fork_join(threads, [&](unsigned t) noexcept {
+				C c = comp;
+				P p = proj;
+				const auto lo = runs[t];
+				const auto hi = runs[t + 1];
+				natural_merge_sort(at(first, lo), at(first, hi), buf + lo, c, p);
+				for (auto i = lo; i < hi; ++i) {
+					detail::construct(buf[i], iter_move(at(first, i)));
+				}
+			});
+
+			bool in_buf = true;
+			while (runs.size() > 2) {
+				if (in_buf) {
+					merge_pass(buf, first, runs, len, threads, comp, proj);
+				} else {
+					merge_pass(first, buf, runs, len, threads, comp, proj);
+				}
+				in_buf = !in_buf;
+				std::size_t n = 0;
+				for (std::size_t r = 0; r < runs.size(); r += 2) {
+					runs[n++] = runs[r];
+				}
+				if (runs[n - 1] != len) {
+					runs[n++] = len;
+				}
+				runs.resize(n);
+			}
+
+			detail::fork_join(threads, [&](unsigned t) noexcept {
+				for (auto i = len * t / threads, hi = len * (t + 1) / threads; i < hi; ++i) {
+					if (in_buf) {
+						*at(first, i) = std::move(buf[i]);
+					}
+					detail::destruct(buf[i]);
+				}
+			});
+		}
 	};
 
 	inline constexpr __stable_sort_fn stable_sort{};
@@ -0,0 +1,115 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_TOP_K_HPP
+#define STL2_DETAIL_ALGORITHM_TOP_K_HPP
+
+#include <cstdint>
+#include <new>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/nth_element.hpp>
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// top_k [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class I, class O>
+		using top_k_result = __in_out_result<I, O>;
+
+		// Writes the k elements of a single pass over [first, last) that come
+		// first under comp - the k least under less, the k greatest under
+		// greater - to out in that order, or all of them if there are fewer.
+		// Which of several equivalent elements are kept is unspecified.
+		//
+		// Candidates collect in a buffer of 2k elements; whenever it fills,
+		// nth_element keeps the best k, and the worst of those becomes the
+		// bar later elements must beat to be copied at all. This takes O(n +
+		// k log k) time on average and O(k) space however long the input.
+		// Throws std::bad_alloc if k + 1 elements cannot be buffered.
+		struct __top_k_fn : private __niebloid {
+			template<input_iterator I, sentinel_for<I> S, weakly_incrementable O,
+				class Comp = less, class Proj = identity>
+			requires constructible_from<iter_value_t<I>, iter_reference_t<I>> &&
+				sortable<iter_value_t<I>*, Comp, Proj> &&
+				indirect_strict_weak_order<Comp, projected<I, Proj>,
+					projected<iter_value_t<I>*, Proj>> &&
+				indirectly_movable<iter_value_t<I>*, O>
+			top_k_result<I, O> operator()(I first, S last, O out, iter_difference_t<I> k,
+				Comp comp = {}, Proj proj = {}) const
+			{
+				using V = iter_value_t<I>;
+				if (k <= 0) {
+					return {next(std::move(first), std::move(last)), std::move(out)};
+				}
+
+				const std::ptrdiff_t keep = static_cast<std::ptrdiff_t>(k);
+				detail::temporary_buffer<V> buf{keep <= PTRDIFF_MAX / 2 ? 2 * keep : keep};
+				if (buf.size() <= keep) {
+					throw std::bad_alloc{};
+				}
+				detail::temporary_vector<V> vec{buf};
+
+				auto select = [&] {
+					nth_element(vec.begin(), vec.begin() + (keep - 1), vec.end(),
+						__stl2::ref(comp), __stl2::ref(proj));
+					while (vec.size() > keep) {
+						vec.pop_back();
+					}
+				};
+
+				bool bounded = false;
+				for (; first != last; ++first) {
+					iter_reference_t<I>&& x = *first;
+					if (bounded && !__stl2::invoke(comp, __stl2::invoke(proj, x),
+						__stl2::invoke(proj, vec[keep - 1])))
+					{
+						continue;
+					}
+					vec.emplace_back(std::forward<iter_reference_t<I>>(x));
+					if (vec.size() == vec.capacity()) {
+						select();
+						bounded = true;
+					}
+				}
+				if (vec.size() > keep) {
+					select();
+				}
+
+				sort(vec.begin(), vec.end(), __stl2::ref(comp), __stl2::ref(proj));
+				auto result = move(vec.begin(), vec.end(), std::move(out));
+				return {std::move(first), std::move(result.out)};
+			}
+
+			template<input_range R, weakly_incrementable O, class Comp = less,
+				class Proj = identity>
+			requires constructible_from<range_value_t<R>, range_reference_t<R>> &&
+				sortable<range_value_t<R>*, Comp, Proj> &&
+				indirect_strict_weak_order<Comp, projected<iterator_t<R>, Proj>,
+					projected<range_value_t<R>*, Proj>> &&
+				indirectly_movable<range_value_t<R>*, O>
+			top_k_result<safe_iterator_t<R>, O> operator()(R&& r, O out,
+				range_difference_t<R> k, Comp comp = {}, Proj proj = {}) const
+			{
+				return (*this)(begin(r), end(r), std::move(out), k,
+					__stl2::ref(comp), __stl2::ref(proj));
+			}
+		};
+
+		inline constexpr __top_k_fn top_k{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
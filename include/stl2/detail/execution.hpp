@@ -0,0 +1,77 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_EXECUTION_HPP
+#define STL2_DETAIL_EXECUTION_HPP
+
+#include <thread>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Execution policies [Extension]
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		// Algorithms invoked with seq behave exactly as the overloads that
+		// take no policy.
+		struct sequenced_policy {};
+
+		// Permits an algorithm to run on up to `threads` threads; 0 means
+		// std::thread::hardware_concurrency(). As with the standard parallel
+		// algorithms, an exception that escapes a user-provided function
+		// object calls std::terminate.
+		struct parallel_policy {
+			unsigned threads = 0;
+
+			constexpr parallel_policy on(unsigned n) const noexcept {
+				return parallel_policy{n};
+			}
+
+			unsigned concurrency() const noexcept {
+				if (threads != 0) return threads;
+				const unsigned n = std::thread::hardware_concurrency();
+				return n != 0 ? n : 1;
+			}
+		};
+
+		inline constexpr sequenced_policy seq{};
+		inline constexpr parallel_policy par{};
+
+		template<class T>
+		inline constexpr bool is_execution_policy_v = false;
+		template<>
+		inline constexpr bool is_execution_policy_v<sequenced_policy> = true;
+		template<>
+		inline constexpr bool is_execution_policy_v<parallel_policy> = true;
+
+		template<class T>
+		META_CONCEPT execution_policy = is_execution_policy_v<__uncvref<T>>;
+	} // namespace ext
+
+	namespace detail {
+		// Calls f(0), ..., f(n - 1) concurrently - f(0) on the calling
+		// thread - and returns when every call has returned.
+		template<class F>
+		void fork_join(const unsigned n, F&& f) noexcept {
+			std::vector<std::thread> workers;
+			workers.reserve(n > 0 ? n - 1 : 0);
+			for (unsigned t = 1; t < n; ++t) {
+				workers.emplace_back([&f, t] { f(t); });
+			}
+			f(0u);
+			for (auto& w : workers) {
+				w.join();
+			}
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
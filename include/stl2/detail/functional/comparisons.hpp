@@ -91,6 +91,41 @@ STL2_OPEN_NAMESPACE {
 
 		using is_transparent = std::true_type;
 	};
+
+	///////////////////////////////////////////////////////////////////////////
+	// equal_to_value, not_equal_to_value [Extension]
+	//
+	namespace ext {
+		// Unary predicates comparing their argument with a stored value.
+		// Unlike an equivalent lambda, they are recognizable: find_if,
+		// find_if_not, all_of, any_of and none_of search contiguous ranges
+		// of integers for them with vector instructions, as find does.
+		template<class T>
+		struct equal_to_value {
+			T value;
+
+			template<equality_comparable_with<const T&> U>
+			constexpr bool operator()(const U& u) const {
+				return static_cast<bool>(u == value);
+			}
+		};
+
+		template<class T>
+		equal_to_value(T) -> equal_to_value<T>;
+
+		template<class T>
+		struct not_equal_to_value {
+			T value;
+
+			template<equality_comparable_with<const T&> U>
+			constexpr bool operator()(const U& u) const {
+				return static_cast<bool>(u != value);
+			}
+		};
+
+		template<class T>
+		not_equal_to_value(T) -> not_equal_to_value<T>;
+	} // namespace ext
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -282,6 +282,22 @@ STL2_OPEN_NAMESPACE {
 		inline constexpr priority_tag<4> max_priority_tag{};
 	}
 
+	namespace detail {
+		// Whether the call occurs within the evaluation of a constant
+		// expression. Fast paths that rely on non-constexpr facilities (the
+		// C library, allocation, intrinsics) test this; when it cannot be
+		// determined we conservatively report true.
+		constexpr bool is_constant_evaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+			return std::is_constant_evaluated();
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || defined(__clang__)
+			return __builtin_is_constant_evaluated();
+#else
+			return true;
+#endif
+		}
+	}
+
 	struct __niebloid {
 		explicit __niebloid() = default;
 		__niebloid(const __niebloid&) = delete;
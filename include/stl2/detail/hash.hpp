@@ -15,6 +15,7 @@
 #include <cstddef>
 #include <functional>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/core.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // Hash machinery.
@@ -28,7 +29,7 @@ STL2_OPEN_NAMESPACE {
 		template<class T>
 		META_CONCEPT Hashable = requires(const T& e) {
 			typename std::hash<T>;
-			{ std::hash<T>{}(e) } -> std::size_t;
+			{ std::hash<T>{}(e) } -> same_as<std::size_t>;
 		};
 	}
 
@@ -0,0 +1,552 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_INPLACE_VECTOR_HPP
+#define STL2_DETAIL_INPLACE_VECTOR_HPP
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/copy_n.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/algorithm/fill.hpp>
+#include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <stl2/detail/algorithm/move.hpp>
+#include <stl2/detail/algorithm/rotate.hpp>
+#include <stl2/detail/algorithm/swap_ranges.hpp>
+#include <stl2/detail/memory/construct_at.hpp>
+#include <stl2/detail/memory/destroy.hpp>
+#include <stl2/detail/memory/relocate.hpp>
+#include <stl2/detail/memory/uninitialized_copy.hpp>
+#include <stl2/detail/memory/uninitialized_fill.hpp>
+#include <stl2/detail/memory/uninitialized_move.hpp>
+#include <stl2/detail/memory/uninitialized_value_construct.hpp>
+
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Uninitialized storage for N Ts, within the object.
+		template<class T, std::size_t N>
+		struct inline_storage {
+			alignas(T) unsigned char bytes_[N * sizeof(T)];
+
+			T* data() noexcept {
+				return reinterpret_cast<T*>(bytes_);
+			}
+			const T* data() const noexcept {
+				return reinterpret_cast<const T*>(bytes_);
+			}
+		};
+
+		template<class T>
+		struct inline_storage<T, 0> {
+			T* data() const noexcept {
+				return nullptr;
+			}
+		};
+
+		// Moves the n elements from first to the storage from out, ending
+		// their lifetimes: by copying their bytes, if they are trivially
+		// relocatable.
+		template<class T>
+		void relocate_elements(T* const first, const std::size_t n, T* const out)
+		noexcept(std::is_nothrow_move_constructible_v<T> || ext::trivially_relocatable<T>)
+		{
+			const auto last = first + n;
+			if constexpr (ext::trivially_relocatable<T>) {
+				ext::uninitialized_relocate(first, last, out);
+			} else {
+				uninitialized_move(first, last, out, out + n);
+				destroy(first, last);
+			}
+		}
+
+		///////////////////////////////////////////////////////////////////////////
+		// vector_interface
+		//
+		// The members common to the vectors of the extensions, whose
+		// elements are the first size() of the storage from data(), which
+		// has room for capacity(). D provides those, and:
+		// * set_size_(n), to count the elements after they are constructed
+		//   or destroyed,
+		// * reserve_(n), to make room for n elements or throw, and
+		// * grow_emplace_back_(args...), to append an element constructed
+		//   from args when there is no room, or throw.
+		//
+		template<class D, class T>
+		class vector_interface {
+			D& derived() noexcept {
+				static_assert(derived_from<D, vector_interface>);
+				return static_cast<D&>(*this);
+			}
+			const D& derived() const noexcept {
+				static_assert(derived_from<D, vector_interface>);
+				return static_cast<const D&>(*this);
+			}
+
+			// Makes room for n elements, keeping x, which may be one of
+			// them, and returns it.
+			const T& reserve_keeping(const std::size_t n, const T& x) {
+				auto& d = derived();
+				const T* p = std::addressof(x);
+				if (std::less_equal<>{}(d.data(), p) && std::less<>{}(p, d.data() + d.size())) {
+					const auto i = p - d.data();
+					d.reserve_(n);
+					return d.data()[i];
+				}
+				d.reserve_(n);
+				return x;
+			}
+
+		public:
+			using value_type = T;
+			using size_type = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using reference = T&;
+			using const_reference = const T&;
+			using pointer = T*;
+			using const_pointer = const T*;
+			using iterator = T*;
+			using const_iterator = const T*;
+			using reverse_iterator = __stl2::reverse_iterator<iterator>;
+			using const_reverse_iterator = __stl2::reverse_iterator<const_iterator>;
+
+			iterator begin() noexcept { return derived().data(); }
+			iterator end() noexcept { return derived().data() + derived().size(); }
+			const_iterator begin() const noexcept { return derived().data(); }
+			const_iterator end() const noexcept { return derived().data() + derived().size(); }
+			const_iterator cbegin() const noexcept { return begin(); }
+			const_iterator cend() const noexcept { return end(); }
+			reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+			reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+			const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator{end()}; }
+			const_reverse_iterator rend() const noexcept { return const_reverse_iterator{begin()}; }
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+			bool empty() const noexcept {
+				return derived().size() == 0;
+			}
+
+			reference operator[](const size_type i) noexcept {
+				STL2_EXPECT(i < derived().size());
+				return begin()[i];
+			}
+			const_reference operator[](const size_type i) const noexcept {
+				STL2_EXPECT(i < derived().size());
+				return begin()[i];
+			}
+			reference at(const size_type i) {
+				if (i >= derived().size()) throw std::out_of_range{"vector index out of range"};
+				return begin()[i];
+			}
+			const_reference at(const size_type i) const {
+				if (i >= derived().size()) throw std::out_of_range{"vector index out of range"};
+				return begin()[i];
+			}
+			reference front() noexcept {
+				STL2_EXPECT(!empty());
+				return begin()[0];
+			}
+			const_reference front() const noexcept {
+				STL2_EXPECT(!empty());
+				return begin()[0];
+			}
+			reference back() noexcept {
+				STL2_EXPECT(!empty());
+				return end()[-1];
+			}
+			const_reference back() const noexcept {
+				STL2_EXPECT(!empty());
+				return end()[-1];
+			}
+
+			template<class... Args>
+			requires constructible_from<T, Args...>
+			reference emplace_back(Args&&... args) {
+				auto& d = derived();
+				const auto n = d.size();
+				if (n < d.capacity()) {
+					__stl2::__construct_at(d.data()[n], std::forward<Args>(args)...);
+					d.set_size_(n + 1);
+					return d.data()[n];
+				}
+				return d.grow_emplace_back_(std::forward<Args>(args)...);
+			}
+			void push_back(const T& x) requires copy_constructible<T> {
+				emplace_back(x);
+			}
+			void push_back(T&& x) requires move_constructible<T> {
+				emplace_back(std::move(x));
+			}
+			void pop_back() noexcept {
+				STL2_EXPECT(!empty());
+				auto& d = derived();
+				destroy_at(std::addressof(back()));
+				d.set_size_(d.size() - 1);
+			}
+
+			// Insertions append the elements, then rotate them into place.
+			template<class... Args>
+			requires constructible_from<T, Args...> && movable<T>
+			iterator emplace(const const_iterator pos, Args&&... args) {
+				const auto i = pos - cbegin();
+				emplace_back(std::forward<Args>(args)...);
+				const auto first = begin() + i;
+				__stl2::rotate(first, end() - 1, end());
+				return first;
+			}
+			iterator insert(const const_iterator pos, const T& x) requires copyable<T> {
+				return emplace(pos, x);
+			}
+			iterator insert(const const_iterator pos, T&& x) requires movable<T> {
+				return emplace(pos, std::move(x));
+			}
+			iterator insert(const const_iterator pos, const size_type n, const T& x)
+			requires copyable<T>
+			{
+				auto& d = derived();
+				const auto i = pos - cbegin();
+				const auto old = d.size();
+				const T& y = reserve_keeping(old + n, x);
+				uninitialized_fill_n(end(), static_cast<difference_type>(n), y);
+				d.set_size_(old + n);
+				const auto first = begin() + i;
+				__stl2::rotate(first, begin() + old, end());
+				return first;
+			}
+			template<input_iterator I, sentinel_for<I> S>
+			requires constructible_from<T, iter_reference_t<I>> && movable<T>
+			iterator insert(const const_iterator pos, I first, S last) {
+				auto& d = derived();
+				const auto i = pos - cbegin();
+				const auto old = d.size();
+				append(std::move(first), std::move(last));
+				const auto result = begin() + i;
+				__stl2::rotate(result, begin() + old, end());
+				return result;
+			}
+			iterator insert(const const_iterator pos, std::initializer_list<T> il)
+			requires copyable<T>
+			{
+				return insert(pos, il.begin(), il.end());
+			}
+
+			// Appends the elements of [first, last), or, if an exception
+			// escapes, none of them.
+			template<input_iterator I, sentinel_for<I> S>
+			requires constructible_from<T, iter_reference_t<I>>
+			void append(I first, S last) {
+				auto& d = derived();
+				const auto old = d.size();
+				if constexpr (forward_iterator<I>) {
+					const auto n = static_cast<size_type>(distance(first, last));
+					d.reserve_(old + n);
+					uninitialized_copy(std::move(first), std::move(last), end(), end() + n);
+					d.set_size_(old + n);
+				} else {
+					try {
+						for (; first != last; ++first) {
+							emplace_back(*first);
+						}
+					} catch (...) {
+						destroy(begin() + old, end());
+						d.set_size_(old);
+						throw;
+					}
+				}
+			}
+
+			iterator erase(const const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+				STL2_EXPECT(pos != cend());
+				return erase(pos, pos + 1);
+			}
+			iterator erase(const const_iterator first, const const_iterator last)
+			noexcept(std::is_nothrow_move_assignable_v<T>)
+			{
+				auto& d = derived();
+				const auto f = begin() + (first - cbegin());
+				const auto l = begin() + (last - cbegin());
+				if (f != l) {
+					const auto n = d.size() - static_cast<size_type>(l - f);
+					if constexpr (ext::trivially_relocatable<T>) {
+						destroy(f, l);
+						ext::uninitialized_relocate(l, end(), f);
+					} else {
+						destroy(__stl2::move(l, end(), f).out, end());
+					}
+					d.set_size_(n);
+				}
+				return f;
+			}
+
+			void clear() noexcept {
+				destroy(begin(), end());
+				derived().set_size_(0);
+			}
+
+			void resize(const size_type n) requires default_initializable<T> {
+				auto& d = derived();
+				if (n < d.size()) {
+					destroy(begin() + n, end());
+				} else if (n > d.size()) {
+					d.reserve_(n);
+					uninitialized_value_construct(end(), begin() + n);
+				}
+				d.set_size_(n);
+			}
+			void resize(const size_type n, const T& x) requires copy_constructible<T> {
+				auto& d = derived();
+				if (n < d.size()) {
+					destroy(begin() + n, end());
+				} else if (n > d.size()) {
+					const T& y = reserve_keeping(n, x);
+					uninitialized_fill(end(), begin() + n, y);
+				}
+				d.set_size_(n);
+			}
+
+			// Assignments overwrite the elements there are, then construct or
+			// destroy the difference.
+			void assign(const size_type n, const T& x) requires copyable<T> {
+				auto& d = derived();
+				const auto m = d.size();
+				if (n <= m) {
+					__stl2::fill(begin(), begin() + n, x);
+					destroy(begin() + n, end());
+					d.set_size_(n);
+				} else {
+					__stl2::fill(begin(), end(), x);
+					const T& y = reserve_keeping(n, x);
+					uninitialized_fill(end(), begin() + n, y);
+					d.set_size_(n);
+				}
+			}
+			template<input_iterator I, sentinel_for<I> S>
+			requires constructible_from<T, iter_reference_t<I>> &&
+				assignable_from<T&, iter_reference_t<I>>
+			void assign(I first, S last) {
+				auto& d = derived();
+				if constexpr (forward_iterator<I>) {
+					const auto n = static_cast<size_type>(distance(first, last));
+					if (n > d.capacity()) {
+						clear();
+						d.reserve_(n);
+					}
+					const auto m = d.size();
+					if (n <= m) {
+						destroy(__stl2::copy(std::move(first), std::move(last), begin()).out, end());
+					} else {
+						auto i = __stl2::copy_n(std::move(first), static_cast<difference_type>(m),
+							begin()).in;
+						uninitialized_copy(std::move(i), std::move(last), end(), begin() + n);
+					}
+					d.set_size_(n);
+				} else {
+					auto i = begin();
+					for (; i != end() && first != last; ++i, (void) ++first) {
+						*i = *first;
+					}
+					if (i != end()) {
+						destroy(i, end());
+						d.set_size_(static_cast<size_type>(i - begin()));
+					} else {
+						append(std::move(first), std::move(last));
+					}
+				}
+			}
+			void assign(std::initializer_list<T> il) requires copyable<T> {
+				assign(il.begin(), il.end());
+			}
+
+			friend bool operator==(const D& x, const D& y) requires equality_comparable<T> {
+				return __stl2::equal(x, y);
+			}
+			friend bool operator!=(const D& x, const D& y) requires equality_comparable<T> {
+				return !(x == y);
+			}
+			friend bool operator<(const D& x, const D& y) requires totally_ordered<T> {
+				return __stl2::lexicographical_compare(x, y);
+			}
+			friend bool operator>(const D& x, const D& y) requires totally_ordered<T> {
+				return y < x;
+			}
+			friend bool operator<=(const D& x, const D& y) requires totally_ordered<T> {
+				return !(y < x);
+			}
+			friend bool operator>=(const D& x, const D& y) requires totally_ordered<T> {
+				return !(x < y);
+			}
+		};
+	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// inplace_vector [Extension]
+		//
+		// A vector of at most N elements, which it holds within itself:
+		// it never allocates, and making room for more elements than N
+		// throws std::bad_alloc. Copies of trivially copyable elements are
+		// trivial copies of the whole, and moves of trivially relocatable
+		// elements copy their bytes, leaving the source empty.
+		//
+		template<destructible T, std::size_t N>
+		requires std::is_object_v<T>
+		class inplace_vector
+		: public detail::vector_interface<inplace_vector<T, N>, T> {
+			friend detail::vector_interface<inplace_vector, T>;
+
+			detail::inline_storage<T, N> storage_;
+			std::size_t size_ = 0;
+
+			void set_size_(const std::size_t n) noexcept {
+				size_ = n;
+			}
+			void reserve_(const std::size_t n) const {
+				if (n > N) throw std::bad_alloc{};
+			}
+			template<class... Args>
+			[[noreturn]] T& grow_emplace_back_(Args&&...) const {
+				throw std::bad_alloc{};
+			}
+
+			template<class F>
+			void initialize(F f) {
+				try {
+					f();
+				} catch (...) {
+					this->clear();
+					throw;
+				}
+			}
+
+			static constexpr bool trivial_copy = std::is_trivially_copyable_v<T>;
+
+		public:
+			inplace_vector() = default;
+			explicit inplace_vector(const std::size_t n) requires default_initializable<T> {
+				initialize([&] { this->resize(n); });
+			}
+			inplace_vector(const std::size_t n, const T& x) requires copyable<T> {
+				initialize([&] { this->assign(n, x); });
+			}
+			template<input_iterator I, sentinel_for<I> S>
+			requires constructible_from<T, iter_reference_t<I>>
+			inplace_vector(I first, S last) {
+				initialize([&] { this->append(std::move(first), std::move(last)); });
+			}
+			inplace_vector(std::initializer_list<T> il) requires copy_constructible<T>
+			: inplace_vector(il.begin(), il.end()) {}
+
+			inplace_vector(const inplace_vector&) requires trivial_copy = default;
+			inplace_vector(const inplace_vector& that)
+			requires (!trivial_copy && copy_constructible<T>)
+			{
+				uninitialized_copy(that.begin(), that.end(), data(), data() + N);
+				size_ = that.size_;
+			}
+			inplace_vector(inplace_vector&&) requires trivial_copy = default;
+			inplace_vector(inplace_vector&& that)
+			noexcept(std::is_nothrow_move_constructible_v<T> || trivially_relocatable<T>)
+			requires (!trivial_copy && move_constructible<T>)
+			{
+				if constexpr (trivially_relocatable<T>) {
+					detail::relocate_elements(that.data(), that.size_, data());
+					size_ = std::exchange(that.size_, 0);
+				} else {
+					uninitialized_move(that.begin(), that.end(), data(), data() + N);
+					size_ = that.size_;
+				}
+			}
+
+			inplace_vector& operator=(const inplace_vector&) requires trivial_copy = default;
+			inplace_vector& operator=(const inplace_vector& that)
+			requires (!trivial_copy && copyable<T>)
+			{
+				if (this != &that) {
+					this->assign(that.begin(), that.end());
+				}
+				return *this;
+			}
+			inplace_vector& operator=(inplace_vector&&) requires trivial_copy = default;
+			inplace_vector& operator=(inplace_vector&& that)
+			noexcept((std::is_nothrow_move_constructible_v<T> &&
+				std::is_nothrow_move_assignable_v<T>) || trivially_relocatable<T>)
+			requires (!trivial_copy && movable<T>)
+			{
+				if (this != &that) {
+					if constexpr (trivially_relocatable<T>) {
+						this->clear();
+						detail::relocate_elements(that.data(), that.size_, data());
+						size_ = std::exchange(that.size_, 0);
+					} else {
+						this->assign(__stl2::make_move_iterator(that.begin()),
+							__stl2::make_move_iterator(that.end()));
+					}
+				}
+				return *this;
+			}
+
+			~inplace_vector() requires std::is_trivially_destructible_v<T> = default;
+			~inplace_vector() {
+				this->clear();
+			}
+
+			T* data() noexcept { return storage_.data(); }
+			const T* data() const noexcept { return storage_.data(); }
+			std::size_t size() const noexcept { return size_; }
+			static constexpr std::size_t capacity() noexcept { return N; }
+			static constexpr std::size_t max_size() noexcept { return N; }
+
+			// Appends an element constructed from args and returns its
+			// address, or, if there is no room, returns nullptr.
+			template<class... Args>
+			requires constructible_from<T, Args...>
+			T* try_emplace_back(Args&&... args) {
+				if (size_ == N) return nullptr;
+				return std::addressof(this->emplace_back(std::forward<Args>(args)...));
+			}
+			T* try_push_back(const T& x) requires copy_constructible<T> {
+				return try_emplace_back(x);
+			}
+			T* try_push_back(T&& x) requires move_constructible<T> {
+				return try_emplace_back(std::move(x));
+			}
+
+			void swap(inplace_vector& that)
+			noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>)
+			requires swappable<T> && move_constructible<T>
+			{
+				auto* x = this;
+				auto* y = &that;
+				if (x->size_ < y->size_) std::swap(x, y);
+				const auto n = y->size_;
+				__stl2::swap_ranges(y->data(), y->data() + n, x->data(), x->data() + n);
+				detail::relocate_elements(x->data() + n, x->size_ - n, y->data() + n);
+				std::swap(x->size_, y->size_);
+			}
+
+			friend void swap(inplace_vector& x, inplace_vector& y)
+			noexcept(noexcept(x.swap(y)))
+			requires swappable<T> && move_constructible<T>
+			{
+				x.swap(y);
+			}
+		};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,212 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_MEMORY_RELOCATE_HPP
+#define STL2_DETAIL_MEMORY_RELOCATE_HPP
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memcopy.hpp>
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/memory/concepts.hpp>
+#include <stl2/detail/memory/construct_at.hpp>
+#include <stl2/detail/memory/destroy.hpp>
+
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// enable_trivially_relocatable, trivially_relocatable [Extension]
+		//
+		// Types whose objects may be relocated - moved to new storage, and
+		// the old object's lifetime ended - by copying their bytes: the
+		// trivially copyable types, and those for which this is specialized.
+		template<class T>
+		inline constexpr bool enable_trivially_relocatable =
+			std::is_trivially_copyable_v<T>;
+
+		template<class T>
+		inline constexpr bool enable_trivially_relocatable<std::allocator<T>> = true;
+		template<class T, class D>
+		inline constexpr bool enable_trivially_relocatable<std::unique_ptr<T, D>> =
+			enable_trivially_relocatable<D>;
+		template<class T>
+		inline constexpr bool enable_trivially_relocatable<std::shared_ptr<T>> = true;
+		template<class T>
+		inline constexpr bool enable_trivially_relocatable<std::weak_ptr<T>> = true;
+
+		// The containers of the debug modes keep pointers to themselves.
+#if !defined(_GLIBCXX_DEBUG)
+		template<class T, class A>
+		inline constexpr bool enable_trivially_relocatable<std::vector<T, A>> =
+			enable_trivially_relocatable<A>;
+#endif
+		// libstdc++'s strings point into themselves when short.
+#if defined(_LIBCPP_VERSION)
+		template<class C, class Traits, class A>
+		inline constexpr bool enable_trivially_relocatable<std::basic_string<C, Traits, A>> =
+			enable_trivially_relocatable<A>;
+#endif
+
+		template<class T>
+		META_CONCEPT trivially_relocatable = std::is_object_v<T> &&
+			enable_trivially_relocatable<std::remove_cv_t<T>>;
+	} // namespace ext
+
+	namespace detail {
+		// Iterators to elements that are better relocated by copying their
+		// bytes than by moving and destroying them: trivially relocatable,
+		// but not trivially copyable, whose moves copy bytes already.
+		template<class I>
+		META_CONCEPT byte_relocatable = readable<I> &&
+			same_as<iter_reference_t<I>, iter_value_t<I>&> &&
+			ext::trivially_relocatable<iter_value_t<I>> &&
+			!std::is_trivially_copyable_v<iter_value_t<I>>;
+
+		// Relocates the element src to the storage of dst.
+		template<class T>
+		void relocate_bytes(T& dst, T& src) noexcept {
+			std::memcpy(static_cast<void*>(std::addressof(dst)),
+				static_cast<const void*>(std::addressof(src)), sizeof(T));
+		}
+
+		// Storage for one T, into which an element may be relocated.
+		template<class T>
+		struct relocation_slot {
+			alignas(T) unsigned char bytes[sizeof(T)];
+
+			T& get() noexcept {
+				return *reinterpret_cast<T*>(bytes);
+			}
+		};
+
+		// Walks of arrays of a trivially relocatable type that a block copy
+		// of their bytes relocates to the walk of O.
+		template<class I, class O>
+		META_CONCEPT memrelocatable = memory_walk<I>::direction != 0 &&
+			memory_walk<I>::direction == memory_walk<O>::direction &&
+			same_as<typename memory_walk<I>::element_type,
+				typename memory_walk<O>::element_type> &&
+			!std::is_const_v<typename memory_walk<I>::element_type> &&
+			!std::is_volatile_v<typename memory_walk<I>::element_type> &&
+			ext::trivially_relocatable<typename memory_walk<I>::element_type>;
+	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// uninitialized_relocate [Extension]
+		//
+		// Relocates the elements of [ifirst, ilast) to the storage from
+		// ofirst: move constructs each output from its input and destroys
+		// the input, or copies the bytes of trivially relocatable elements,
+		// as one block where both ranges are arrays. The output may overlap
+		// the input if it begins before it. If an exception escapes, the
+		// elements of both ranges have all been destroyed.
+		//
+		template<class I, class O>
+		using uninitialized_relocate_result = __in_out_result<I, O>;
+
+		struct __uninitialized_relocate_fn : private __niebloid {
+			template<_NoThrowInputIterator I, _NoThrowSentinel<I> S,
+				_NoThrowForwardIterator O>
+			requires constructible_from<iter_value_t<O>, iter_rvalue_reference_t<I>>
+			uninitialized_relocate_result<I, O>
+			operator()(I ifirst, S ilast, O ofirst) const {
+				if constexpr (sized_sentinel_for<S, I> && detail::memrelocatable<I, O>) {
+					const auto n = static_cast<iter_difference_t<I>>(ilast - ifirst);
+					return detail::memcopy(std::move(ifirst), n, std::move(ofirst));
+				} else if constexpr (detail::byte_relocatable<I> &&
+					same_as<iter_reference_t<O>, iter_reference_t<I>>)
+				{
+					for (; ifirst != ilast; (void) ++ifirst, (void) ++ofirst) {
+						detail::relocate_bytes(*ofirst, *ifirst);
+					}
+					return {std::move(ifirst), std::move(ofirst)};
+				} else {
+					auto guard = detail::destroy_guard{ofirst};
+					try {
+						for (; ifirst != ilast; (void) ++ifirst, (void) ++ofirst) {
+							__stl2::__construct_at(*ofirst, iter_move(ifirst));
+							destroy_at(std::addressof(*ifirst));
+						}
+					} catch (...) {
+						destroy(std::move(ifirst), std::move(ilast));
+						throw;
+					}
+					guard.release();
+					return {std::move(ifirst), std::move(ofirst)};
+				}
+			}
+
+			template<_NoThrowInputRange IR, _NoThrowForwardIterator O>
+			requires constructible_from<iter_value_t<O>,
+				iter_rvalue_reference_t<iterator_t<IR>>>
+			uninitialized_relocate_result<safe_iterator_t<IR>, O>
+			operator()(IR&& in, O ofirst) const {
+				return (*this)(begin(in), end(in), std::move(ofirst));
+			}
+		};
+
+		inline constexpr __uninitialized_relocate_fn uninitialized_relocate{};
+
+		///////////////////////////////////////////////////////////////////////////
+		// uninitialized_relocate_n [Extension]
+		//
+		template<class I, class O>
+		using uninitialized_relocate_n_result = __in_out_result<I, O>;
+
+		struct __uninitialized_relocate_n_fn : private __niebloid {
+			template<_NoThrowInputIterator I, _NoThrowForwardIterator O>
+			requires constructible_from<iter_value_t<O>, iter_rvalue_reference_t<I>>
+			uninitialized_relocate_n_result<I, O>
+			operator()(I ifirst, iter_difference_t<I> n, O ofirst) const {
+				if constexpr (detail::memrelocatable<I, O>) {
+					return detail::memcopy(std::move(ifirst), n, std::move(ofirst));
+				} else {
+					auto [in, out] = uninitialized_relocate(
+						counted_iterator{std::move(ifirst), n}, default_sentinel,
+						std::move(ofirst));
+					return {in.base(), std::move(out)};
+				}
+			}
+		};
+
+		inline constexpr __uninitialized_relocate_n_fn uninitialized_relocate_n{};
+	} // namespace ext
+
+	namespace detail {
+		// Relocates, when it goes out of scope, the n elements left from
+		// first to the storage from dest. The relocating merges and
+		// partitions leave in their output as many holes as they hold
+		// elements in their buffers, which this fills however they exit.
+		template<class I, class D, class O>
+		struct relocate_on_exit {
+			I& first;
+			D& n;
+			O& dest;
+
+			~relocate_on_exit() {
+				auto result = ext::uninitialized_relocate_n(std::move(first),
+					static_cast<iter_difference_t<I>>(n), std::move(dest));
+				first = std::move(result.in);
+				dest = std::move(result.out);
+				n = 0;
+			}
+		};
+
+		template<class I, class D, class O>
+		relocate_on_exit(I&, D&, O&) -> relocate_on_exit<I, D, O>;
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
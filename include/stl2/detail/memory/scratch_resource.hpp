@@ -0,0 +1,219 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_MEMORY_SCRATCH_RESOURCE_HPP
+#define STL2_DETAIL_MEMORY_SCRATCH_RESOURCE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <stl2/detail/fwd.hpp>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// The most scratch memory, in bytes, that the arena of each thread keeps
+// for the buffered algorithms; larger buffers come from the heap.
+#ifndef STL2_SCRATCH_ARENA_CAPACITY
+#define STL2_SCRATCH_ARENA_CAPACITY (std::size_t{16} << 20)
+#endif
+
+// Whether the arena of each thread asks for its block in huge pages.
+#ifndef STL2_SCRATCH_ARENA_HUGE_PAGES
+#define STL2_SCRATCH_ARENA_HUGE_PAGES 0
+#endif
+
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// scratch_arena [Extension]
+		//
+		// A memory_resource for short-lived buffers, which it carves from
+		// one block: from the front while any is outstanding, rolling back
+		// the last when it is returned, and from the start again when all
+		// have been. Requests that do not fit go to the upstream resource;
+		// the next time the block is idle it is replaced, up to capacity
+		// bytes, by one large enough to have served them. The block may be
+		// aligned to and advised into transparent huge pages. Not safe to
+		// use from several threads at once.
+		//
+		class scratch_arena final : public std::pmr::memory_resource {
+			static constexpr std::size_t min_block = std::size_t{1} << 12;
+			static constexpr std::size_t huge_page = std::size_t{1} << 21;
+
+			std::pmr::memory_resource* upstream_;
+			std::size_t capacity_;
+			bool huge_pages_;
+			unsigned char* block_ = nullptr;
+			std::size_t size_ = 0;   // of the block
+			std::size_t used_ = 0;   // from the front of the block
+			std::size_t live_ = 0;   // allocations from the block outstanding
+			std::size_t wanted_ = 0; // size of block that would have served
+
+			std::size_t block_alignment() const noexcept {
+				return huge_pages_ ? huge_page : alignof(std::max_align_t);
+			}
+
+			bool owns(const unsigned char* p) const noexcept {
+				return block_ && std::less_equal<>{}(block_, p) &&
+					std::less<>{}(p, block_ + size_);
+			}
+
+			// Replaces the idle block by one of at least n bytes, or as
+			// many as capacity allows; keeps none if upstream has none.
+			void grow(std::size_t n) noexcept {
+				n = std::min(std::max({n, 2 * size_, min_block}), capacity_);
+				if (huge_pages_) {
+					const auto pages = (n + huge_page - 1) & ~(huge_page - 1);
+					if (n <= pages && pages <= capacity_) n = pages;
+				}
+				if (n <= size_) return;
+				release();
+				try {
+					block_ = static_cast<unsigned char*>(
+						upstream_->allocate(n, block_alignment()));
+				} catch (...) {
+					return;
+				}
+				size_ = n;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+				if (huge_pages_) {
+					(void) ::madvise(block_, n, MADV_HUGEPAGE);
+				}
+#endif
+			}
+
+			void* do_allocate(std::size_t bytes, const std::size_t alignment) override {
+				if (bytes == 0) bytes = 1;
+				const bool fits = bytes < capacity_ && alignment < capacity_ - bytes;
+				if (live_ == 0) {
+					used_ = 0;
+					if (fits) {
+						const auto n = std::max(wanted_, bytes + alignment);
+						if (n > size_) grow(n);
+					}
+				}
+				if (block_ && bytes <= size_ - used_) {
+					void* p = block_ + used_;
+					std::size_t space = size_ - used_;
+					if (std::align(alignment, bytes, p, space)) {
+						used_ = size_ - space + bytes;
+						++live_;
+						return p;
+					}
+				}
+				if (fits && used_ < capacity_ - bytes - alignment) {
+					wanted_ = std::max(wanted_, used_ + bytes + alignment);
+				}
+				return upstream_->allocate(bytes, alignment);
+			}
+
+			void do_deallocate(void* const p, std::size_t bytes,
+				const std::size_t alignment) override
+			{
+				if (bytes == 0) bytes = 1;
+				const auto q = static_cast<unsigned char*>(p);
+				if (owns(q)) {
+					if (q + bytes == block_ + used_) {
+						used_ = static_cast<std::size_t>(q - block_);
+					}
+					if (--live_ == 0) used_ = 0;
+				} else {
+					upstream_->deallocate(p, bytes, alignment);
+				}
+			}
+
+			bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override {
+				return this == &that;
+			}
+
+		public:
+			explicit scratch_arena(const std::size_t capacity = STL2_SCRATCH_ARENA_CAPACITY,
+				const bool huge_pages = STL2_SCRATCH_ARENA_HUGE_PAGES,
+				std::pmr::memory_resource* const upstream = std::pmr::new_delete_resource())
+				noexcept
+			: upstream_{upstream}, capacity_{capacity}, huge_pages_{huge_pages}
+			{}
+
+			scratch_arena(const scratch_arena&) = delete;
+			scratch_arena& operator=(const scratch_arena&) = delete;
+
+			~scratch_arena() {
+				STL2_EXPECT(live_ == 0);
+				release();
+			}
+
+			std::pmr::memory_resource* upstream_resource() const noexcept {
+				return upstream_;
+			}
+
+			// The most bytes the block may grow to.
+			std::size_t capacity() const noexcept {
+				return capacity_;
+			}
+
+			// The bytes of the block held.
+			std::size_t reserved() const noexcept {
+				return size_;
+			}
+
+			// Returns the block upstream, if no allocation from it is
+			// outstanding.
+			void release() noexcept {
+				if (block_ && live_ == 0) {
+					upstream_->deallocate(block_, size_, block_alignment());
+					block_ = nullptr;
+					size_ = 0;
+					used_ = 0;
+				}
+			}
+		};
+	} // namespace ext
+
+	namespace detail {
+		inline std::pmr::memory_resource*& thread_scratch_resource() noexcept {
+			thread_local std::pmr::memory_resource* resource = nullptr;
+			return resource;
+		}
+
+		inline ext::scratch_arena& thread_scratch_arena() noexcept {
+			thread_local ext::scratch_arena arena;
+			return arena;
+		}
+	}
+
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// scratch_resource, set_scratch_resource [Extension]
+		//
+		// The resource from which the buffered algorithms of the calling
+		// thread take their buffers: by default, a scratch_arena of the
+		// thread's own. set_scratch_resource replaces it for the thread, or
+		// restores the default if passed nullptr, and returns the previous.
+		//
+		inline std::pmr::memory_resource* scratch_resource() noexcept {
+			auto* const r = detail::thread_scratch_resource();
+			return r ? r : &detail::thread_scratch_arena();
+		}
+
+		inline std::pmr::memory_resource*
+		set_scratch_resource(std::pmr::memory_resource* const r) noexcept {
+			auto* const previous = scratch_resource();
+			detail::thread_scratch_resource() = r;
+			return previous;
+		}
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -13,7 +13,9 @@
 #ifndef STL2_DETAIL_MEMORY_UNINITIALIZED_COPY_HPP
 #define STL2_DETAIL_MEMORY_UNINITIALIZED_COPY_HPP
 
+#include <type_traits>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memcopy.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/memory/concepts.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
@@ -31,6 +33,14 @@ STL2_OPEN_NAMESPACE {
 		template<input_iterator I, sentinel_for<I> S1, _NoThrowForwardIterator O, _NoThrowSentinel<O> S2>
 		requires constructible_from<iter_value_t<O>, iter_reference_t<I>>
 		uninitialized_copy_result<I, O> operator()(I ifirst, S1 ilast, O ofirst, S2 olast) const {
+			if constexpr (sized_sentinel_for<S1, I> && sized_sentinel_for<S2, O> &&
+				detail::memcopyable<I, O, iter_reference_t<I>> &&
+				std::is_trivially_constructible_v<iter_value_t<O>, iter_reference_t<I>>)
+			{
+				const auto n = static_cast<iter_difference_t<I>>(ilast - ifirst);
+				const auto m = static_cast<iter_difference_t<I>>(olast - ofirst);
+				return detail::memcopy(std::move(ifirst), n < m ? n : m, std::move(ofirst));
+			}
 			auto guard = detail::destroy_guard{ofirst};
 			for (; ifirst != ilast && ofirst != olast; (void) ++ifirst, (void)++ofirst) {
 				__stl2::__construct_at(*ofirst, *ifirst);
@@ -15,6 +15,7 @@
 
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/algorithm/memfill.hpp>
 #include <stl2/detail/memory/concepts.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
 #include <stl2/detail/memory/destroy.hpp>
@@ -27,6 +28,13 @@ STL2_OPEN_NAMESPACE {
 		template<_NoThrowForwardIterator I, _NoThrowSentinel<I> S>
 		requires default_initializable<iter_value_t<I>>
 		I operator()(I first, S last) const {
+			if constexpr (sized_sentinel_for<S, I> && detail::memconstructible<I>) {
+				// Value-initialized, such an element is zero-initialized.
+				auto const n = last - first;
+				if (detail::memfill(first, n, [](auto& e) { __stl2::__construct_at(e); })) {
+					return detail::memory_walk<I>::advance(first, n);
+				}
+			}
 			auto guard = detail::destroy_guard{first};
 			for (; first != last; ++first) {
 				__stl2::__construct_at(*first);
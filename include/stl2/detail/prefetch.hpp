@@ -0,0 +1,43 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_PREFETCH_HPP
+#define STL2_DETAIL_PREFETCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stl2/detail/fwd.hpp>
+
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// The granularity of the memory system the search layouts are
+		// tuned to.
+		inline constexpr std::size_t cache_line = 64;
+
+		// Hints that the line holding p will soon be read. Prefetches
+		// never fault, and are ignored in constant evaluation.
+		constexpr void prefetch([[maybe_unused]] const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+			if (!is_constant_evaluated()) {
+				__builtin_prefetch(p);
+			}
+#endif
+		}
+
+		// Prefetches the element i past p, which need not lie within the
+		// object p points into: the address is formed as an integer.
+		template<class T>
+		void prefetch(const T* p, const std::size_t i) noexcept {
+			const auto address = reinterpret_cast<std::uintptr_t>(p) + i * sizeof(T);
+			prefetch(reinterpret_cast<const void*>(address));
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,260 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SEARCH_LAYOUT_HPP
+#define STL2_DETAIL_SEARCH_LAYOUT_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/prefetch.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// eytzinger_layout, btree_layout [Extension]
+//
+// Copies of a sorted sequence rearranged so that binary searching them
+// touches few cache lines, for the layout_lower_bound family. A search
+// yields a rank, the index in the sorted sequence, so that the layout can
+// serve as an index into the original.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Allocates on cache line boundaries, so that the blocks of a
+		// layout coincide with lines.
+		template<class T>
+		struct cache_aligned_allocator {
+			using value_type = T;
+
+			cache_aligned_allocator() = default;
+			template<class U>
+			constexpr cache_aligned_allocator(const cache_aligned_allocator<U>&) noexcept {}
+
+			T* allocate(const std::size_t n) {
+				return static_cast<T*>(::operator new(n * sizeof(T),
+					std::align_val_t{std::max(cache_line, alignof(T))}));
+			}
+			void deallocate(T* const p, std::size_t) noexcept {
+				::operator delete(p, std::align_val_t{std::max(cache_line, alignof(T))});
+			}
+
+			template<class U>
+			bool operator==(const cache_aligned_allocator<U>&) const noexcept { return true; }
+			template<class U>
+			bool operator!=(const cache_aligned_allocator<U>&) const noexcept { return false; }
+		};
+	} // namespace detail
+
+	namespace ext {
+		// A sorted sequence in the order of a breadth-first walk of the
+		// complete binary search tree over it: the children of the element
+		// at 1-based position k are at 2k and 2k + 1. The first levels of
+		// the tree share the first lines, which stay cached, and the 16
+		// great-great-grandchildren of an int share a line, so a search can
+		// prefetch four levels ahead.
+		template<semiregular T>
+		class eytzinger_layout {
+		public:
+			using value_type = T;
+
+			eytzinger_layout() = default;
+
+			// Copies the elements of sorted, which are in the order searches
+			// will use.
+			template<forward_range R>
+			requires constructible_from<T, range_reference_t<R>>
+			explicit eytzinger_layout(R&& sorted)
+			: n_(static_cast<std::size_t>(distance(sorted)))
+			, tree_(n_ + 1)
+			{
+				// An in-order walk of the tree visits the elements in sorted
+				// order.
+				auto it = begin(sorted);
+				std::size_t k = leftmost(1);
+				for (std::size_t i = 0; i < n_; ++i, ++it) {
+					tree_[k] = T(*it);
+					if (2 * k + 1 <= n_) {
+						k = leftmost(2 * k + 1);
+					} else {
+						// Up past the ancestors of which k is a right descendant
+						k >>= std::countr_one(k) + 1;
+					}
+				}
+			}
+
+			std::size_t size() const noexcept { return n_; }
+			bool empty() const noexcept { return n_ == 0; }
+
+			// The number of elements satisfying pred, which the elements
+			// satisfying it precede.
+			template<class Pred>
+			std::size_t partition_point(Pred pred) const {
+				const T* const tree = tree_.data();
+				std::size_t k = 1;
+				while (k <= n_) {
+					detail::prefetch(tree, k * lookahead);
+					k = 2 * k + static_cast<bool>(pred(tree[k]));
+				}
+				// Back up to where the search last turned left, at the first
+				// element not satisfying pred.
+				k >>= std::countr_one(k) + 1;
+				return k == 0 ? n_ : rank(k);
+			}
+
+		private:
+			// The stride of the descendants of an element some levels down
+			// that share a line with each other
+			static constexpr std::size_t lookahead =
+				std::bit_floor(std::max(detail::cache_line / sizeof(T), std::size_t{1}));
+
+			std::size_t n_ = 0;
+			std::vector<T, detail::cache_aligned_allocator<T>> tree_ =
+				std::vector<T, detail::cache_aligned_allocator<T>>(1);
+
+			std::size_t leftmost(std::size_t k) const noexcept {
+				while (2 * k <= n_) k *= 2;
+				return k;
+			}
+
+			// The index in sorted order of the element at position k: its
+			// index if the last level were full, less the elements missing
+			// from the last level that would precede it.
+			std::size_t rank(const std::size_t k) const noexcept {
+				const int height = std::bit_width(n_);
+				const int depth = std::bit_width(k) - 1;
+				const std::size_t full = ((2 * (k - (std::size_t{1} << depth)) + 1)
+					<< (height - 1 - depth)) - 1;
+				const std::size_t leaves = n_ - (std::size_t{1} << (height - 1)) + 1;
+				const std::size_t leaves_before = (full + 1) / 2;
+				return full - (leaves_before > leaves ? leaves_before - leaves : 0);
+			}
+		};
+
+		template<forward_range R>
+		eytzinger_layout(R&&) -> eytzinger_layout<range_value_t<R>>;
+
+		// A sorted sequence as a static B+ tree: the sequence itself in
+		// blocks of B elements at the bottom, above it a block of B
+		// separators for each group of B + 1 blocks below, and so on up to
+		// a single root block, all stored root first. The default block is
+		// a cache line, which a search reads in full, counting rather than
+		// branching, before descending; it touches one line per level,
+		// log(B + 1) times fewer than a binary search, and the upper levels
+		// stay cached. Blocks are padded with copies of the greatest element.
+		template<semiregular T,
+			std::size_t B = std::max(detail::cache_line / sizeof(T), std::size_t{2})>
+		class btree_layout {
+			static_assert(B >= 2);
+		public:
+			using value_type = T;
+
+			btree_layout() = default;
+
+			// Copies the elements of sorted, which are in the order searches
+			// will use.
+			template<forward_range R>
+			requires constructible_from<T, range_reference_t<R>>
+			explicit btree_layout(R&& sorted)
+			: n_(static_cast<std::size_t>(distance(sorted)))
+			{
+				if (n_ == 0) return;
+
+				// Level 0 holds the blocks of elements, level h the blocks of
+				// separators for the blocks of level h - 1.
+				for (std::size_t blocks = (n_ + B - 1) / B;;
+					blocks = (blocks + B) / (B + 1))
+				{
+					blocks_.push_back(blocks);
+					if (blocks == 1) break;
+				}
+				offsets_.resize(blocks_.size());
+				std::size_t size = 0;
+				for (std::size_t h = blocks_.size(); h-- > 0;) {
+					offsets_[h] = size;
+					size += blocks_[h] * B;
+				}
+				tree_.resize(size);
+
+				T* const leaves = tree_.data() + offsets_[0];
+				auto it = begin(sorted);
+				for (std::size_t i = 0; i < n_; ++i, ++it) {
+					leaves[i] = T(*it);
+				}
+				std::fill(leaves + n_, leaves + blocks_[0] * B, leaves[n_ - 1]);
+
+				// Separator j of a block is the greatest element under its
+				// child j, whose span is the number of elements under it.
+				std::size_t span = B;
+				for (std::size_t h = 1; h < blocks_.size(); ++h, span *= B + 1) {
+					T* const level = tree_.data() + offsets_[h];
+					for (std::size_t i = 0; i < blocks_[h] * B; ++i) {
+						const std::size_t child = i / B * (B + 1) + i % B;
+						level[i] = leaves[std::min(n_, (child + 1) * span) - 1];
+					}
+				}
+			}
+
+			std::size_t size() const noexcept { return n_; }
+			bool empty() const noexcept { return n_ == 0; }
+
+			// The number of elements satisfying pred, which the elements
+			// satisfying it precede.
+			template<class Pred>
+			std::size_t partition_point(Pred pred) const {
+				if (n_ == 0) return 0;
+				const T* const tree = tree_.data();
+				// Past the greatest element, the padding would lead astray.
+				if (pred(tree[offsets_[0] + n_ - 1])) return n_;
+
+				std::size_t i = 0;
+				for (std::size_t h = blocks_.size() - 1; h > 0; --h) {
+					i = i * (B + 1) + count(tree + offsets_[h] + i * B, pred);
+					if constexpr (B * sizeof(T) > detail::cache_line) {
+						// Fetch the lines of the child block at once.
+						const T* const child = tree + offsets_[h - 1] + i * B;
+						for (std::size_t j = 0; j < B; j += lines) {
+							detail::prefetch(child + j);
+						}
+					}
+				}
+				return i * B + count(tree + offsets_[0] + i * B, pred);
+			}
+
+		private:
+			static constexpr std::size_t lines =
+				std::max(detail::cache_line / sizeof(T), std::size_t{1});
+
+			std::size_t n_ = 0;
+			std::vector<T, detail::cache_aligned_allocator<T>> tree_;
+			std::vector<std::size_t> offsets_;
+			std::vector<std::size_t> blocks_;
+
+			template<class Pred>
+			static std::size_t count(const T* const block, Pred& pred) {
+				std::size_t c = 0;
+				for (std::size_t j = 0; j < B; ++j) {
+					c += static_cast<bool>(pred(block[j]));
+				}
+				return c;
+			}
+		};
+
+		template<forward_range R>
+		btree_layout(R&&) -> btree_layout<range_value_t<R>>;
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,1602 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_HPP
+#define STL2_DETAIL_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/functional/comparisons.hpp>
+#include <stl2/detail/functional/invoke.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STL2_SIMD_X86 1
+#include <immintrin.h>
+#define STL2_TARGET_SSE2 __attribute__((target("sse2")))
+#define STL2_TARGET_AVX2 __attribute__((target("avx2,popcnt,bmi")))
+#define STL2_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx2,popcnt,bmi")))
+#else
+#define STL2_SIMD_X86 0
+#endif
+
+///////////////////////////////////////////////////////////////////////////
+// Vector kernels for algorithms over contiguous scalars
+//
+// Each kernel comes in SSE2, AVX2 and AVX-512 flavors compiled with
+// per-function target attributes, whichever the processor supports best
+// being chosen at run time, so that no particular -m flag is needed. The
+// widest kernels hand their remainders down to the narrower ones, ending in
+// a scalar loop.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail::simd {
+		// Instruction sets with kernels, in increasing order.
+		enum class isa : unsigned char { scalar, sse2, avx2, avx512 };
+
+		inline isa detect_isa() noexcept {
+#if STL2_SIMD_X86
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512bw")) return isa::avx512;
+			if (__builtin_cpu_supports("avx2")) return isa::avx2;
+			if (__builtin_cpu_supports("sse2")) return isa::sse2;
+#endif
+			return isa::scalar;
+		}
+
+		// The instruction set the kernels use, detected on first use. It may
+		// be lowered, which lets tests exercise each kernel the machine
+		// supports.
+		inline isa& active_isa() noexcept {
+			static isa level = detect_isa();
+			return level;
+		}
+
+		// Scalars that are equal exactly when their representations are.
+		template<class T>
+		META_CONCEPT bitwise_comparable =
+			(integral<T> || std::is_pointer_v<T> || same_as<T, std::byte>) &&
+			(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+		template<std::size_t> struct uint_;
+		template<> struct uint_<1> { using type = std::uint8_t; };
+		template<> struct uint_<2> { using type = std::uint16_t; };
+		template<> struct uint_<4> { using type = std::uint32_t; };
+		template<> struct uint_<8> { using type = std::uint64_t; };
+
+		template<std::size_t W>
+		using uint = typename uint_<W>::type;
+
+		template<class T>
+		uint<sizeof(T)> bits_of(const T& t) noexcept {
+			uint<sizeof(T)> u;
+			std::memcpy(&u, &t, sizeof(T));
+			return u;
+		}
+
+		template<std::size_t W>
+		uint<W> load(const unsigned char* const p) noexcept {
+			uint<W> u;
+			std::memcpy(&u, p, W);
+			return u;
+		}
+
+		// Whether some x of type V satisfies x == value, and if so sets out
+		// to the only one that does: integers compare in their common type,
+		// into which V converts injectively.
+		template<class V, class T>
+		constexpr bool narrow(const T& value, V& out) noexcept {
+			if constexpr (same_as<V, T>) {
+				out = value;
+				return true;
+			} else {
+				using C = decltype(V{} + T{});
+				out = static_cast<V>(value);
+				return static_cast<C>(out) == static_cast<C>(value);
+			}
+		}
+
+		// identity, also as passed on by the range overloads.
+		template<class Proj>
+		META_CONCEPT identity_projection = same_as<Proj, identity> ||
+			same_as<Proj, reference_wrapper<identity>> ||
+			same_as<Proj, reference_wrapper<const identity>>;
+
+		// Searches and counts by value that the kernels can carry out:
+		// contiguous, unprojected scalars, compared with a value of the same
+		// type or, between integers, of any type.
+		template<class I, class S, class Proj, class T>
+		META_CONCEPT value_scannable = contiguous_iterator<I> &&
+			sized_sentinel_for<S, I> && identity_projection<Proj> &&
+			bitwise_comparable<iter_value_t<I>> &&
+			!std::is_volatile_v<std::remove_reference_t<iter_reference_t<I>>> &&
+			(same_as<iter_value_t<I>, T> || (integral<iter_value_t<I>> && integral<T>));
+
+		// Recognizes the predicates of ext::equal_to_value and
+		// ext::not_equal_to_value, also through reference_wrapper.
+		template<class Pred>
+		struct value_predicate {};
+		template<class Pred>
+		struct value_predicate<const Pred> : value_predicate<Pred> {};
+		template<class T>
+		struct value_predicate<ext::equal_to_value<T>> {
+			using value_type = __uncvref<T>;
+			static constexpr bool equal = true;
+			static constexpr const T& value(const ext::equal_to_value<T>& pred) noexcept {
+				return pred.value;
+			}
+		};
+		template<class T>
+		struct value_predicate<ext::not_equal_to_value<T>> {
+			using value_type = __uncvref<T>;
+			static constexpr bool equal = false;
+			static constexpr const T& value(const ext::not_equal_to_value<T>& pred) noexcept {
+				return pred.value;
+			}
+		};
+		template<class Pred>
+		struct value_predicate<reference_wrapper<Pred>> : value_predicate<Pred> {
+			static constexpr decltype(auto) value(const reference_wrapper<Pred>& pred) noexcept {
+				return value_predicate<Pred>::value(pred.get());
+			}
+		};
+
+		template<class I, class S, class Proj, class Pred>
+		META_CONCEPT predicate_scannable =
+			requires { typename value_predicate<Pred>::value_type; } &&
+			value_scannable<I, S, Proj, typename value_predicate<Pred>::value_type>;
+
+		// Whether Pred is equal_to, or std::equal_to for V, also through
+		// reference_wrapper.
+		template<class Pred, class V>
+		inline constexpr bool is_equal_to = false;
+		template<class V>
+		inline constexpr bool is_equal_to<equal_to, V> = true;
+		template<class V>
+		inline constexpr bool is_equal_to<std::equal_to<>, V> = true;
+		template<class V>
+		inline constexpr bool is_equal_to<std::equal_to<V>, V> = true;
+		template<class Pred, class V>
+		inline constexpr bool is_equal_to<const Pred, V> = is_equal_to<Pred, V>;
+		template<class Pred, class V>
+		inline constexpr bool is_equal_to<reference_wrapper<Pred>, V> = is_equal_to<Pred, V>;
+
+		// 1 if Comp is less, -1 if it is greater, else 0, recognized as
+		// is_equal_to recognizes equal_to.
+		template<class Comp, class V>
+		inline constexpr int order_of = 0;
+		template<class V>
+		inline constexpr int order_of<less, V> = 1;
+		template<class V>
+		inline constexpr int order_of<std::less<>, V> = 1;
+		template<class V>
+		inline constexpr int order_of<std::less<V>, V> = 1;
+		template<class V>
+		inline constexpr int order_of<greater, V> = -1;
+		template<class V>
+		inline constexpr int order_of<std::greater<>, V> = -1;
+		template<class V>
+		inline constexpr int order_of<std::greater<V>, V> = -1;
+		template<class Comp, class V>
+		inline constexpr int order_of<const Comp, V> = order_of<Comp, V>;
+		template<class Comp, class V>
+		inline constexpr int order_of<reference_wrapper<Comp>, V> = order_of<Comp, V>;
+
+		// Pairs of ranges the kernels can compare element by element:
+		// contiguous, unprojected and of the same scalar type.
+		template<class I1, class I2, class Proj1, class Proj2>
+		META_CONCEPT pairwise_scannable = contiguous_iterator<I1> &&
+			contiguous_iterator<I2> && identity_projection<Proj1> &&
+			identity_projection<Proj2> && same_as<iter_value_t<I1>, iter_value_t<I2>> &&
+			bitwise_comparable<iter_value_t<I1>> &&
+			!std::is_volatile_v<std::remove_reference_t<iter_reference_t<I1>>> &&
+			!std::is_volatile_v<std::remove_reference_t<iter_reference_t<I2>>>;
+
+		// ... and for equality.
+		template<class I1, class I2, class Pred, class Proj1, class Proj2>
+		META_CONCEPT equality_scannable = pairwise_scannable<I1, I2, Proj1, Proj2> &&
+			is_equal_to<Pred, iter_value_t<I1>>;
+
+		// ... and for ordering, which pointers are not.
+		template<class I1, class I2, class Comp, class Proj1, class Proj2>
+		META_CONCEPT order_scannable = pairwise_scannable<I1, I2, Proj1, Proj2> &&
+			!std::is_pointer_v<iter_value_t<I1>> && order_of<Comp, iter_value_t<I1>> != 0;
+
+		// Sorted ranges whose intersection the kernels can take: contiguous,
+		// unprojected 4- or 8-byte integers in ascending order, of known
+		// length, whose elements O accepts.
+		template<class I1, class S1, class I2, class S2, class O, class Comp,
+			class Proj1, class Proj2>
+		META_CONCEPT intersectable = order_scannable<I1, I2, Comp, Proj1, Proj2> &&
+			(order_of<Comp, iter_value_t<I1>> > 0) && integral<iter_value_t<I1>> &&
+			(sizeof(iter_value_t<I1>) == 4 || sizeof(iter_value_t<I1>) == 8) &&
+			sized_sentinel_for<S1, I1> && sized_sentinel_for<S2, I2> &&
+			indirectly_copyable<const iter_value_t<I1>*, O>;
+
+		// Arithmetic scalars the kernels can order, as less does.
+		template<class T>
+		META_CONCEPT orderable_scalar =
+			((integral<T> && !same_as<T, bool>) || same_as<T, float> || same_as<T, double>) &&
+			(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+		// Ranges whose adjacent elements the kernels can compare:
+		// contiguous, unprojected and of known length.
+		template<class I, class S, class Proj>
+		META_CONCEPT adjacent_scannable = contiguous_iterator<I> &&
+			sized_sentinel_for<S, I> && identity_projection<Proj> &&
+			!std::is_volatile_v<std::remove_reference_t<iter_reference_t<I>>>;
+
+		// ... for equality.
+		template<class I, class S, class Pred, class Proj>
+		META_CONCEPT adjacent_equality_scannable = adjacent_scannable<I, S, Proj> &&
+			bitwise_comparable<iter_value_t<I>> && is_equal_to<Pred, iter_value_t<I>>;
+
+		// ... for ordering. NaNs, which less does not order, may be treated
+		// differently than by the element-wise algorithms.
+		template<class I, class S, class Comp, class Proj>
+		META_CONCEPT adjacent_order_scannable = adjacent_scannable<I, S, Proj> &&
+			orderable_scalar<iter_value_t<I>> && order_of<Comp, iter_value_t<I>> != 0;
+
+		// Ranges whose least and greatest elements the kernels can find,
+		// keeping the index of each alongside it in a lane as wide: those
+		// of 4- or 8-byte elements.
+		template<class I, class S, class Comp, class Proj>
+		META_CONCEPT extremum_scannable = adjacent_order_scannable<I, S, Comp, Proj> &&
+			sizeof(iter_value_t<I>) >= 4;
+
+		// Scalar loops over the elements [i, n) of the W-byte elements at p.
+		template<bool Eq, std::size_t W>
+		std::size_t find_scalar(const unsigned char* const p, std::size_t i,
+			const std::size_t n, const uint<W> bits) noexcept
+		{
+			for (; i < n; ++i) {
+				if ((load<W>(p + i * W) == bits) == Eq) break;
+			}
+			return i;
+		}
+
+		template<std::size_t W>
+		std::size_t count_scalar(const unsigned char* const p, std::size_t i,
+			const std::size_t n, const uint<W> bits) noexcept
+		{
+			std::size_t count = 0;
+			for (; i < n; ++i) {
+				count += load<W>(p + i * W) == bits;
+			}
+			return count;
+		}
+
+		// A search through the n bytes at h for the m >= 2 bytes at s, which
+		// filters candidate positions by their first and last bytes and
+		// verifies only those. Verifying false candidates costs at most m
+		// each, so once that has cost more than a few times the positions
+		// scanned, the search gives up, leaving the rest to a linear-time
+		// algorithm.
+		struct byte_search {
+			const unsigned char* h;
+			std::size_t n;
+			const unsigned char* s;
+			std::size_t m;
+			std::size_t work = 0;
+			bool gave_up = false;
+
+			// Whether the candidate at c, whose first and last bytes match,
+			// matches in full.
+			bool verify(const std::size_t c) noexcept {
+				work += m;
+				return std::memcmp(h + c + 1, s + 1, m - 2) == 0;
+			}
+
+			// Whether verification has cost too much to go on at c.
+			bool over_budget(const std::size_t c) noexcept {
+				gave_up = work > 4 * c + 16 * m;
+				return gave_up;
+			}
+		};
+
+		// The least position i' >= i of a match, or n - m + 1 if there is
+		// none, or if the search gives up, the position it gives up at.
+		inline std::size_t search_scalar(byte_search& b, std::size_t i) noexcept {
+			const std::size_t end = b.n - b.m + 1;
+			for (; i < end; ++i) {
+				if (b.h[i] == b.s[0] && b.h[i + b.m - 1] == b.s[b.m - 1]) {
+					if (b.verify(i)) return i;
+					if (b.over_budget(i)) return i + 1;
+				}
+			}
+			return end;
+		}
+
+		// The elements in the blocks of the widest kernel, and the number
+		// of matches a run may store.
+		template<class T>
+		inline constexpr std::size_t intersection_block = 64 / sizeof(T);
+		inline constexpr std::size_t intersection_buffer = 256;
+
+		// Why a run of the intersection kernels stopped: with its buffer
+		// full, short of the last block of either range, or at a block
+		// holding duplicates.
+		enum class intersection_stop : unsigned char { full, tail, duplicate };
+
+		// The intersection of the ascending ranges a and b, taken a pair of
+		// blocks at a time: each element of the block of a is compared with
+		// every element of the block of b, and the block whose last element
+		// is less gives way to the next, or both if they are equal. The
+		// elements of a with a match are stored at out, in order. That
+		// finds each match once only while neither range repeats an
+		// element, so the kernels stop at a block that does, and the
+		// element-wise algorithm resumes from [i, j).
+		template<class T>
+		struct block_intersection {
+			const T* a;
+			std::size_t na;
+			const T* b;
+			std::size_t nb;
+			T* out;
+			std::size_t i = 0;
+			std::size_t j = 0;
+			std::size_t count = 0;
+
+			// Ends a run in a state of the element-wise algorithm. Where the
+			// block of a at i has been compared with the block of b before j,
+			// its elements no greater than b[j - 1] are done with, and
+			// likewise the other way about; at most one block of a run is
+			// left compared.
+			void settle(const bool compared_a, const bool compared_b,
+				const std::size_t lanes) noexcept
+			{
+				if (compared_a && j > 0) {
+					const std::size_t end = i + lanes;
+					while (i < end && !(b[j - 1] < a[i])) ++i;
+				}
+				if (compared_b && i > 0) {
+					const std::size_t end = j + lanes;
+					while (j < end && !(a[i - 1] < b[j])) ++j;
+				}
+			}
+		};
+
+		// Whether two of the first n W-byte elements at p are adjacent and
+		// equal.
+		template<std::size_t W>
+		bool repeats_scalar(const unsigned char* const p, const std::size_t n) noexcept {
+			for (std::size_t k = 1; k < n; ++k) {
+				if (load<W>(p + k * W) == load<W>(p + (k - 1) * W)) return true;
+			}
+			return false;
+		}
+
+		// Whether a precedes b in ascending (Order > 0) or descending order.
+		template<int Order, class T>
+		constexpr bool before(const T& a, const T& b) noexcept {
+			return Order > 0 ? a < b : b < a;
+		}
+
+		// The least k' >= k for which the elements p[k'] and p[k' + 1] of
+		// the n at p are equal (Rel == 0) or, in the order of Rel, out of
+		// order, or n if there is none.
+		template<int Rel, class T>
+		std::size_t adjacent_scalar(const T* const p, std::size_t k, const std::size_t n) noexcept {
+			for (; k + 1 < n; ++k) {
+				if (Rel == 0 ? p[k] == p[k + 1] : before<Rel>(p[k + 1], p[k])) return k;
+			}
+			return n;
+		}
+
+		// The indices of the first least and the last greatest of some
+		// elements.
+		struct extrema {
+			std::size_t min = 0;
+			std::size_t max = 0;
+		};
+
+		// Folds the elements [i, n) at p into r, the extrema (of those of
+		// Min and Max that are wanted) of the elements before them.
+		template<int Order, bool Min, bool Max, class T>
+		void extrema_scalar(const T* const p, std::size_t i, const std::size_t n,
+			extrema& r) noexcept
+		{
+			for (; i < n; ++i) {
+				if (Min && before<Order>(p[i], p[r.min])) r.min = i;
+				if (Max && !before<Order>(p[i], p[r.max])) r.max = i;
+			}
+		}
+
+		// The index at[k] of the least (!Max) or greatest of the lanes
+		// values[k]: among equivalent lanes, the least index, or for the
+		// greatest, the greatest.
+		template<int Order, bool Max, class T, class U>
+		std::size_t extremum_of_lanes(const T* const values, const U* const at,
+			const std::size_t lanes) noexcept
+		{
+			std::size_t best = 0;
+			for (std::size_t k = 1; k < lanes; ++k) {
+				const T& x = values[k];
+				const T& y = values[best];
+				const bool better = Max
+					? before<Order>(y, x) || (!before<Order>(x, y) && at[best] < at[k])
+					: before<Order>(x, y) || (!before<Order>(y, x) && at[k] < at[best]);
+				if (better) best = k;
+			}
+			return static_cast<std::size_t>(at[best]);
+		}
+
+#if STL2_SIMD_X86
+		template<std::size_t W>
+		STL2_TARGET_SSE2 inline __m128i broadcast_sse2(const uint<W> bits) noexcept {
+			if constexpr (W == 1) return _mm_set1_epi8(static_cast<char>(bits));
+			else if constexpr (W == 2) return _mm_set1_epi16(static_cast<short>(bits));
+			else if constexpr (W == 4) return _mm_set1_epi32(static_cast<int>(bits));
+			else return _mm_set1_epi64x(static_cast<long long>(bits));
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_SSE2 inline __m128i cmpeq_sse2(const __m128i a, const __m128i b) noexcept {
+			if constexpr (W == 1) return _mm_cmpeq_epi8(a, b);
+			else if constexpr (W == 2) return _mm_cmpeq_epi16(a, b);
+			else if constexpr (W == 4) return _mm_cmpeq_epi32(a, b);
+			else {
+				// Both halves of each 64-bit lane equal.
+				const __m128i e = _mm_cmpeq_epi32(a, b);
+				return _mm_and_si128(e, _mm_shuffle_epi32(e, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+		}
+
+		STL2_TARGET_SSE2 inline __m128i load_sse2(const unsigned char* const p) noexcept {
+			return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		}
+
+		template<bool Eq, std::size_t W>
+		STL2_TARGET_SSE2 std::size_t find_sse2(const unsigned char* const p,
+			const std::size_t n, const uint<W> bits) noexcept
+		{
+			constexpr std::size_t lanes = 16 / W;
+			constexpr unsigned none = Eq ? 0u : 0xFFFFu;
+			const __m128i v = broadcast_sse2<W>(bits);
+			std::size_t i = 0;
+			for (; i + 4 * lanes <= n; i += 4 * lanes) {
+				const unsigned char* const q = p + i * W;
+				const __m128i a = cmpeq_sse2<W>(load_sse2(q), v);
+				const __m128i b = cmpeq_sse2<W>(load_sse2(q + 16), v);
+				const __m128i c = cmpeq_sse2<W>(load_sse2(q + 32), v);
+				const __m128i d = cmpeq_sse2<W>(load_sse2(q + 48), v);
+				const __m128i any = Eq
+					? _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))
+					: _mm_and_si128(_mm_and_si128(a, b), _mm_and_si128(c, d));
+				if ((static_cast<unsigned>(_mm_movemask_epi8(any)) ^ none) != 0) break;
+			}
+			for (; i + lanes <= n; i += lanes) {
+				const unsigned mask = static_cast<unsigned>(
+					_mm_movemask_epi8(cmpeq_sse2<W>(load_sse2(p + i * W), v))) ^ none;
+				if (mask != 0) {
+					return i + static_cast<std::size_t>(__builtin_ctz(mask)) / W;
+				}
+			}
+			return find_scalar<Eq, W>(p, i, n, bits);
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_SSE2 inline __m128i sub_sse2(const __m128i a, const __m128i b) noexcept {
+			if constexpr (W == 1) return _mm_sub_epi8(a, b);
+			else if constexpr (W == 2) return _mm_sub_epi16(a, b);
+			else if constexpr (W == 4) return _mm_sub_epi32(a, b);
+			else return _mm_sub_epi64(a, b);
+		}
+
+		// Counting subtracts each comparison's all-ones lanes from counters
+		// as wide as the elements; they are summed after at most this many
+		// vectors, before they can overflow.
+		template<std::size_t W>
+		inline constexpr std::size_t count_flush = W < 4
+			? (std::size_t{1} << (8 * W)) - 1 : std::size_t{1} << 24;
+
+		template<std::size_t W>
+		STL2_TARGET_SSE2 std::size_t count_sse2(const unsigned char* const p,
+			const std::size_t n, const uint<W> bits) noexcept
+		{
+			constexpr std::size_t lanes = 16 / W;
+			const __m128i v = broadcast_sse2<W>(bits);
+			std::size_t count = 0;
+			std::size_t i = 0;
+			while (i + lanes <= n) {
+				const std::size_t stop = (n - i) / lanes > count_flush<W>
+					? i + count_flush<W> * lanes : n;
+				__m128i acc = _mm_setzero_si128();
+				for (; i + lanes <= stop; i += lanes) {
+					acc = sub_sse2<W>(acc, cmpeq_sse2<W>(load_sse2(p + i * W), v));
+				}
+				uint<W> counters[lanes];
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(counters), acc);
+				for (const auto c : counters) count += c;
+			}
+			return count + count_scalar<W>(p, i, n, bits);
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_AVX2 inline __m256i broadcast_avx2(const uint<W> bits) noexcept {
+			if constexpr (W == 1) return _mm256_set1_epi8(static_cast<char>(bits));
+			else if constexpr (W == 2) return _mm256_set1_epi16(static_cast<short>(bits));
+			else if constexpr (W == 4) return _mm256_set1_epi32(static_cast<int>(bits));
+			else return _mm256_set1_epi64x(static_cast<long long>(bits));
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_AVX2 inline __m256i cmpeq_avx2(const __m256i a, const __m256i b) noexcept {
+			if constexpr (W == 1) return _mm256_cmpeq_epi8(a, b);
+			else if constexpr (W == 2) return _mm256_cmpeq_epi16(a, b);
+			else if constexpr (W == 4) return _mm256_cmpeq_epi32(a, b);
+			else return _mm256_cmpeq_epi64(a, b);
+		}
+
+		STL2_TARGET_AVX2 inline __m256i load_avx2(const unsigned char* const p) noexcept {
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+		}
+
+		template<bool Eq, std::size_t W>
+		STL2_TARGET_AVX2 std::size_t find_avx2(const unsigned char* const p,
+			const std::size_t n, const uint<W> bits) noexcept
+		{
+			constexpr std::size_t lanes = 32 / W;
+			constexpr unsigned none = Eq ? 0u : 0xFFFFFFFFu;
+			const __m256i v = broadcast_avx2<W>(bits);
+			std::size_t i = 0;
+			for (; i + 4 * lanes <= n; i += 4 * lanes) {
+				const unsigned char* const q = p + i * W;
+				const __m256i a = cmpeq_avx2<W>(load_avx2(q), v);
+				const __m256i b = cmpeq_avx2<W>(load_avx2(q + 32), v);
+				const __m256i c = cmpeq_avx2<W>(load_avx2(q + 64), v);
+				const __m256i d = cmpeq_avx2<W>(load_avx2(q + 96), v);
+				const __m256i any = Eq
+					? _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))
+					: _mm256_and_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, d));
+				if ((static_cast<unsigned>(_mm256_movemask_epi8(any)) ^ none) != 0) break;
+			}
+			for (; i + lanes <= n; i += lanes) {
+				const unsigned mask = static_cast<unsigned>(
+					_mm256_movemask_epi8(cmpeq_avx2<W>(load_avx2(p + i * W), v))) ^ none;
+				if (mask != 0) {
+					return i + static_cast<std::size_t>(__builtin_ctz(mask)) / W;
+				}
+			}
+			return i + find_sse2<Eq, W>(p + i * W, n - i, bits);
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_AVX2 inline __m256i sub_avx2(const __m256i a, const __m256i b) noexcept {
+			if constexpr (W == 1) return _mm256_sub_epi8(a, b);
+			else if constexpr (W == 2) return _mm256_sub_epi16(a, b);
+			else if constexpr (W == 4) return _mm256_sub_epi32(a, b);
+			else return _mm256_sub_epi64(a, b);
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_AVX2 std::size_t count_avx2(const unsigned char* const p,
+			const std::size_t n, const uint<W> bits) noexcept
+		{
+			constexpr std::size_t lanes = 32 / W;
+			const __m256i v = broadcast_avx2<W>(bits);
+			std::size_t count = 0;
+			std::size_t i = 0;
+			while (i + lanes <= n) {
+				const std::size_t stop = (n - i) / lanes > count_flush<W>
+					? i + count_flush<W> * lanes : n;
+				__m256i acc = _mm256_setzero_si256();
+				for (; i + lanes <= stop; i += lanes) {
+					acc = sub_avx2<W>(acc, cmpeq_avx2<W>(load_avx2(p + i * W), v));
+				}
+				uint<W> counters[lanes];
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(counters), acc);
+				for (const auto c : counters) count += c;
+			}
+			return count + count_sse2<W>(p + i * W, n - i, bits);
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_AVX512 inline __m512i broadcast_avx512(const uint<W> bits) noexcept {
+			if constexpr (W == 1) return _mm512_set1_epi8(static_cast<char>(bits));
+			else if constexpr (W == 2) return _mm512_set1_epi16(static_cast<short>(bits));
+			else if constexpr (W == 4) return _mm512_set1_epi32(static_cast<int>(bits));
+			else return _mm512_set1_epi64(static_cast<long long>(bits));
+		}
+
+		// One bit per lane, set where the lanes of a and b are equal (Eq)
+		// or differ (!Eq).
+		template<bool Eq, std::size_t W>
+		STL2_TARGET_AVX512 inline std::uint64_t cmp_avx512(const __m512i a, const __m512i b) noexcept {
+			if constexpr (W == 1) {
+				return Eq ? _mm512_cmpeq_epi8_mask(a, b) : _mm512_cmpneq_epi8_mask(a, b);
+			} else if constexpr (W == 2) {
+				return Eq ? _mm512_cmpeq_epi16_mask(a, b) : _mm512_cmpneq_epi16_mask(a, b);
+			} else if constexpr (W == 4) {
+				return Eq ? _mm512_cmpeq_epi32_mask(a, b) : _mm512_cmpneq_epi32_mask(a, b);
+			} else {
+				return Eq ? _mm512_cmpeq_epi64_mask(a, b) : _mm512_cmpneq_epi64_mask(a, b);
+			}
+		}
+
+		STL2_TARGET_AVX512 inline __m512i load_avx512(const unsigned char* const p) noexcept {
+			return _mm512_loadu_si512(p);
+		}
+
+		template<bool Eq, std::size_t W>
+		STL2_TARGET_AVX512 std::size_t find_avx512(const unsigned char* const p,
+			const std::size_t n, const uint<W> bits) noexcept
+		{
+			constexpr std::size_t lanes = 64 / W;
+			const __m512i v = broadcast_avx512<W>(bits);
+			std::size_t i = 0;
+			for (; i + 4 * lanes <= n; i += 4 * lanes) {
+				const unsigned char* const q = p + i * W;
+				const std::uint64_t a = cmp_avx512<Eq, W>(load_avx512(q), v);
+				const std::uint64_t b = cmp_avx512<Eq, W>(load_avx512(q + 64), v);
+				const std::uint64_t c = cmp_avx512<Eq, W>(load_avx512(q + 128), v);
+				const std::uint64_t d = cmp_avx512<Eq, W>(load_avx512(q + 192), v);
+				if ((a | b | c | d) != 0) break;
+			}
+			for (; i + lanes <= n; i += lanes) {
+				const std::uint64_t mask = cmp_avx512<Eq, W>(load_avx512(p + i * W), v);
+				if (mask != 0) {
+					return i + static_cast<std::size_t>(__builtin_ctzll(mask));
+				}
+			}
+			return i + find_avx2<Eq, W>(p + i * W, n - i, bits);
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_AVX512 std::size_t count_avx512(const unsigned char* const p,
+			const std::size_t n, const uint<W> bits) noexcept
+		{
+			constexpr std::size_t lanes = 64 / W;
+			const __m512i v = broadcast_avx512<W>(bits);
+			std::size_t count = 0;
+			std::size_t i = 0;
+			for (; i + lanes <= n; i += lanes) {
+				count += static_cast<std::size_t>(__builtin_popcountll(
+					cmp_avx512<true, W>(load_avx512(p + i * W), v)));
+			}
+			return count + count_avx2<W>(p + i * W, n - i, bits);
+		}
+
+		// The index of the first of the n bytes at a and b that differ, or n.
+		STL2_TARGET_SSE2 inline std::size_t mismatch_sse2(const unsigned char* const a,
+			const unsigned char* const b, const std::size_t n) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 64 <= n; i += 64) {
+				const __m128i e0 = _mm_cmpeq_epi8(load_sse2(a + i), load_sse2(b + i));
+				const __m128i e1 = _mm_cmpeq_epi8(load_sse2(a + i + 16), load_sse2(b + i + 16));
+				const __m128i e2 = _mm_cmpeq_epi8(load_sse2(a + i + 32), load_sse2(b + i + 32));
+				const __m128i e3 = _mm_cmpeq_epi8(load_sse2(a + i + 48), load_sse2(b + i + 48));
+				const __m128i all = _mm_and_si128(_mm_and_si128(e0, e1), _mm_and_si128(e2, e3));
+				if (_mm_movemask_epi8(all) != 0xFFFF) break;
+			}
+			for (; i + 16 <= n; i += 16) {
+				const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+					_mm_cmpeq_epi8(load_sse2(a + i), load_sse2(b + i)))) ^ 0xFFFFu;
+				if (mask != 0) {
+					return i + static_cast<std::size_t>(__builtin_ctz(mask));
+				}
+			}
+			for (; i < n && a[i] == b[i]; ++i) {}
+			return i;
+		}
+
+		STL2_TARGET_AVX2 inline std::size_t mismatch_avx2(const unsigned char* const a,
+			const unsigned char* const b, const std::size_t n) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 128 <= n; i += 128) {
+				const __m256i e0 = _mm256_cmpeq_epi8(load_avx2(a + i), load_avx2(b + i));
+				const __m256i e1 = _mm256_cmpeq_epi8(load_avx2(a + i + 32), load_avx2(b + i + 32));
+				const __m256i e2 = _mm256_cmpeq_epi8(load_avx2(a + i + 64), load_avx2(b + i + 64));
+				const __m256i e3 = _mm256_cmpeq_epi8(load_avx2(a + i + 96), load_avx2(b + i + 96));
+				const __m256i all = _mm256_and_si256(_mm256_and_si256(e0, e1),
+					_mm256_and_si256(e2, e3));
+				if (static_cast<unsigned>(_mm256_movemask_epi8(all)) != 0xFFFFFFFFu) break;
+			}
+			for (; i + 32 <= n; i += 32) {
+				const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+					_mm256_cmpeq_epi8(load_avx2(a + i), load_avx2(b + i)))) ^ 0xFFFFFFFFu;
+				if (mask != 0) {
+					return i + static_cast<std::size_t>(__builtin_ctz(mask));
+				}
+			}
+			return i + mismatch_sse2(a + i, b + i, n - i);
+		}
+
+		STL2_TARGET_AVX512 inline std::size_t mismatch_avx512(const unsigned char* const a,
+			const unsigned char* const b, const std::size_t n) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 256 <= n; i += 256) {
+				const std::uint64_t d0 = cmp_avx512<false, 1>(load_avx512(a + i), load_avx512(b + i));
+				const std::uint64_t d1 = cmp_avx512<false, 1>(load_avx512(a + i + 64),
+					load_avx512(b + i + 64));
+				const std::uint64_t d2 = cmp_avx512<false, 1>(load_avx512(a + i + 128),
+					load_avx512(b + i + 128));
+				const std::uint64_t d3 = cmp_avx512<false, 1>(load_avx512(a + i + 192),
+					load_avx512(b + i + 192));
+				if ((d0 | d1 | d2 | d3) != 0) break;
+			}
+			for (; i + 64 <= n; i += 64) {
+				const std::uint64_t mask = cmp_avx512<false, 1>(load_avx512(a + i),
+					load_avx512(b + i));
+				if (mask != 0) {
+					return i + static_cast<std::size_t>(__builtin_ctzll(mask));
+				}
+			}
+			return i + mismatch_avx2(a + i, b + i, n - i);
+		}
+
+		// As search_scalar, filtering a vector of positions at a time.
+		STL2_TARGET_SSE2 inline std::size_t search_sse2(byte_search& b, std::size_t i) noexcept {
+			const __m128i first = _mm_set1_epi8(static_cast<char>(b.s[0]));
+			const __m128i last = _mm_set1_epi8(static_cast<char>(b.s[b.m - 1]));
+			for (; i + 16 + b.m - 1 <= b.n; i += 16) {
+				const __m128i both = _mm_and_si128(
+					_mm_cmpeq_epi8(load_sse2(b.h + i), first),
+					_mm_cmpeq_epi8(load_sse2(b.h + i + b.m - 1), last));
+				for (unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(both));
+					mask != 0; mask &= mask - 1)
+				{
+					const std::size_t c = i + static_cast<std::size_t>(__builtin_ctz(mask));
+					if (b.verify(c)) return c;
+					if (b.over_budget(c)) return c + 1;
+				}
+			}
+			return search_scalar(b, i);
+		}
+
+		STL2_TARGET_AVX2 inline std::size_t search_avx2(byte_search& b, std::size_t i) noexcept {
+			const __m256i first = _mm256_set1_epi8(static_cast<char>(b.s[0]));
+			const __m256i last = _mm256_set1_epi8(static_cast<char>(b.s[b.m - 1]));
+			for (; i + 32 + b.m - 1 <= b.n; i += 32) {
+				const __m256i both = _mm256_and_si256(
+					_mm256_cmpeq_epi8(load_avx2(b.h + i), first),
+					_mm256_cmpeq_epi8(load_avx2(b.h + i + b.m - 1), last));
+				for (unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(both));
+					mask != 0; mask &= mask - 1)
+				{
+					const std::size_t c = i + static_cast<std::size_t>(__builtin_ctz(mask));
+					if (b.verify(c)) return c;
+					if (b.over_budget(c)) return c + 1;
+				}
+			}
+			return search_sse2(b, i);
+		}
+
+		STL2_TARGET_AVX512 inline std::size_t search_avx512(byte_search& b, std::size_t i) noexcept {
+			const __m512i first = _mm512_set1_epi8(static_cast<char>(b.s[0]));
+			const __m512i last = _mm512_set1_epi8(static_cast<char>(b.s[b.m - 1]));
+			for (; i + 64 + b.m - 1 <= b.n; i += 64) {
+				std::uint64_t mask = cmp_avx512<true, 1>(load_avx512(b.h + i), first) &
+					cmp_avx512<true, 1>(load_avx512(b.h + i + b.m - 1), last);
+				for (; mask != 0; mask &= mask - 1) {
+					const std::size_t c = i + static_cast<std::size_t>(__builtin_ctzll(mask));
+					if (b.verify(c)) return c;
+					if (b.over_budget(c)) return c + 1;
+				}
+			}
+			return search_avx2(b, i);
+		}
+
+		// Whether the block of W-byte elements at p[i] holds two equal
+		// elements, or starts with a copy of the one before it.
+		template<std::size_t W>
+		STL2_TARGET_SSE2 inline bool repeats_sse2(const unsigned char* const p,
+			const std::size_t i) noexcept
+		{
+			if (i == 0) return repeats_scalar<W>(p, 16 / W);
+			return _mm_movemask_epi8(cmpeq_sse2<W>(load_sse2(p + (i - 1) * W),
+				load_sse2(p + i * W))) != 0;
+		}
+
+		template<class T>
+		STL2_TARGET_SSE2 intersection_stop intersect_sse2(block_intersection<T>& s) noexcept {
+			constexpr std::size_t W = sizeof(T);
+			constexpr std::size_t lanes = 16 / W;
+			const auto a = reinterpret_cast<const unsigned char*>(s.a);
+			const auto b = reinterpret_cast<const unsigned char*>(s.b);
+			std::size_t i = s.i, j = s.j, count = s.count;
+			bool fresh_a = true, fresh_b = true;
+			auto stop = intersection_stop::tail;
+			while (i + lanes < s.na && j + lanes < s.nb) {
+				if (count + lanes > intersection_buffer) {
+					stop = intersection_stop::full;
+					break;
+				}
+				if ((fresh_a && repeats_sse2<W>(a, i)) || (fresh_b && repeats_sse2<W>(b, j))) {
+					stop = intersection_stop::duplicate;
+					break;
+				}
+				fresh_a = fresh_b = false;
+				const __m128i va = load_sse2(a + i * W);
+				__m128i any = _mm_setzero_si128();
+				for (std::size_t k = 0; k < lanes; ++k) {
+					any = _mm_or_si128(any, cmpeq_sse2<W>(va,
+						broadcast_sse2<W>(load<W>(b + (j + k) * W))));
+				}
+				auto mask = static_cast<unsigned>(W == 4
+					? _mm_movemask_ps(_mm_castsi128_ps(any))
+					: _mm_movemask_pd(_mm_castsi128_pd(any)));
+				for (; mask != 0; mask &= mask - 1) {
+					s.out[count++] = s.a[i + static_cast<std::size_t>(__builtin_ctz(mask))];
+				}
+				const T last_a = s.a[i + lanes - 1], last_b = s.b[j + lanes - 1];
+				if (!(last_b < last_a)) {
+					i += lanes;
+					fresh_a = true;
+				}
+				if (!(last_a < last_b)) {
+					j += lanes;
+					fresh_b = true;
+				}
+			}
+			s.i = i;
+			s.j = j;
+			s.count = count;
+			s.settle(!fresh_a, !fresh_b, lanes);
+			return stop;
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_AVX2 inline bool repeats_avx2(const unsigned char* const p,
+			const std::size_t i) noexcept
+		{
+			if (i == 0) return repeats_scalar<W>(p, 32 / W);
+			return _mm256_movemask_epi8(cmpeq_avx2<W>(load_avx2(p + (i - 1) * W),
+				load_avx2(p + i * W))) != 0;
+		}
+
+		template<class T>
+		STL2_TARGET_AVX2 intersection_stop intersect_avx2(block_intersection<T>& s) noexcept {
+			constexpr std::size_t W = sizeof(T);
+			constexpr std::size_t lanes = 32 / W;
+			const auto a = reinterpret_cast<const unsigned char*>(s.a);
+			const auto b = reinterpret_cast<const unsigned char*>(s.b);
+			std::size_t i = s.i, j = s.j, count = s.count;
+			bool fresh_a = true, fresh_b = true;
+			auto stop = intersection_stop::tail;
+			while (i + lanes < s.na && j + lanes < s.nb) {
+				if (count + lanes > intersection_buffer) {
+					stop = intersection_stop::full;
+					break;
+				}
+				if ((fresh_a && repeats_avx2<W>(a, i)) || (fresh_b && repeats_avx2<W>(b, j))) {
+					stop = intersection_stop::duplicate;
+					break;
+				}
+				fresh_a = fresh_b = false;
+				const __m256i va = load_avx2(a + i * W);
+				__m256i any = _mm256_setzero_si256();
+				for (std::size_t k = 0; k < lanes; ++k) {
+					any = _mm256_or_si256(any, cmpeq_avx2<W>(va,
+						broadcast_avx2<W>(load<W>(b + (j + k) * W))));
+				}
+				auto mask = static_cast<unsigned>(W == 4
+					? _mm256_movemask_ps(_mm256_castsi256_ps(any))
+					: _mm256_movemask_pd(_mm256_castsi256_pd(any)));
+				for (; mask != 0; mask &= mask - 1) {
+					s.out[count++] = s.a[i + static_cast<std::size_t>(__builtin_ctz(mask))];
+				}
+				const T last_a = s.a[i + lanes - 1], last_b = s.b[j + lanes - 1];
+				if (!(last_b < last_a)) {
+					i += lanes;
+					fresh_a = true;
+				}
+				if (!(last_a < last_b)) {
+					j += lanes;
+					fresh_b = true;
+				}
+			}
+			s.i = i;
+			s.j = j;
+			s.count = count;
+			s.settle(!fresh_a, !fresh_b, lanes);
+			return stop;
+		}
+
+		template<std::size_t W>
+		STL2_TARGET_AVX512 inline bool repeats_avx512(const unsigned char* const p,
+			const std::size_t i) noexcept
+		{
+			if (i == 0) return repeats_scalar<W>(p, 64 / W);
+			return cmp_avx512<true, W>(load_avx512(p + (i - 1) * W),
+				load_avx512(p + i * W)) != 0;
+		}
+
+		template<class T>
+		STL2_TARGET_AVX512 intersection_stop intersect_avx512(block_intersection<T>& s) noexcept {
+			constexpr std::size_t W = sizeof(T);
+			constexpr std::size_t lanes = 64 / W;
+			const auto a = reinterpret_cast<const unsigned char*>(s.a);
+			const auto b = reinterpret_cast<const unsigned char*>(s.b);
+			std::size_t i = s.i, j = s.j, count = s.count;
+			bool fresh_a = true, fresh_b = true;
+			auto stop = intersection_stop::tail;
+			while (i + lanes < s.na && j + lanes < s.nb) {
+				if (count + lanes > intersection_buffer) {
+					stop = intersection_stop::full;
+					break;
+				}
+				if ((fresh_a && repeats_avx512<W>(a, i)) || (fresh_b && repeats_avx512<W>(b, j))) {
+					stop = intersection_stop::duplicate;
+					break;
+				}
+				fresh_a = fresh_b = false;
+				const __m512i va = load_avx512(a + i * W);
+				std::uint64_t mask = 0;
+				for (std::size_t k = 0; k < lanes; ++k) {
+					mask |= cmp_avx512<true, W>(va,
+						broadcast_avx512<W>(load<W>(b + (j + k) * W)));
+				}
+				if constexpr (W == 4) {
+					_mm512_mask_compressstoreu_epi32(s.out + count,
+						static_cast<__mmask16>(mask), va);
+				} else {
+					_mm512_mask_compressstoreu_epi64(s.out + count,
+						static_cast<__mmask8>(mask), va);
+				}
+				count += static_cast<std::size_t>(__builtin_popcountll(mask));
+				const T last_a = s.a[i + lanes - 1], last_b = s.b[j + lanes - 1];
+				if (!(last_b < last_a)) {
+					i += lanes;
+					fresh_a = true;
+				}
+				if (!(last_a < last_b)) {
+					j += lanes;
+					fresh_b = true;
+				}
+			}
+			s.i = i;
+			s.j = j;
+			s.count = count;
+			s.settle(!fresh_a, !fresh_b, lanes);
+			return stop;
+		}
+
+		// Lane-wise a < b, as T orders, in all-ones lanes; SSE2 lacks the
+		// 8-byte integer comparison.
+		template<class T>
+		inline constexpr bool sse2_orderable = sizeof(T) <= 4 || !integral<T>;
+
+		template<class T>
+		STL2_TARGET_SSE2 inline __m128i less_sse2(const __m128i a, const __m128i b) noexcept {
+			constexpr std::size_t W = sizeof(T);
+			if constexpr (same_as<T, float>) {
+				return _mm_castps_si128(_mm_cmplt_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+			} else if constexpr (same_as<T, double>) {
+				return _mm_castpd_si128(_mm_cmplt_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+			} else if constexpr (!std::is_signed_v<T>) {
+				// Flipping the sign bits orders unsigned as signed.
+				const __m128i sign = broadcast_sse2<W>(uint<W>{1} << (8 * W - 1));
+				return less_sse2<std::make_signed_t<uint<W>>>(_mm_xor_si128(a, sign),
+					_mm_xor_si128(b, sign));
+			} else if constexpr (W == 1) {
+				return _mm_cmplt_epi8(a, b);
+			} else if constexpr (W == 2) {
+				return _mm_cmplt_epi16(a, b);
+			} else {
+				static_assert(W == 4);
+				return _mm_cmplt_epi32(a, b);
+			}
+		}
+
+		// Lane-wise, whether the elements a and b that follow them are equal
+		// (Rel == 0) or out of order.
+		template<int Rel, class T>
+		STL2_TARGET_SSE2 inline __m128i adjacent_hit_sse2(const __m128i a,
+			const __m128i b) noexcept
+		{
+			if constexpr (Rel == 0) return cmpeq_sse2<sizeof(T)>(a, b);
+			else if constexpr (Rel > 0) return less_sse2<T>(b, a);
+			else return less_sse2<T>(a, b);
+		}
+
+		// The adjacent pairs of adjacent_scalar, a vector of pairs at a time.
+		template<int Rel, class T>
+		STL2_TARGET_SSE2 std::size_t adjacent_sse2(const T* const first, std::size_t k,
+			const std::size_t n) noexcept
+		{
+			constexpr std::size_t W = sizeof(T);
+			constexpr std::size_t lanes = 16 / W;
+			if constexpr (Rel == 0 || sse2_orderable<T>) {
+				const auto p = reinterpret_cast<const unsigned char*>(first);
+				for (; k + lanes < n; k += lanes) {
+					const __m128i a = load_sse2(p + k * W);
+					const __m128i b = load_sse2(p + (k + 1) * W);
+					const auto mask = static_cast<unsigned>(
+						_mm_movemask_epi8(adjacent_hit_sse2<Rel, T>(a, b)));
+					if (mask != 0) {
+						return k + static_cast<std::size_t>(__builtin_ctz(mask)) / W;
+					}
+				}
+			}
+			return adjacent_scalar<Rel>(first, k, n);
+		}
+
+		template<class T>
+		STL2_TARGET_AVX2 inline __m256i less_avx2(const __m256i a, const __m256i b) noexcept {
+			constexpr std::size_t W = sizeof(T);
+			if constexpr (same_as<T, float>) {
+				return _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a),
+					_mm256_castsi256_ps(b), _CMP_LT_OQ));
+			} else if constexpr (same_as<T, double>) {
+				return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a),
+					_mm256_castsi256_pd(b), _CMP_LT_OQ));
+			} else if constexpr (!std::is_signed_v<T>) {
+				const __m256i sign = broadcast_avx2<W>(uint<W>{1} << (8 * W - 1));
+				return less_avx2<std::make_signed_t<uint<W>>>(_mm256_xor_si256(a, sign),
+					_mm256_xor_si256(b, sign));
+			} else if constexpr (W == 1) {
+				return _mm256_cmpgt_epi8(b, a);
+			} else if constexpr (W == 2) {
+				return _mm256_cmpgt_epi16(b, a);
+			} else if constexpr (W == 4) {
+				return _mm256_cmpgt_epi32(b, a);
+			} else {
+				return _mm256_cmpgt_epi64(b, a);
+			}
+		}
+
+		template<int Rel, class T>
+		STL2_TARGET_AVX2 inline __m256i adjacent_hit_avx2(const __m256i a,
+			const __m256i b) noexcept
+		{
+			if constexpr (Rel == 0) return cmpeq_avx2<sizeof(T)>(a, b);
+			else if constexpr (Rel > 0) return less_avx2<T>(b, a);
+			else return less_avx2<T>(a, b);
+		}
+
+		template<int Rel, class T>
+		STL2_TARGET_AVX2 std::size_t adjacent_avx2(const T* const first, std::size_t k,
+			const std::size_t n) noexcept
+		{
+			constexpr std::size_t W = sizeof(T);
+			constexpr std::size_t lanes = 32 / W;
+			const auto p = reinterpret_cast<const unsigned char*>(first);
+			for (; k + lanes < n; k += lanes) {
+				const __m256i a = load_avx2(p + k * W);
+				const __m256i b = load_avx2(p + (k + 1) * W);
+				const auto mask = static_cast<unsigned>(
+					_mm256_movemask_epi8(adjacent_hit_avx2<Rel, T>(a, b)));
+				if (mask != 0) {
+					return k + static_cast<std::size_t>(__builtin_ctz(mask)) / W;
+				}
+			}
+			return adjacent_sse2<Rel>(first, k, n);
+		}
+
+		// The extrema of the first n >= 32 / sizeof(T) elements at first, in
+		// r, a vector at a time: each lane keeps the extrema of its column
+		// of elements and their indices, updating the least only for a
+		// lesser element and the greatest for any not lesser, so that the
+		// lanes together hold the first least and the last greatest. Returns
+		// the number of elements taken, a multiple of the lanes; indices
+		// must fit in the lanes.
+		template<int Order, bool Min, bool Max, class T>
+		STL2_TARGET_AVX2 std::size_t extrema_avx2(const T* const first, const std::size_t n,
+			extrema& r) noexcept
+		{
+			constexpr std::size_t W = sizeof(T);
+			constexpr std::size_t lanes = 32 / W;
+			const auto p = reinterpret_cast<const unsigned char*>(first);
+			__m256i index = W == 4 ? _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+				: _mm256_setr_epi64x(0, 1, 2, 3);
+			const __m256i step = broadcast_avx2<W>(lanes);
+			__m256i min = load_avx2(p), max = min, min_at = index, max_at = index;
+			std::size_t i = lanes;
+			for (; i + lanes <= n; i += lanes) {
+				index = W == 4 ? _mm256_add_epi32(index, step) : _mm256_add_epi64(index, step);
+				const __m256i v = load_avx2(p + i * W);
+				if constexpr (Min) {
+					const __m256i less = Order > 0 ? less_avx2<T>(v, min) : less_avx2<T>(min, v);
+					min = _mm256_blendv_epi8(min, v, less);
+					min_at = _mm256_blendv_epi8(min_at, index, less);
+				}
+				if constexpr (Max) {
+					const __m256i less = Order > 0 ? less_avx2<T>(v, max) : less_avx2<T>(max, v);
+					max = _mm256_blendv_epi8(v, max, less);
+					max_at = _mm256_blendv_epi8(index, max_at, less);
+				}
+			}
+			T values[lanes];
+			uint<W> at[lanes];
+			if constexpr (Min) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(values), min);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(at), min_at);
+				r.min = extremum_of_lanes<Order, false>(values, at, lanes);
+			}
+			if constexpr (Max) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(values), max);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(at), max_at);
+				r.max = extremum_of_lanes<Order, true>(values, at, lanes);
+			}
+			return i;
+		}
+
+		template<class T>
+		STL2_TARGET_AVX512 inline std::uint64_t less_avx512(const __m512i a,
+			const __m512i b) noexcept
+		{
+			constexpr std::size_t W = sizeof(T);
+			constexpr bool sign = std::is_signed_v<T>;
+			if constexpr (same_as<T, float>) {
+				return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b),
+					_CMP_LT_OQ);
+			} else if constexpr (same_as<T, double>) {
+				return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b),
+					_CMP_LT_OQ);
+			} else if constexpr (W == 1) {
+				return sign ? _mm512_cmplt_epi8_mask(a, b) : _mm512_cmplt_epu8_mask(a, b);
+			} else if constexpr (W == 2) {
+				return sign ? _mm512_cmplt_epi16_mask(a, b) : _mm512_cmplt_epu16_mask(a, b);
+			} else if constexpr (W == 4) {
+				return sign ? _mm512_cmplt_epi32_mask(a, b) : _mm512_cmplt_epu32_mask(a, b);
+			} else {
+				return sign ? _mm512_cmplt_epi64_mask(a, b) : _mm512_cmplt_epu64_mask(a, b);
+			}
+		}
+
+		template<int Rel, class T>
+		STL2_TARGET_AVX512 inline std::uint64_t adjacent_hit_avx512(const __m512i a,
+			const __m512i b) noexcept
+		{
+			if constexpr (Rel == 0) return cmp_avx512<true, sizeof(T)>(a, b);
+			else if constexpr (Rel > 0) return less_avx512<T>(b, a);
+			else return less_avx512<T>(a, b);
+		}
+
+		template<int Rel, class T>
+		STL2_TARGET_AVX512 std::size_t adjacent_avx512(const T* const first, std::size_t k,
+			const std::size_t n) noexcept
+		{
+			constexpr std::size_t W = sizeof(T);
+			constexpr std::size_t lanes = 64 / W;
+			const auto p = reinterpret_cast<const unsigned char*>(first);
+			for (; k + lanes < n; k += lanes) {
+				const __m512i a = load_avx512(p + k * W);
+				const __m512i b = load_avx512(p + (k + 1) * W);
+				const std::uint64_t mask = adjacent_hit_avx512<Rel, T>(a, b);
+				if (mask != 0) {
+					return k + static_cast<std::size_t>(__builtin_ctzll(mask));
+				}
+			}
+			return adjacent_avx2<Rel>(first, k, n);
+		}
+
+		template<int Order, bool Min, bool Max, class T>
+		STL2_TARGET_AVX512 std::size_t extrema_avx512(const T* const first,
+			const std::size_t n, extrema& r) noexcept
+		{
+			constexpr std::size_t W = sizeof(T);
+			constexpr std::size_t lanes = 64 / W;
+			const auto p = reinterpret_cast<const unsigned char*>(first);
+			__m512i index = W == 4
+				? _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+				: _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+			const __m512i step = broadcast_avx512<W>(lanes);
+			__m512i min = load_avx512(p), max = min, min_at = index, max_at = index;
+			std::size_t i = lanes;
+			for (; i + lanes <= n; i += lanes) {
+				index = W == 4 ? _mm512_add_epi32(index, step) : _mm512_add_epi64(index, step);
+				const __m512i v = load_avx512(p + i * W);
+				if constexpr (Min) {
+					const std::uint64_t less = Order > 0
+						? less_avx512<T>(v, min) : less_avx512<T>(min, v);
+					if constexpr (W == 4) {
+						min = _mm512_mask_mov_epi32(min, static_cast<__mmask16>(less), v);
+						min_at = _mm512_mask_mov_epi32(min_at, static_cast<__mmask16>(less), index);
+					} else {
+						min = _mm512_mask_mov_epi64(min, static_cast<__mmask8>(less), v);
+						min_at = _mm512_mask_mov_epi64(min_at, static_cast<__mmask8>(less), index);
+					}
+				}
+				if constexpr (Max) {
+					const std::uint64_t not_less = ~(Order > 0
+						? less_avx512<T>(v, max) : less_avx512<T>(max, v));
+					if constexpr (W == 4) {
+						max = _mm512_mask_mov_epi32(max, static_cast<__mmask16>(not_less), v);
+						max_at = _mm512_mask_mov_epi32(max_at, static_cast<__mmask16>(not_less),
+							index);
+					} else {
+						max = _mm512_mask_mov_epi64(max, static_cast<__mmask8>(not_less), v);
+						max_at = _mm512_mask_mov_epi64(max_at, static_cast<__mmask8>(not_less),
+							index);
+					}
+				}
+			}
+			T values[lanes];
+			uint<W> at[lanes];
+			if constexpr (Min) {
+				_mm512_storeu_si512(values, min);
+				_mm512_storeu_si512(at, min_at);
+				r.min = extremum_of_lanes<Order, false>(values, at, lanes);
+			}
+			if constexpr (Max) {
+				_mm512_storeu_si512(values, max);
+				_mm512_storeu_si512(at, max_at);
+				r.max = extremum_of_lanes<Order, true>(values, at, lanes);
+			}
+			return i;
+		}
+
+		// Copies the bytes at src to dst, whose lines are filled by
+		// streaming stores that bypass the cache, once dst is aligned.
+		STL2_TARGET_SSE2 inline void stream_sse2(unsigned char* dst, const unsigned char* src,
+			std::size_t bytes) noexcept
+		{
+			const std::size_t head = (16 - reinterpret_cast<std::uintptr_t>(dst) % 16) % 16;
+			std::memcpy(dst, src, head);
+			dst += head, src += head, bytes -= head;
+			for (; bytes >= 64; dst += 64, src += 64, bytes -= 64) {
+				for (std::size_t k = 0; k < 64; k += 16) {
+					_mm_stream_si128(reinterpret_cast<__m128i*>(dst + k), load_sse2(src + k));
+				}
+			}
+			_mm_sfence();
+			std::memcpy(dst, src, bytes);
+		}
+
+		STL2_TARGET_AVX2 inline void stream_avx2(unsigned char* dst, const unsigned char* src,
+			std::size_t bytes) noexcept
+		{
+			const std::size_t head = (32 - reinterpret_cast<std::uintptr_t>(dst) % 32) % 32;
+			std::memcpy(dst, src, head);
+			dst += head, src += head, bytes -= head;
+			for (; bytes >= 128; dst += 128, src += 128, bytes -= 128) {
+				for (std::size_t k = 0; k < 128; k += 32) {
+					_mm256_stream_si256(reinterpret_cast<__m256i*>(dst + k), load_avx2(src + k));
+				}
+			}
+			_mm_sfence();
+			std::memcpy(dst, src, bytes);
+		}
+
+		STL2_TARGET_AVX512 inline void stream_avx512(unsigned char* dst,
+			const unsigned char* src, std::size_t bytes) noexcept
+		{
+			const std::size_t head = (64 - reinterpret_cast<std::uintptr_t>(dst) % 64) % 64;
+			std::memcpy(dst, src, head);
+			dst += head, src += head, bytes -= head;
+			for (; bytes >= 256; dst += 256, src += 256, bytes -= 256) {
+				for (std::size_t k = 0; k < 256; k += 64) {
+					_mm512_stream_si512(reinterpret_cast<__m512i*>(dst + k), load_avx512(src + k));
+				}
+			}
+			_mm_sfence();
+			std::memcpy(dst, src, bytes);
+		}
+
+		// Sets the bytes at dst to byte, by streaming stores once dst is
+		// aligned.
+		STL2_TARGET_SSE2 inline void stream_fill_sse2(unsigned char* dst,
+			const unsigned char byte, std::size_t bytes) noexcept
+		{
+			const std::size_t head = (16 - reinterpret_cast<std::uintptr_t>(dst) % 16) % 16;
+			std::memset(dst, byte, head);
+			dst += head, bytes -= head;
+			const __m128i v = broadcast_sse2<1>(byte);
+			for (; bytes >= 64; dst += 64, bytes -= 64) {
+				for (std::size_t k = 0; k < 64; k += 16) {
+					_mm_stream_si128(reinterpret_cast<__m128i*>(dst + k), v);
+				}
+			}
+			_mm_sfence();
+			std::memset(dst, byte, bytes);
+		}
+
+		STL2_TARGET_AVX2 inline void stream_fill_avx2(unsigned char* dst,
+			const unsigned char byte, std::size_t bytes) noexcept
+		{
+			const std::size_t head = (32 - reinterpret_cast<std::uintptr_t>(dst) % 32) % 32;
+			std::memset(dst, byte, head);
+			dst += head, bytes -= head;
+			const __m256i v = broadcast_avx2<1>(byte);
+			for (; bytes >= 128; dst += 128, bytes -= 128) {
+				for (std::size_t k = 0; k < 128; k += 32) {
+					_mm256_stream_si256(reinterpret_cast<__m256i*>(dst + k), v);
+				}
+			}
+			_mm_sfence();
+			std::memset(dst, byte, bytes);
+		}
+
+		STL2_TARGET_AVX512 inline void stream_fill_avx512(unsigned char* dst,
+			const unsigned char byte, std::size_t bytes) noexcept
+		{
+			const std::size_t head = (64 - reinterpret_cast<std::uintptr_t>(dst) % 64) % 64;
+			std::memset(dst, byte, head);
+			dst += head, bytes -= head;
+			const __m512i v = broadcast_avx512<1>(byte);
+			for (; bytes >= 256; dst += 256, bytes -= 256) {
+				for (std::size_t k = 0; k < 256; k += 64) {
+					_mm512_stream_si512(reinterpret_cast<__m512i*>(dst + k), v);
+				}
+			}
+			_mm_sfence();
+			std::memset(dst, byte, bytes);
+		}
+#endif // STL2_SIMD_X86
+
+		// The index of the first of the n elements at first that is equal
+		// (Eq) or not equal (!Eq) to value, or n if there is none.
+		template<bool Eq, bitwise_comparable T>
+		std::size_t find(const T* const first, const std::size_t n, const T value) noexcept {
+			constexpr std::size_t W = sizeof(T);
+			const auto p = reinterpret_cast<const unsigned char*>(first);
+#if STL2_SIMD_X86
+			switch (active_isa()) {
+			case isa::avx512: return find_avx512<Eq, W>(p, n, bits_of(value));
+			case isa::avx2: return find_avx2<Eq, W>(p, n, bits_of(value));
+			case isa::sse2: return find_sse2<Eq, W>(p, n, bits_of(value));
+			case isa::scalar: break;
+			}
+#else
+			if constexpr (Eq && W == 1) {
+				const void* const pos = std::memchr(p, bits_of(value), n);
+				return pos ? static_cast<std::size_t>(static_cast<const unsigned char*>(pos) - p) : n;
+			}
+#endif
+			return find_scalar<Eq, W>(p, 0, n, bits_of(value));
+		}
+
+		// The number of the n elements at first that are equal to value.
+		template<bitwise_comparable T>
+		std::size_t count(const T* const first, const std::size_t n, const T value) noexcept {
+			constexpr std::size_t W = sizeof(T);
+			const auto p = reinterpret_cast<const unsigned char*>(first);
+#if STL2_SIMD_X86
+			switch (active_isa()) {
+			case isa::avx512: return count_avx512<W>(p, n, bits_of(value));
+			case isa::avx2: return count_avx2<W>(p, n, bits_of(value));
+			case isa::sse2: return count_sse2<W>(p, n, bits_of(value));
+			case isa::scalar: break;
+			}
+#endif
+			return count_scalar<W>(p, 0, n, bits_of(value));
+		}
+
+		// The index of the first of the n elements at a and b that differ,
+		// or n. Elements are equal exactly when all their bytes are, so the
+		// first differing byte lies in the first differing element.
+		template<bitwise_comparable T>
+		std::size_t mismatch(const T* const a, const T* const b, const std::size_t n) noexcept {
+#if STL2_SIMD_X86
+			const auto p = reinterpret_cast<const unsigned char*>(a);
+			const auto q = reinterpret_cast<const unsigned char*>(b);
+			const std::size_t bytes = n * sizeof(T);
+			switch (active_isa()) {
+			case isa::avx512: return mismatch_avx512(p, q, bytes) / sizeof(T);
+			case isa::avx2: return mismatch_avx2(p, q, bytes) / sizeof(T);
+			case isa::sse2: return mismatch_sse2(p, q, bytes) / sizeof(T);
+			case isa::scalar: break;
+			}
+#endif
+			std::size_t i = 0;
+			for (; i < n && a[i] == b[i]; ++i) {}
+			return i;
+		}
+
+		// The search through b from its start, as search_scalar.
+		inline std::size_t search(byte_search& b) noexcept {
+#if STL2_SIMD_X86
+			switch (active_isa()) {
+			case isa::avx512: return search_avx512(b, 0);
+			case isa::avx2: return search_avx2(b, 0);
+			case isa::sse2: return search_sse2(b, 0);
+			case isa::scalar: break;
+			}
+#endif
+			return search_scalar(b, 0);
+		}
+
+		// A run of the intersection of s from [s.i, s.j).
+		template<class T>
+		intersection_stop intersect(block_intersection<T>& s) noexcept {
+#if STL2_SIMD_X86
+			switch (active_isa()) {
+			case isa::avx512: return intersect_avx512(s);
+			case isa::avx2: return intersect_avx2(s);
+			case isa::sse2: return intersect_sse2(s);
+			case isa::scalar: break;
+			}
+#endif
+			return intersection_stop::tail;
+		}
+
+		// The least k for which the elements first[k] and first[k + 1] of
+		// the n at first are equal (Rel == 0) or, in ascending (Rel > 0)
+		// or descending order, out of order, or n if there is none.
+		template<int Rel, class T>
+		std::size_t adjacent(const T* const first, const std::size_t n) noexcept {
+#if STL2_SIMD_X86
+			switch (active_isa()) {
+			case isa::avx512: return adjacent_avx512<Rel>(first, 0, n);
+			case isa::avx2: return adjacent_avx2<Rel>(first, 0, n);
+			case isa::sse2: return adjacent_sse2<Rel>(first, 0, n);
+			case isa::scalar: break;
+			}
+#endif
+			return adjacent_scalar<Rel>(first, 0, n);
+		}
+
+		// The elements a kernel may index, in lanes of 4 bytes for 4-byte
+		// elements: a longer range is taken in pieces of this many.
+		template<class T>
+		inline constexpr std::size_t extrema_piece = sizeof(T) == 4
+			? std::size_t{1} << 31 : ~std::size_t{0};
+
+		// The first least (Min) and last greatest (Max) of the n >= 1
+		// elements at first, in ascending (Order > 0) or descending order.
+		// The kernels take whole vectors, a piece at a time, and the
+		// extrema of each piece are folded into those of the pieces before
+		// it as single elements would be.
+		template<int Order, bool Min, bool Max, class T>
+		extrema find_extrema(const T* const first, const std::size_t n) noexcept {
+			extrema r;
+			std::size_t i = 0;
+#if STL2_SIMD_X86
+			const isa level = active_isa();
+			if (level >= isa::avx2) {
+				const std::size_t lanes = (level == isa::avx512 ? 64 : 32) / sizeof(T);
+				while (n - i >= lanes) {
+					const std::size_t m = n - i < extrema_piece<T> ? n - i : extrema_piece<T>;
+					extrema piece;
+					const std::size_t done = level == isa::avx512
+						? extrema_avx512<Order, Min, Max>(first + i, m, piece)
+						: extrema_avx2<Order, Min, Max>(first + i, m, piece);
+					if (Min && before<Order>(first[i + piece.min], first[r.min])) {
+						r.min = i + piece.min;
+					}
+					if (Max && !before<Order>(first[i + piece.max], first[r.max])) {
+						r.max = i + piece.max;
+					}
+					i += done;
+				}
+			}
+#endif
+			extrema_scalar<Order, Min, Max>(first, i, n, r);
+			return r;
+		}
+
+		// Copies and fills of at least this many bytes (copies that do not
+		// overlap) write their destination by streaming stores: they would
+		// evict more of the cache than they could use, and streaming stores
+		// do not first read the lines they fill.
+		inline constexpr std::size_t stream_threshold = std::size_t{1} << 23;
+
+		// memmove.
+		inline void copy_bytes(void* const dst, const void* const src,
+			const std::size_t bytes) noexcept
+		{
+#if STL2_SIMD_X86
+			const auto d = reinterpret_cast<std::uintptr_t>(dst);
+			const auto s = reinterpret_cast<std::uintptr_t>(src);
+			if (bytes >= stream_threshold && (d + bytes <= s || s + bytes <= d)) {
+				const auto to = static_cast<unsigned char*>(dst);
+				const auto from = static_cast<const unsigned char*>(src);
+				switch (active_isa()) {
+				case isa::avx512: return stream_avx512(to, from, bytes);
+				case isa::avx2: return stream_avx2(to, from, bytes);
+				case isa::sse2: return stream_sse2(to, from, bytes);
+				case isa::scalar: break;
+				}
+			}
+#endif
+			std::memmove(dst, src, bytes);
+		}
+
+		// memset.
+		inline void fill_bytes(void* const dst, const unsigned char byte,
+			const std::size_t bytes) noexcept
+		{
+#if STL2_SIMD_X86
+			if (bytes >= stream_threshold) {
+				const auto to = static_cast<unsigned char*>(dst);
+				switch (active_isa()) {
+				case isa::avx512: return stream_fill_avx512(to, byte, bytes);
+				case isa::avx2: return stream_fill_avx2(to, byte, bytes);
+				case isa::sse2: return stream_fill_sse2(to, byte, bytes);
+				case isa::scalar: break;
+				}
+			}
+#endif
+			std::memset(dst, byte, bytes);
+		}
+
+		// equal, mismatch and lexicographical_compare over n elements at
+		// contiguous iterators, as the kernels see them.
+		template<class I1, class I2>
+		bool equal_n(const I1 first1, const I2 first2, const std::size_t n) noexcept {
+			return n == 0 || std::memcmp(std::addressof(*first1), std::addressof(*first2),
+				n * sizeof(iter_value_t<I1>)) == 0;
+		}
+
+		template<class I1, class I2>
+		iter_difference_t<I1> mismatch_n(const I1 first1, const I2 first2,
+			const std::size_t n) noexcept
+		{
+			if (n == 0) return 0;
+			return static_cast<iter_difference_t<I1>>(
+				simd::mismatch(std::addressof(*first1), std::addressof(*first2), n));
+		}
+
+		// Orders [first1, first1 + n1) and [first2, first2 + n2) as
+		// lexicographical_compare does, ascending if Order > 0, else
+		// descending. Single unsigned bytes are ordered by memcmp; anything
+		// else is compared at the first mismatch.
+		template<int Order, class I1, class I2>
+		bool lexicographical_compare_n(const I1 first1, const std::size_t n1,
+			const I2 first2, const std::size_t n2) noexcept
+		{
+			using V = iter_value_t<I1>;
+			const std::size_t n = n1 < n2 ? n1 : n2;
+			if (n != 0) {
+				const V* const a = std::addressof(*first1);
+				const V* const b = std::addressof(*first2);
+				if constexpr (sizeof(V) == 1 && (same_as<V, std::byte> ||
+					(integral<V> && !std::is_signed_v<V>)))
+				{
+					const int r = std::memcmp(a, b, n);
+					if (r != 0) return Order > 0 ? r < 0 : r > 0;
+				} else {
+					const std::size_t i = simd::mismatch(a, b, n);
+					if (i != n) return Order > 0 ? a[i] < b[i] : b[i] < a[i];
+				}
+			}
+			return n1 < n2;
+		}
+
+		// find and find_if_not for value_scannable iterators.
+		template<bool Eq, class I, class S, class T>
+		I find_value(I first, const S last, const T& value) {
+			using V = iter_value_t<I>;
+			const auto n = last - first;
+			if (n == 0) return first;
+			V v;
+			if (!simd::narrow(value, v)) {
+				return Eq ? first + n : first;
+			}
+			const V* const p = std::addressof(*first);
+			return first + static_cast<iter_difference_t<I>>(
+				simd::find<Eq>(p, static_cast<std::size_t>(n), v));
+		}
+
+		template<class I, class S, class T>
+		iter_difference_t<I> count_value(const I first, const S last, const T& value) {
+			using V = iter_value_t<I>;
+			const auto n = last - first;
+			V v;
+			if (n == 0 || !simd::narrow(value, v)) return 0;
+			return static_cast<iter_difference_t<I>>(
+				simd::count(std::addressof(*first), static_cast<std::size_t>(n), v));
+		}
+
+		// adjacent and find_extrema over n elements at a contiguous
+		// iterator.
+		template<int Rel, class I>
+		std::size_t adjacent_n(const I first, const std::size_t n) noexcept {
+			return n == 0 ? 0 : simd::adjacent<Rel>(std::addressof(*first), n);
+		}
+
+		template<int Order, bool Min, bool Max, class I>
+		extrema extrema_n(const I first, const std::size_t n) noexcept {
+			if (n == 0) return {};
+			return simd::find_extrema<Order, Min, Max>(std::addressof(*first), n);
+		}
+	} // namespace detail::simd
+} STL2_CLOSE_NAMESPACE
+
+#endif
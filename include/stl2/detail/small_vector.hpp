@@ -0,0 +1,296 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SMALL_VECTOR_HPP
+#define STL2_DETAIL_SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/inplace_vector.hpp>
+#include <stl2/detail/memory/construct_at.hpp>
+#include <stl2/detail/memory/destroy.hpp>
+#include <stl2/detail/memory/relocate.hpp>
+#include <stl2/detail/memory/uninitialized_copy.hpp>
+#include <stl2/detail/memory/uninitialized_move.hpp>
+
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		///////////////////////////////////////////////////////////////////////////
+		// small_vector [Extension]
+		//
+		// A vector that holds up to N elements within itself, and more in
+		// storage from Alloc. The elements are constructed in place rather
+		// than by the allocator's construct. Growing relocates them: by
+		// copying their bytes if they are trivially relocatable, by moving
+		// them if that cannot throw, and otherwise by copying them.
+		//
+		template<destructible T, std::size_t N, class Alloc = std::allocator<T>>
+		requires std::is_object_v<T>
+		class small_vector
+		: public detail::vector_interface<small_vector<T, N, Alloc>, T> {
+			friend detail::vector_interface<small_vector, T>;
+
+			using traits = std::allocator_traits<Alloc>;
+			static_assert(same_as<typename traits::value_type, T>);
+			static_assert(same_as<typename traits::pointer, T*>,
+				"small_vector requires an allocator of plain pointers.");
+
+			detail::inline_storage<T, N> storage_;
+			T* data_ = storage_.data();
+			std::size_t size_ = 0;
+			std::size_t capacity_ = N;
+			STL2_NO_UNIQUE_ADDRESS Alloc alloc_;
+
+			bool is_inline() const noexcept {
+				return data_ == storage_.data();
+			}
+
+			void set_size_(const std::size_t n) noexcept {
+				size_ = n;
+			}
+
+			// The capacity to grow to, for room for n elements.
+			std::size_t next_capacity(const std::size_t n) const {
+				const auto most = max_size();
+				if (n > most) throw std::length_error{"small_vector too long"};
+				return capacity_ > most / 2 ? most : std::max(n, 2 * capacity_);
+			}
+
+			// Moves the elements to the storage from out.
+			void move_elements(T* const out) {
+				if constexpr (trivially_relocatable<T> ||
+					std::is_nothrow_move_constructible_v<T> || !copy_constructible<T>)
+				{
+					detail::relocate_elements(data_, size_, out);
+				} else {
+					uninitialized_copy(data_, data_ + size_, out, out + size_);
+					destroy(data_, data_ + size_);
+				}
+			}
+
+			void deallocate() noexcept {
+				if (!is_inline()) {
+					traits::deallocate(alloc_, data_, capacity_);
+					data_ = storage_.data();
+					capacity_ = N;
+				}
+			}
+
+			// Moves the elements to new storage for n.
+			void reallocate(const std::size_t n) {
+				T* const p = traits::allocate(alloc_, n);
+				try {
+					move_elements(p);
+				} catch (...) {
+					traits::deallocate(alloc_, p, n);
+					throw;
+				}
+				deallocate();
+				data_ = p;
+				capacity_ = n;
+			}
+
+			void reserve_(const std::size_t n) {
+				if (n > capacity_) reallocate(next_capacity(n));
+			}
+
+			template<class... Args>
+			T& grow_emplace_back_(Args&&... args) {
+				const auto n = next_capacity(size_ + 1);
+				T* const p = traits::allocate(alloc_, n);
+				T* const e = p + size_;
+				try {
+					// Before the elements move: args may refer to one.
+					__stl2::__construct_at(*e, std::forward<Args>(args)...);
+				} catch (...) {
+					traits::deallocate(alloc_, p, n);
+					throw;
+				}
+				try {
+					move_elements(p);
+				} catch (...) {
+					destroy_at(e);
+					traits::deallocate(alloc_, p, n);
+					throw;
+				}
+				deallocate();
+				data_ = p;
+				capacity_ = n;
+				++size_;
+				return *e;
+			}
+
+			// Takes the elements of that, which is left empty.
+			void steal(small_vector& that)
+			noexcept(std::is_nothrow_move_constructible_v<T> || trivially_relocatable<T>)
+			{
+				STL2_EXPECT(size_ == 0);
+				if (that.is_inline()) {
+					STL2_EXPECT(that.size_ <= capacity_);
+					detail::relocate_elements(that.data_, that.size_, data_);
+				} else {
+					deallocate();
+					data_ = std::exchange(that.data_, that.storage_.data());
+					capacity_ = std::exchange(that.capacity_, N);
+				}
+				size_ = std::exchange(that.size_, 0);
+			}
+
+			template<class F>
+			void initialize(F f) {
+				try {
+					f();
+				} catch (...) {
+					this->clear();
+					deallocate();
+					throw;
+				}
+			}
+
+		public:
+			using allocator_type = Alloc;
+
+			small_vector() = default;
+			explicit small_vector(const Alloc& a) noexcept
+			: alloc_(a) {}
+			explicit small_vector(const std::size_t n, const Alloc& a = Alloc())
+			requires default_initializable<T>
+			: alloc_(a)
+			{
+				initialize([&] { this->resize(n); });
+			}
+			small_vector(const std::size_t n, const T& x, const Alloc& a = Alloc())
+			requires copyable<T>
+			: alloc_(a)
+			{
+				initialize([&] { this->assign(n, x); });
+			}
+			template<input_iterator I, sentinel_for<I> S>
+			requires constructible_from<T, iter_reference_t<I>>
+			small_vector(I first, S last, const Alloc& a = Alloc())
+			: alloc_(a)
+			{
+				initialize([&] { this->append(std::move(first), std::move(last)); });
+			}
+			small_vector(std::initializer_list<T> il, const Alloc& a = Alloc())
+			requires copy_constructible<T>
+			: small_vector(il.begin(), il.end(), a) {}
+
+			small_vector(const small_vector& that) requires copy_constructible<T>
+			: alloc_(traits::select_on_container_copy_construction(that.alloc_))
+			{
+				initialize([&] { this->append(that.begin(), that.end()); });
+			}
+			small_vector(small_vector&& that)
+			noexcept(std::is_nothrow_move_constructible_v<T> || trivially_relocatable<T>)
+			requires move_constructible<T>
+			: alloc_(std::move(that.alloc_))
+			{
+				initialize([&] { steal(that); });
+			}
+
+			small_vector& operator=(const small_vector& that) requires copyable<T> {
+				if (this != &that) {
+					if constexpr (traits::propagate_on_container_copy_assignment::value) {
+						if (alloc_ != that.alloc_) {
+							this->clear();
+							deallocate();
+						}
+						alloc_ = that.alloc_;
+					}
+					this->assign(that.begin(), that.end());
+				}
+				return *this;
+			}
+			small_vector& operator=(small_vector&& that)
+			noexcept((std::is_nothrow_move_constructible_v<T> || trivially_relocatable<T>) &&
+				(traits::propagate_on_container_move_assignment::value ||
+					traits::is_always_equal::value))
+			requires move_constructible<T>
+			{
+				if (this != &that) {
+					this->clear();
+					if constexpr (traits::propagate_on_container_move_assignment::value) {
+						deallocate();
+						alloc_ = std::move(that.alloc_);
+					} else if constexpr (!traits::is_always_equal::value) {
+						if (alloc_ != that.alloc_) {
+							// Its storage is not ours to take.
+							reserve_(that.size_);
+							detail::relocate_elements(that.data_, that.size_, data_);
+							size_ = std::exchange(that.size_, 0);
+							return *this;
+						}
+					}
+					steal(that);
+				}
+				return *this;
+			}
+
+			~small_vector() {
+				this->clear();
+				deallocate();
+			}
+
+			T* data() noexcept { return data_; }
+			const T* data() const noexcept { return data_; }
+			std::size_t size() const noexcept { return size_; }
+			std::size_t capacity() const noexcept { return capacity_; }
+			std::size_t max_size() const noexcept {
+				return std::min<std::size_t>(traits::max_size(alloc_), PTRDIFF_MAX / sizeof(T));
+			}
+			allocator_type get_allocator() const noexcept {
+				return alloc_;
+			}
+
+			void reserve(const std::size_t n) {
+				if (n > max_size()) throw std::length_error{"small_vector too long"};
+				if (n > capacity_) reallocate(n);
+			}
+			// Moves the elements back inside, if they fit, or else to
+			// storage for just as many.
+			void shrink_to_fit() {
+				if (is_inline() || size_ == capacity_) return;
+				if (size_ <= N) {
+					T* const p = data_;
+					move_elements(storage_.data());
+					traits::deallocate(alloc_, p, capacity_);
+					data_ = storage_.data();
+					capacity_ = N;
+				} else {
+					reallocate(size_);
+				}
+			}
+
+			void swap(small_vector& that)
+			noexcept(noexcept(std::declval<small_vector&>() = std::declval<small_vector>()))
+			requires move_constructible<T>
+			{
+				auto tmp = std::move(that);
+				that = std::move(*this);
+				*this = std::move(tmp);
+			}
+
+			friend void swap(small_vector& x, small_vector& y) noexcept(noexcept(x.swap(y)))
+			requires move_constructible<T>
+			{
+				x.swap(y);
+			}
+		};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
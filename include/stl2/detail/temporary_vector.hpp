@@ -12,77 +12,75 @@
 #ifndef STL2_DETAIL_TEMPORARY_VECTOR_HPP
 #define STL2_DETAIL_TEMPORARY_VECTOR_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
 #include <stl2/type_traits.hpp>
 #include <stl2/utility.hpp>
 #include <stl2/detail/construct_destruct.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/algorithm/for_each.hpp>
 #include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/memory/scratch_resource.hpp>
 
 STL2_OPEN_NAMESPACE {
 	namespace detail {
-		struct temporary_buffer_deleter {
-			template<class T>
-			void operator()(T* ptr) const {
-				std::return_temporary_buffer(ptr);
-			}
-		};
-
+		// Uninitialized storage for up to size() Ts from the scratch
+		// resource of the calling thread, which, like
+		// std::get_temporary_buffer, settles for less when memory is short.
 		template<class T>
 		class temporary_buffer {
-			std::unique_ptr<T, temporary_buffer_deleter> alloc_;
+			std::pmr::memory_resource* resource_ = nullptr;
+			T* data_ = nullptr;
 			std::ptrdiff_t size_ = 0;
 
-			temporary_buffer(std::pair<T*, std::ptrdiff_t> buf)
-			: alloc_{buf.first}, size_{buf.second} {}
+			void reset() noexcept {
+				if (data_) {
+					resource_->deallocate(data_, static_cast<std::size_t>(size_) * sizeof(T),
+						alignof(T));
+					data_ = nullptr;
+					size_ = 0;
+				}
+			}
 
 		public:
 			temporary_buffer() = default;
 			temporary_buffer(std::ptrdiff_t n)
-			: temporary_buffer(std::get_temporary_buffer<T>(n)) {}
-
-			T* data() const {
-				return alloc_.get();
-			}
-
-			std::ptrdiff_t size() const {
-				return size_;
-			}
-		};
-
-		template<class T>
-		requires (alignof(T) > alignof(std::max_align_t))
-		class temporary_buffer<T> {
-			std::unique_ptr<unsigned char, temporary_buffer_deleter> alloc_;
-			T* aligned_ = nullptr;
-			std::ptrdiff_t size_ = 0;
-
-			static_assert((alignof(T) & (alignof(T) - 1)) == 0,
-				"Alignment must be a power of two.");
-
-			temporary_buffer(std::pair<unsigned char*, std::ptrdiff_t> buf)
-			: alloc_{buf.first}
+			: resource_{ext::scratch_resource()}
 			{
-				if (buf.second > 0 && static_cast<std::size_t>(buf.second) >= sizeof(T)) {
-					void* ptr = buf.first;
-					std::size_t n = buf.second;
-					aligned_ = static_cast<T*>(std::align(alignof(T), sizeof(T), ptr, n));
-					if (aligned_) {
-						size_ = n / sizeof(T);
-					}
+				n = std::min(n, static_cast<std::ptrdiff_t>(PTRDIFF_MAX / sizeof(T)));
+				for (; n > 0; n /= 2) {
+					try {
+						data_ = static_cast<T*>(resource_->allocate(
+							static_cast<std::size_t>(n) * sizeof(T), alignof(T)));
+						size_ = n;
+						return;
+					} catch (const std::bad_alloc&) {}
 				}
 			}
-
-		public:
-			temporary_buffer() = default;
-			temporary_buffer(std::ptrdiff_t n)
-			: temporary_buffer(std::get_temporary_buffer<unsigned char>(
-				n * sizeof(T) + alignof(T) - 1))
+			temporary_buffer(temporary_buffer&& that) noexcept
+			: resource_{that.resource_}
+			, data_{std::exchange(that.data_, nullptr)}
+			, size_{std::exchange(that.size_, 0)}
 			{}
+			temporary_buffer& operator=(temporary_buffer&& that) noexcept {
+				if (this != &that) {
+					reset();
+					resource_ = that.resource_;
+					data_ = std::exchange(that.data_, nullptr);
+					size_ = std::exchange(that.size_, 0);
+				}
+				return *this;
+			}
+			~temporary_buffer() {
+				reset();
+			}
 
 			T* data() const {
-				return aligned_;
+				return data_;
 			}
 
 			std::ptrdiff_t size() const {
@@ -108,9 +106,11 @@ STL2_OPEN_NAMESPACE {
 			}
 
 			temporary_vector() = default;
+			temporary_vector(T* data, std::ptrdiff_t capacity)
+			: begin_{data}, end_{data}, alloc_{data + capacity}
+			{}
 			temporary_vector(temporary_buffer<T>& buf)
-			: begin_{buf.data()}, end_{begin_}
-			, alloc_{begin_ + buf.size()}
+			: temporary_vector(buf.data(), buf.size())
 			{}
 			temporary_vector(temporary_vector&&) = delete;
 			temporary_vector& operator=(temporary_vector&& that) = delete;
@@ -120,6 +120,11 @@ STL2_OPEN_NAMESPACE {
 				end_ = begin_;
 			}
 
+			void pop_back() noexcept {
+				STL2_EXPECT(begin_ < end_);
+				detail::destruct(*--end_);
+			}
+
 			constexpr bool empty() const noexcept {
 				return begin_ == end_;
 			}
@@ -14,8 +14,12 @@
 
 #include <memory>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/inplace_vector.hpp>
+#include <stl2/detail/small_vector.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
 #include <stl2/detail/memory/destroy.hpp>
+#include <stl2/detail/memory/relocate.hpp>
+#include <stl2/detail/memory/scratch_resource.hpp>
 #include <stl2/detail/memory/uninitialized_copy.hpp>
 #include <stl2/detail/memory/uninitialized_default_construct.hpp>
 #include <stl2/detail/memory/uninitialized_fill.hpp>
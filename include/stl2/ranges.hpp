@@ -31,6 +31,8 @@
 #include <stl2/view/iota.hpp>
 #include <stl2/view/istream.hpp>
 #include <stl2/view/join.hpp>
+#include <stl2/view/match_all.hpp>
+#include <stl2/view/merge.hpp>
 #include <stl2/view/move.hpp>
 #include <stl2/view/ref.hpp>
 #include <stl2/view/repeat_n.hpp>
@@ -0,0 +1,167 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_MATCH_ALL_HPP
+#define STL2_VIEW_MATCH_ALL_HPP
+
+#include <stl2/detail/aho_corasick.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/raw_ptr.hpp>
+#include <stl2/detail/functional/invoke.hpp>
+#include <stl2/detail/iterator/default_sentinel.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/all.hpp>
+#include <stl2/view/view_interface.hpp>
+
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		// The occurrences of the patterns of an aho_corasick automaton in a
+		// text, found lazily in a single pass: ordered by where they end,
+		// and longest first among those ending together. Each is a
+		// pattern_match, a subrange of the text with the index of its
+		// pattern. Like istream_view, the view is a single-pass input range
+		// whose iterators refer to the scan it keeps; the automaton must
+		// outlive it.
+		template<view V>
+		requires forward_range<V> && detail::byte_like<range_value_t<V>>
+		class match_all_view : public view_interface<match_all_view<V>> {
+			struct __iterator;
+			using I = iterator_t<V>;
+
+			V base_{};
+			detail::raw_ptr<const aho_corasick> ac_ = nullptr;
+			detail::scan_history<I> history_;
+			I cur_{};
+			aho_corasick::state_type state_ = 0;
+			aho_corasick::output_type output_ = 0;
+			pattern_match<I> match_{};
+			bool done_ = false;
+
+			void emit() {
+				const std::size_t p = ac_->pattern(output_);
+				match_ = {{history_.start(cur_, ac_->length(p)), cur_}, p};
+			}
+
+			void next_() {
+				if (output_ != 0) {
+					output_ = ac_->next_output(output_);
+					if (output_ != 0) {
+						emit();
+						return;
+					}
+				}
+				// The scan runs in locals, which the stores through the
+				// table cannot alias.
+				const aho_corasick& ac = *ac_;
+				const auto last = __stl2::end(base_);
+				auto cur = std::move(cur_);
+				auto state = state_;
+				while (cur != last) {
+					history_.push(cur);
+					state = ac.next(state, static_cast<unsigned char>(*cur));
+					++cur;
+					if (ac.accepting(state)) {
+						cur_ = std::move(cur);
+						state_ = state;
+						output_ = ac.first_output(state);
+						emit();
+						return;
+					}
+				}
+				cur_ = std::move(cur);
+				done_ = true;
+			}
+		public:
+			match_all_view() = default;
+			constexpr match_all_view(V base, const aho_corasick& ac)
+			: base_(std::move(base)), ac_{std::addressof(ac)} {}
+
+			V base() const { return base_; }
+
+			__iterator begin() {
+				cur_ = __stl2::begin(base_);
+				state_ = ac_->start();
+				output_ = 0;
+				// Nothing can match: no pattern, or only empty ones.
+				done_ = ac_->max_length() == 0;
+				if (!done_) {
+					history_ = detail::scan_history<I>(ac_->max_length());
+					next_(); // prime the pump
+				}
+				return __iterator{*this};
+			}
+
+			constexpr default_sentinel_t end() const noexcept { return {}; }
+		};
+
+		template<class R>
+		match_all_view(R&&, const aho_corasick&) -> match_all_view<all_view<R>>;
+
+		template<view V>
+		requires forward_range<V> && detail::byte_like<range_value_t<V>>
+		struct match_all_view<V>::__iterator {
+			using iterator_category = input_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = pattern_match<I>;
+
+			__iterator() = default;
+			explicit constexpr __iterator(match_all_view& parent) noexcept
+			: parent_{std::addressof(parent)} {}
+
+			__iterator& operator++() {
+				parent_->next_();
+				return *this;
+			}
+			void operator++(int) { ++*this; }
+
+			const value_type& operator*() const { return parent_->match_; }
+			const value_type* operator->() const { return std::addressof(parent_->match_); }
+
+			friend bool operator==(__iterator x, default_sentinel_t) {
+				return x.at_end();
+			}
+			friend bool operator==(default_sentinel_t, __iterator x) {
+				return x.at_end();
+			}
+			friend bool operator!=(__iterator x, default_sentinel_t) {
+				return !x.at_end();
+			}
+			friend bool operator!=(default_sentinel_t, __iterator x) {
+				return !x.at_end();
+			}
+		private:
+			bool at_end() const { return parent_->done_; }
+			detail::raw_ptr<match_all_view> parent_ = nullptr;
+		};
+	} // namespace ext
+
+	namespace views::ext {
+		struct __match_all_fn : detail::__pipeable<__match_all_fn> {
+			template<class Rng>
+			constexpr auto operator()(Rng&& rng, const __stl2::ext::aho_corasick& ac) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::match_all_view{views::all(static_cast<Rng&&>(rng)), ac}
+			)
+
+			template<class Rng>
+			void operator()(Rng&&, const __stl2::ext::aho_corasick&&) const = delete;
+
+			constexpr auto operator()(const __stl2::ext::aho_corasick& ac) const
+			{ return detail::view_closure{*this, __stl2::ref(ac)}; }
+
+			void operator()(const __stl2::ext::aho_corasick&&) const = delete;
+		};
+
+		inline constexpr __match_all_fn match_all{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,225 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_MERGE_HPP
+#define STL2_VIEW_MERGE_HPP
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/raw_ptr.hpp>
+#include <stl2/detail/semiregular_box.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/functional/invoke.hpp>
+#include <stl2/detail/iterator/default_sentinel.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/subrange.hpp>
+#include <stl2/view/view_interface.hpp>
+
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		// Ranges of ranges a merge_view may refer to in place: the ranges
+		// are forwarding, and so is the range of ranges unless the ranges
+		// it holds do not own their elements.
+		template<class R>
+		META_CONCEPT __merge_source = _ForwardingRange<range_reference_t<R>> &&
+			(_ForwardingRange<R> || _ForwardingRange<range_value_t<R>>);
+
+		// The elements of any number of sorted ranges, merged lazily in a
+		// single pass: the order merge would produce pairwise, stable
+		// across the ranges, which take turns in the order given. A
+		// tournament tree over the ranges keeps, at each of its nodes, the
+		// range that lost the match played there, and the overall winner
+		// at its root; after the winner yields its element, it replays
+		// only the matches on its path to the root, log k comparisons for
+		// k ranges. Like istream_view, the view is a single-pass input
+		// range whose iterators refer to the state it keeps; the ranges
+		// must outlive it.
+		template<input_iterator I, sentinel_for<I> S, class Comp = less,
+			class Proj = identity>
+		requires indirect_strict_weak_order<Comp, projected<I, Proj>>
+		class merge_view : public view_interface<merge_view<I, S, Comp, Proj>> {
+			struct __iterator;
+			struct source {
+				I first;
+				S last;
+			};
+
+			std::vector<source> sources_;
+			// tree_[0] is the winner, tree_[n] the loser at node n of the
+			// tree whose leaves are the ranges, at k + i for range i.
+			std::vector<std::size_t> tree_;
+			detail::semiregular_box<Comp> comp_;
+			detail::semiregular_box<Proj> proj_;
+
+			bool exhausted(const std::size_t i) const {
+				return sources_[i].first == sources_[i].last;
+			}
+
+			// Whether range a wins its match against range b, the earlier
+			// range winning a tie. An exhausted range loses every match, so
+			// it stays in the tree without ever reaching the root while any
+			// other range has elements. One comparison, of the later range's
+			// element against the earlier's, decides the rest either way.
+			bool beats(const std::size_t a, const std::size_t b) {
+				if (exhausted(a)) return false;
+				if (exhausted(b)) return true;
+				const bool earlier = a < b;
+				const I& x = sources_[earlier ? a : b].first;
+				const I& y = sources_[earlier ? b : a].first;
+				const bool later_less = __stl2::invoke(comp_.get(),
+					__stl2::invoke(proj_.get(), *y), __stl2::invoke(proj_.get(), *x));
+				return earlier != later_less;
+			}
+
+			// Plays every match, bottom up.
+			void build() {
+				const std::size_t k = sources_.size();
+				tree_.assign(k, 0);
+				if (k <= 1) return;
+				std::vector<std::size_t> winners(2 * k);
+				for (std::size_t i = 0; i < k; ++i) winners[k + i] = i;
+				for (std::size_t n = k - 1; n > 0; --n) {
+					const std::size_t a = winners[2 * n], b = winners[2 * n + 1];
+					const bool first = beats(a, b);
+					winners[n] = first ? a : b;
+					tree_[n] = first ? b : a;
+				}
+				tree_[0] = winners[1];
+			}
+
+			// Replays the matches of the winner, after it yields an element;
+			// once it is exhausted, it loses each of them.
+			void next_() {
+				const std::size_t k = sources_.size();
+				std::size_t winner = tree_[0];
+				++sources_[winner].first;
+				for (std::size_t n = (k + winner) / 2; n > 0; n /= 2) {
+					// The outcome is a coin toss for ranges that interleave;
+					// exchange by masking rather than branch on it.
+					const std::size_t loser = tree_[n];
+					const std::size_t swap = (loser ^ winner) &
+						(std::size_t{0} - beats(loser, winner));
+					tree_[n] = loser ^ swap;
+					winner ^= swap;
+				}
+				tree_[0] = winner;
+			}
+
+			// Only when every range is exhausted does one reach the root.
+			bool done_() const {
+				return sources_.empty() || exhausted(tree_[0]);
+			}
+		public:
+			merge_view() = default;
+
+			// The elements of each of the sorted ranges of ranges, under comp
+			// and proj. The view refers to the ranges in place, so a temporary
+			// range of ranges must hold ranges that do not own their elements.
+			template<input_range R>
+			requires __merge_source<R> &&
+				same_as<iterator_t<range_reference_t<R>>, I> &&
+				same_as<sentinel_t<range_reference_t<R>>, S>
+			explicit merge_view(R&& ranges, Comp comp = {}, Proj proj = {})
+			: comp_(std::move(comp)), proj_(std::move(proj))
+			{
+				if constexpr (sized_range<R>) {
+					sources_.reserve(static_cast<std::size_t>(__stl2::size(ranges)));
+				}
+				for (auto&& r : ranges) {
+					sources_.push_back({__stl2::begin(r), __stl2::end(r)});
+				}
+			}
+
+			__iterator begin() {
+				build();
+				return __iterator{*this};
+			}
+
+			constexpr default_sentinel_t end() const noexcept { return {}; }
+		};
+
+		template<input_range R, class Comp = less, class Proj = identity>
+		requires __merge_source<R>
+		merge_view(R&&, Comp = {}, Proj = {}) ->
+			merge_view<iterator_t<range_reference_t<R>>,
+				sentinel_t<range_reference_t<R>>, Comp, Proj>;
+
+		template<input_iterator I, sentinel_for<I> S, class Comp, class Proj>
+		requires indirect_strict_weak_order<Comp, projected<I, Proj>>
+		struct merge_view<I, S, Comp, Proj>::__iterator {
+			using iterator_category = input_iterator_tag;
+			using difference_type = iter_difference_t<I>;
+			using value_type = iter_value_t<I>;
+
+			__iterator() = default;
+			explicit constexpr __iterator(merge_view& parent) noexcept
+			: parent_{std::addressof(parent)} {}
+
+			__iterator& operator++() {
+				parent_->next_();
+				return *this;
+			}
+			void operator++(int) { ++*this; }
+
+			iter_reference_t<I> operator*() const {
+				return *parent_->sources_[parent_->tree_[0]].first;
+			}
+
+			friend bool operator==(const __iterator& x, default_sentinel_t) {
+				return x.at_end();
+			}
+			friend bool operator==(default_sentinel_t, const __iterator& x) {
+				return x.at_end();
+			}
+			friend bool operator!=(const __iterator& x, default_sentinel_t) {
+				return !x.at_end();
+			}
+			friend bool operator!=(default_sentinel_t, const __iterator& x) {
+				return !x.at_end();
+			}
+		private:
+			bool at_end() const { return parent_->done_(); }
+			detail::raw_ptr<merge_view> parent_ = nullptr;
+		};
+	} // namespace ext
+
+	namespace views::ext {
+		struct __merge_fn : detail::__pipeable<__merge_fn> {
+			// The sorted ranges of a range of ranges
+			template<input_range Rng, class Comp = less, class Proj = identity>
+			requires __stl2::ext::__merge_source<Rng>
+			constexpr auto operator()(Rng&& ranges, Comp comp = {}, Proj proj = {}) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::merge_view{static_cast<Rng&&>(ranges), std::move(comp),
+					std::move(proj)}
+			)
+
+			// The sorted ranges given, all of the same type
+			template<_ForwardingRange Rng1, _ForwardingRange Rng2, _ForwardingRange... Rngs>
+			requires same_as<iterator_t<Rng1>, iterator_t<Rng2>> &&
+				same_as<sentinel_t<Rng1>, sentinel_t<Rng2>> &&
+				(same_as<iterator_t<Rng1>, iterator_t<Rngs>> && ...) &&
+				(same_as<sentinel_t<Rng1>, sentinel_t<Rngs>> && ...)
+			constexpr auto operator()(Rng1&& r1, Rng2&& r2, Rngs&&... rs) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::merge_view{std::array{subrange{r1}, subrange{r2},
+					subrange{rs}...}}
+			)
+		};
+
+		inline constexpr __merge_fn merge{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -10,10 +10,33 @@
 // Project home: https://github.com/ericniebler/range-v3
 
 #include <stl2/detail/algorithm/adjacent_find.hpp>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 
 namespace ranges = __stl2;
 
+// Distinct elements but for one adjacent equal pair, moved through every
+// position of lengths about the vector widths.
+template<class T>
+void test_vectorized() {
+	namespace simd = ranges::detail::simd;
+	static_assert(simd::adjacent_equality_scannable<T*, T*, ranges::equal_to,
+		ranges::identity>);
+	for_each_isa([&] {
+		for (int n : {0, 1, 2, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100}) {
+			std::vector<T> v(n);
+			for (int i = 0; i < n; ++i) v[i] = static_cast<T>(i % 2 ? -i : i);
+			CHECK(ranges::adjacent_find(v) == v.end());
+			for (int pos = 1; pos < n; ++pos) {
+				auto w = v;
+				w[pos] = w[pos - 1];
+				CHECK(ranges::adjacent_find(w) == w.begin() + (pos - 1));
+			}
+		}
+	});
+}
+
 int main()
 {
 	int v1[] = { 0, 2, 2, 4, 6 };
@@ -32,5 +55,10 @@ int main()
 	auto l = {0, 2, 2, 4, 6};
 	CHECK(ranges::adjacent_find(ranges::subrange(l))[2] == 4);
 
+	test_vectorized<signed char>();
+	test_vectorized<unsigned short>();
+	test_vectorized<int>();
+	test_vectorized<unsigned long long>();
+
 	return test_result();
 }
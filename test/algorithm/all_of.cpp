@@ -76,5 +76,15 @@ int main()
 		CHECK(!ranges::all_of(std::move(l), &S::p));
 	}
 
+	{
+		std::vector<int> v(1000, 1);
+		CHECK(ranges::all_of(v, ranges::ext::equal_to_value{1}));
+		CHECK(!ranges::all_of(v, ranges::ext::not_equal_to_value{1}));
+		v[999] = 2;
+		CHECK(!ranges::all_of(v, ranges::ext::equal_to_value{1}));
+		CHECK(ranges::all_of(v.begin(), v.begin() + 999, ranges::ext::equal_to_value{1}));
+		CHECK(ranges::all_of(v, ranges::ext::not_equal_to_value{3}));
+	}
+
 	return ::test_result();
 }
@@ -0,0 +1,126 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/apply_permutation.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	// Counts the moves into it.
+	struct counted {
+		int value = 0;
+		static inline int moves = 0;
+
+		counted() = default;
+		explicit counted(int v) : value{v} {}
+		counted(counted&& that) : value{that.value} { ++moves; }
+		counted& operator=(counted&& that) {
+			value = that.value;
+			++moves;
+			return *this;
+		}
+	};
+
+	template<class Index>
+	void test_random(int n) {
+		std::vector<Index> perm(n);
+		std::iota(perm.begin(), perm.end(), Index{0});
+		std::shuffle(perm.begin(), perm.end(), gen);
+		const auto orig_perm = perm;
+
+		std::vector<int> v(n);
+		for (int i = 0; i < n; ++i) v[i] = 2 * i;
+		auto res = ranges::ext::apply_permutation(v, perm);
+		CHECK(res == v.end());
+		CHECK(perm == orig_perm);
+		for (int i = 0; i < n; ++i) CHECK(v[i] == 2 * static_cast<int>(perm[i]));
+	}
+}
+
+int main() {
+	// Empty and identity permutations
+	{
+		int a[] = {1, 2, 3};
+		int p[] = {0, 1, 2};
+		CHECK(ranges::ext::apply_permutation(a, a, p) == a);
+		CHECK(ranges::ext::apply_permutation(a, p) == a + 3);
+		for (int i = 0; i < 3; ++i) {
+			CHECK(a[i] == i + 1);
+			CHECK(p[i] == i);
+		}
+	}
+
+	// Iterator and sentinel; unsigned indices at the largest n they allow
+	{
+		std::array<int, 128> a;
+		std::array<std::uint8_t, 128> p;
+		for (int i = 0; i < 128; ++i) {
+			a[i] = i;
+			p[i] = static_cast<std::uint8_t>(127 - i);
+		}
+		using I = random_access_iterator<int*>;
+		auto res = ranges::ext::apply_permutation(I{a.data()}, sentinel<int*>{a.data() + 128},
+			p.data());
+		CHECK(res.base() == a.data() + 128);
+		for (int i = 0; i < 128; ++i) {
+			CHECK(a[i] == 127 - i);
+			CHECK(p[i] == 127 - i);
+		}
+	}
+
+	// Each element out of place moves once, plus one more move per cycle.
+	{
+		std::vector<counted> v;
+		for (int i = 0; i < 10; ++i) v.emplace_back(i);
+		int p[] = {1, 2, 0, 3, 5, 4, 7, 8, 9, 6};
+		counted::moves = 0;
+		ranges::ext::apply_permutation(v, p);
+		CHECK(counted::moves == 9 + 3);
+		for (int i = 0; i < 10; ++i) CHECK(v[i].value == p[i]);
+	}
+
+	// Move-only elements
+	{
+		std::vector<std::unique_ptr<int>> v;
+		for (int i = 0; i < 100; ++i) v.push_back(std::make_unique<int>(i));
+		std::vector<short> p(100);
+		std::iota(p.begin(), p.end(), short{0});
+		std::shuffle(p.begin(), p.end(), gen);
+		ranges::ext::apply_permutation(v, p);
+		for (int i = 0; i < 100; ++i) CHECK(*v[i] == p[i]);
+	}
+
+	// Compile-time
+	{
+		constexpr auto a = [] {
+			std::array<int, 5> a{10, 11, 12, 13, 14};
+			int p[] = {4, 0, 3, 1, 2};
+			ranges::ext::apply_permutation(a, p);
+			return a;
+		}();
+		static_assert(a == std::array<int, 5>{14, 10, 13, 11, 12});
+	}
+
+	test_random<int>(1000);
+	test_random<std::uint16_t>(30000);
+	test_random<std::size_t>(100000);
+
+	return ::test_result();
+}
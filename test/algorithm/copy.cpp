@@ -15,7 +15,9 @@
 #include <stl2/utility.hpp>
 #include <algorithm>
 #include <cstring>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 
 namespace ranges = __stl2;
 
@@ -59,6 +61,109 @@ STL2_OPEN_NAMESPACE {
 	};
 } STL2_CLOSE_NAMESPACE
 
+// Copies of trivially copyable elements, made a block at a time, also
+// through iterator adaptors.
+void test_block_copies() {
+	namespace simd = ranges::detail::simd;
+	struct point { int x, y; };
+	struct counter {
+		int n;
+		counter& operator=(const counter& that) { n = that.n + 1; return *this; }
+	};
+	static_assert(ranges::detail::memcopyable<const point*, point*, const point&>);
+	static_assert(ranges::detail::memcopyable<ranges::move_iterator<int*>, int*, int&&>);
+	static_assert(ranges::detail::memcopyable<ranges::reverse_iterator<int*>,
+		ranges::reverse_iterator<std::vector<int>::iterator>, int&>);
+	static_assert(!ranges::detail::memcopyable<ranges::reverse_iterator<int*>, int*, int&>);
+	static_assert(!ranges::detail::memcopyable<const counter*, counter*, const counter&>);
+	static_assert(!ranges::detail::memcopyable<const long*, int*, const long&>);
+
+	{
+		const point a[] = {{1, 2}, {3, 4}, {5, 6}};
+		point out[3] = {};
+		auto res = ranges::copy(a, out);
+		CHECK(res.in == a + 3);
+		CHECK(res.out == out + 3);
+		CHECK(out[2].x == 5);
+		CHECK(out[2].y == 6);
+	}
+	{
+		// Not trivially assignable: assigned element by element.
+		const counter a[] = {{1}, {2}};
+		counter out[2] = {};
+		ranges::copy(a, out);
+		CHECK(out[0].n == 2);
+		CHECK(out[1].n == 3);
+	}
+	{
+		std::vector<int> v = {0, 1, 2, 3, 4, 5, 6, 7};
+		// Overlapping, to the left
+		auto res = ranges::copy(v.begin() + 2, v.end(), v.begin());
+		CHECK(res.in == v.end());
+		CHECK(res.out == v.begin() + 6);
+		CHECK_EQUAL(v, {2, 3, 4, 5, 6, 7, 6, 7});
+	}
+	{
+		int a[] = {1, 2, 3, 4, 5};
+		std::vector<int> out(5);
+		// Both reversed: the block is copied as it lies.
+		auto res = ranges::copy(ranges::make_reverse_iterator(a + 5),
+			ranges::make_reverse_iterator(a + 1),
+			ranges::make_reverse_iterator(out.end()));
+		CHECK(res.in.base() == a + 1);
+		CHECK(res.out.base() == out.begin() + 1);
+		CHECK_EQUAL(out, {0, 2, 3, 4, 5});
+		// One reversed: the elements are reversed.
+		auto res2 = ranges::copy(ranges::make_reverse_iterator(a + 5),
+			ranges::make_reverse_iterator(a), out.begin());
+		CHECK(res2.out == out.end());
+		CHECK_EQUAL(out, {5, 4, 3, 2, 1});
+	}
+	{
+		int a[] = {1, 2, 3, 4, 5};
+		int out[5] = {};
+		auto res = ranges::copy(ranges::counted_iterator{ranges::make_move_iterator(a), 3},
+			ranges::default_sentinel, out);
+		CHECK(res.in.count() == 0);
+		CHECK(res.in.base().base() == a + 3);
+		CHECK(res.out == out + 3);
+		CHECK_EQUAL(out, {1, 2, 3, 0, 0});
+	}
+	{
+		// The bounded extension stops at the shorter range.
+		int a[] = {1, 2, 3, 4, 5};
+		int out[3] = {};
+		auto res = ranges::ext::copy(a, out);
+		CHECK(res.in == a + 3);
+		CHECK(res.out == out + 3);
+		CHECK_EQUAL(out, {1, 2, 3});
+		int wide[7] = {};
+		auto res2 = ranges::ext::copy(a, wide);
+		CHECK(res2.in == a + 5);
+		CHECK(res2.out == wide + 5);
+		CHECK_EQUAL(wide, {1, 2, 3, 4, 5, 0, 0});
+	}
+
+	// Copies large enough to stream, at each instruction set the machine
+	// supports, with the destination at each alignment.
+	const std::size_t n = simd::stream_threshold / sizeof(int) + 37;
+	std::vector<int> source(n + 16);
+	for (std::size_t i = 0; i < source.size(); ++i) source[i] = static_cast<int>(i * 7);
+	std::vector<int> target(n + 16);
+	for_each_isa([&] {
+		for (std::size_t offset : {0, 1, 3, 15}) {
+			std::fill(target.begin(), target.end(), -1);
+			auto res = ranges::copy(source.data() + 1, source.data() + 1 + n,
+				target.data() + offset);
+			CHECK(res.out == target.data() + offset + n);
+			CHECK(std::equal(source.begin() + 1, source.begin() + 1 + n,
+				target.begin() + offset));
+			if (offset != 0) CHECK(target[offset - 1] == -1);
+			CHECK(target[offset + n] == -1);
+		}
+	});
+}
+
 int main() {
 	using ranges::begin;
 	using ranges::end;
@@ -112,5 +217,7 @@ int main() {
 		CHECK_EQUAL(target, {0,1,2,3,4,5,6,0});
 	}
 
+	test_block_copies();
+
 	return test_result();
 }
@@ -15,6 +15,7 @@
 #include <cstring>
 #include <utility>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
@@ -86,5 +87,22 @@ int main() {
 	test_repeat_view();
 	test_initializer_list();
 
+	// Copied a block at a time
+	{
+		std::vector<int> v = {0, 1, 2, 3, 4, 5, 6, 7};
+		// Overlapping, to the right
+		auto res3 = ranges::copy_backward(v.begin(), v.begin() + 6, v.end());
+		CHECK(res3.in == v.begin() + 6);
+		CHECK(res3.out == v.begin() + 2);
+		CHECK_EQUAL(v, {0, 1, 0, 1, 2, 3, 4, 5});
+
+		int b[] = {1, 2, 3};
+		auto res4 = ranges::copy_backward(ranges::make_reverse_iterator(b + 3),
+			ranges::make_reverse_iterator(b + 1), ranges::make_reverse_iterator(v.begin()));
+		CHECK(res4.in.base() == b + 1);
+		CHECK(res4.out.base() == v.begin() + 2);
+		CHECK_EQUAL(v, {2, 3, 0, 1, 2, 3, 4, 5});
+	}
+
 	return test_result();
 }
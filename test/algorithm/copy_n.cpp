@@ -11,6 +11,8 @@
 //
 #include <stl2/detail/algorithm/copy_n.hpp>
 #include <algorithm>
+#include <stl2/detail/iterator/move_iterator.hpp>
+#include <stl2/detail/iterator/reverse_iterator.hpp>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
@@ -30,5 +32,22 @@ int main() {
 	CHECK(target[n - 2] == 0);
 	CHECK(target[n - 1] == 0);
 
+	// Through adaptors, a block at a time
+	{
+		std::fill_n(target, n, 0);
+		auto res2 = ranges::copy_n(ranges::counted_iterator{source + 1, 4}, 3, target);
+		CHECK(res2.in.base() == source + 4);
+		CHECK(res2.in.count() == 1);
+		CHECK(res2.out == target + 3);
+		CHECK(std::equal(source + 1, source + 4, target));
+
+		auto res3 = ranges::copy_n(ranges::make_reverse_iterator(source + n), 2,
+			ranges::make_reverse_iterator(target + n));
+		CHECK(res3.in.base() == source + n - 2);
+		CHECK(res3.out.base() == target + n - 2);
+		CHECK(target[n - 2] == 1);
+		CHECK(target[n - 1] == 0);
+	}
+
 	return test_result();
 }
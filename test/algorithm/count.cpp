@@ -10,7 +10,11 @@
 // Project home: https://github.com/ericniebler/range-v3
 
 #include <stl2/detail/algorithm/count.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_iterators.hpp"
 
 struct S
@@ -18,6 +22,27 @@ struct S
 	int i;
 };
 
+// Contiguous integers are counted with vector instructions, whose byte-wide
+// counters are flushed every 255 vectors; try each instruction set the
+// machine has.
+template<class T>
+void test_vectorized()
+{
+	for_each_isa([&] {
+		for (int n : {0, 1, 15, 16, 17, 63, 64, 65, 1000, 100000}) {
+			std::vector<T> v(n);
+			std::ptrdiff_t sevens = 0;
+			for (int i = 0; i < n; ++i) {
+				v[i] = static_cast<T>(i % 3 == 0 || i % 7 == 0 ? 7 : i);
+				sevens += v[i] == 7;
+			}
+			CHECK(__stl2::count(v, T(7)) == sevens);
+			CHECK(__stl2::count(v.data(), v.data() + n, T(7)) == sevens);
+			CHECK(__stl2::count(v, T(-100)) == std::count(v.begin(), v.end(), T(-100)));
+		}
+	});
+}
+
 int main()
 {
 	using __stl2::count, __stl2::size, __stl2::subrange;
@@ -65,5 +90,16 @@ int main()
 		CHECK(count(std::move(l), 7) == 0);
 	}
 
+	test_vectorized<char>();
+	test_vectorized<std::uint16_t>();
+	test_vectorized<int>();
+	test_vectorized<std::uint64_t>();
+
+	{
+		signed char sc[] = {-1, 2, -1};
+		CHECK(count(sc, 255) == 0);
+		CHECK(count(sc, -1) == 2);
+	}
+
 	return ::test_result();
 }
@@ -19,7 +19,11 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/equal.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_iterators.hpp"
 
 namespace ranges = __stl2;
@@ -32,6 +36,30 @@ bool counting_equals(const T &a, const T &b) {
 	return a == b;
 }
 
+// Contiguous integers are compared with memcmp, and by the vector kernels
+// mismatch shares; try each instruction set the machine has.
+template<class T>
+void test_vectorized() {
+	for_each_isa([&] {
+		for (int n : {0, 1, 7, 64, 65, 1000}) {
+			std::vector<T> a(n);
+			for (int i = 0; i < n; ++i) a[i] = static_cast<T>(i * 37 + 5);
+			auto b = a;
+			CHECK(ranges::equal(a, b));
+			CHECK(ranges::equal(a.data(), a.data() + n, b.data(), b.data() + n));
+			CHECK(ranges::equal(a, b, std::equal_to<>{}));
+			if (n == 0) continue;
+			CHECK(!ranges::equal(a.data(), a.data() + n, b.data(), b.data() + n - 1));
+			for (int pos : {0, n / 2, n - 1}) {
+				b[pos] = static_cast<T>(~static_cast<unsigned>(a[pos]));
+				CHECK(!ranges::equal(a, b));
+				CHECK(!ranges::equal(a, b, ranges::equal_to{}));
+				b[pos] = a[pos];
+			}
+		}
+	});
+}
+
 int main() {
 	using ranges::equal, ranges::distance, ranges::subrange;
 
@@ -70,5 +98,11 @@ int main() {
 	test_case(false, 0,     R(ia), R(ia + s), R(ia), R(ia + s - 1));
 	test_case(false, s - 1, R(ia), S(ia + s), R(ia), S(ia + s - 1));
 
+	test_vectorized<unsigned char>();
+	test_vectorized<std::byte>();
+	test_vectorized<short>();
+	test_vectorized<int>();
+	test_vectorized<std::uint64_t>();
+
 	return ::test_result();
 }
@@ -19,10 +19,12 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/fill.hpp>
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
 
@@ -73,6 +75,51 @@ void test_int() {
 	CHECK(ia[3] == 2);
 }
 
+// Fills whose bytes are all alike, made a block at a time.
+void test_block_fills() {
+	namespace simd = ranges::detail::simd;
+	struct point { int x, y; };
+	{
+		// An int assigned to chars
+		std::vector<char> v(37, 'x');
+		CHECK(ranges::fill(v, 'a' + 256) == v.end());
+		CHECK(std::count(v.begin(), v.end(), 'a') == 37);
+	}
+	{
+		point ps[5] = {{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}};
+		CHECK(ranges::fill(ps + 1, ps + 4, point{0, 0}) == ps + 4);
+		CHECK(ps[0].x == 1);
+		CHECK(ps[1].x == 0);
+		CHECK(ps[3].y == 0);
+		CHECK(ps[4].y == 10);
+		// Bytes not all alike: element by element
+		ranges::fill(ps, point{-1, 7});
+		CHECK(ps[0].x == -1);
+		CHECK(ps[4].y == 7);
+	}
+	{
+		int ia[6] = {};
+		auto r = ranges::fill(ranges::make_reverse_iterator(ia + 5),
+			ranges::make_reverse_iterator(ia + 1), -1);
+		CHECK(r.base() == ia + 1);
+		CHECK_EQUAL(ia, {0, -1, -1, -1, -1, 0});
+	}
+
+	// Fills large enough to stream, at each instruction set the machine
+	// supports, at each alignment.
+	const std::size_t n = simd::stream_threshold + 37;
+	std::vector<unsigned char> bytes(n + 16);
+	for_each_isa([&] {
+		for (std::size_t offset : {0, 1, 3, 15}) {
+			std::fill(bytes.begin(), bytes.end(), 0);
+			auto r = ranges::fill(bytes.data() + offset, bytes.data() + offset + n, 0xAB);
+			CHECK(r == bytes.data() + offset + n);
+			CHECK(static_cast<std::size_t>(std::count(bytes.begin(), bytes.end(), 0xAB)) == n);
+			CHECK(bytes[offset + n] == 0);
+		}
+	});
+}
+
 int main() {
 	test_char<forward_iterator<char*> >();
 	test_char<bidirectional_iterator<char*> >();
@@ -92,5 +139,7 @@ int main() {
 	test_int<bidirectional_iterator<int*>, sentinel<int*> >();
 	test_int<random_access_iterator<int*>, sentinel<int*> >();
 
+	test_block_fills();
+
 	return ::test_result();
 }
@@ -19,8 +19,13 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/find.hpp>
+#include <stl2/detail/algorithm/find_if.hpp>
+#include <stl2/detail/algorithm/find_if_not.hpp>
 #include <stl2/utility.hpp>
+#include <cstdint>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_iterators.hpp"
 
 namespace ranges = __stl2;
@@ -29,6 +34,31 @@ struct S {
 	int i_;
 };
 
+// Contiguous integers are searched with vector instructions; try each
+// instruction set the machine has at every match position near the ends
+// of the vectors and of their unrolled blocks.
+template<class T>
+void test_vectorized() {
+	for_each_isa([&] {
+		for (int n : {0, 1, 15, 16, 17, 63, 64, 65, 255, 256, 257, 1000}) {
+			std::vector<T> v(n, T(3));
+			CHECK(ranges::find(v, T(5)) == v.end());
+			CHECK(ranges::find_if_not(v, ranges::ext::equal_to_value{T(3)}) == v.end());
+			CHECK(ranges::find_if(v, ranges::ext::not_equal_to_value{T(3)}) == v.end());
+			for (int pos = 0; pos < n; pos += 1 + pos / 4) {
+				v[pos] = T(5);
+				CHECK((ranges::find(v, T(5)) - v.begin()) == pos);
+				CHECK((ranges::find(v.data(), v.data() + n, 5) - v.data()) == pos);
+				CHECK((ranges::find_if(v, ranges::ext::equal_to_value{T(5)}) - v.begin()) == pos);
+				CHECK((ranges::find_if_not(v, ranges::ext::equal_to_value{T(3)}) - v.begin()) == pos);
+				CHECK((ranges::find_if(v, ranges::ext::not_equal_to_value{T(3)}) - v.begin()) == pos);
+				CHECK((ranges::find_if_not(v, ranges::ext::not_equal_to_value{T(5)}) - v.begin()) == pos);
+				v[pos] = T(3);
+			}
+		}
+	});
+}
+
 int main() {
 	using ranges::find, ranges::size, ranges::subrange, ranges::end;
 
@@ -59,5 +89,27 @@ int main() {
 	ps = find(sa, 10, &S::i_);
 	CHECK(ps == end(sa));
 
+	test_vectorized<char>();
+	test_vectorized<std::uint16_t>();
+	test_vectorized<int>();
+	test_vectorized<std::int64_t>();
+
+	// Values compare as they would element by element.
+	{
+		signed char sc[] = {1, -1, 2};
+		CHECK(find(sc, 255) == end(sc));
+		CHECK(find(sc, -1) == sc + 1);
+		unsigned char uc[] = {1, 255, 2};
+		CHECK(find(uc, -1) == end(uc));
+		CHECK(find(uc, 255) == uc + 1);
+		int ib[] = {1, -1, 2};
+		CHECK(find(ib, -1LL) == ib + 1);
+		CHECK(find(ib, 0xFFFFFFFFLL) == end(ib));
+		CHECK(ranges::find_if_not(ib, ranges::ext::equal_to_value{0x100000001LL}) == ib);
+		int x = 0, y = 0;
+		int* ptrs[] = {&x, nullptr, &y};
+		CHECK(find(ptrs, &y) == ptrs + 2);
+	}
+
 	return ::test_result();
 }
@@ -21,7 +21,9 @@
 #include <stl2/detail/algorithm/inplace_merge.hpp>
 #include <cassert>
 #include <algorithm>
+#include <memory>
 #include <random>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -127,12 +129,31 @@ test()
 	test<Iter>(1000);
 }
 
+// Elements better relocated than moved, merged stably: each holds
+// 10000 * key + its original position.
+void test_relocating()
+{
+	auto key = [](const std::unique_ptr<int>& p) { return *p / 10000; };
+	for (int m : {100, 500, 900}) {
+		std::vector<std::unique_ptr<int>> v;
+		for (int i = 0; i < 1000; ++i) {
+			const int k = i < m ? i / 2 : (i - m) / 3;
+			v.push_back(std::make_unique<int>(10000 * k + i));
+		}
+		stl2::inplace_merge(v, v.begin() + m, stl2::less{}, key);
+		for (std::size_t i = 1; i < v.size(); ++i) {
+			CHECK(*v[i - 1] < *v[i]);
+		}
+	}
+}
+
 int main()
 {
 	// test<forward_iterator<int*> >();
 	test<bidirectional_iterator<int*> >();
 	test<random_access_iterator<int*> >();
 	test<int*>();
+	test_relocating();
 
 	return ::test_result();
 }
@@ -24,6 +24,11 @@
 
 #include <stl2/detail/algorithm/is_permutation.hpp>
 #include <stl2/utility.hpp>
+#include <algorithm>
+#include <forward_list>
+#include <random>
+#include <string>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -331,5 +336,51 @@ int main() {
 		test(true, a, a + 4, b, b + 4);
 	}
 
+	// Long ranges of hashable values are counted in a hash table.
+	{
+		std::mt19937 gen;
+		for (int n : {33, 100, 1000, 100000}) {
+			std::vector<int> a(n);
+			for (auto& x : a) x = static_cast<int>(gen() % (n / 4 + 1)) << 16;
+			auto b = a;
+			std::shuffle(b.begin(), b.end(), gen);
+			CHECK(ranges::is_permutation(a, b));
+			CHECK(ranges::is_permutation(a, b, std::equal_to<>{}));
+			const std::forward_list<int> list(b.begin(), b.end());
+			CHECK(ranges::is_permutation(a.begin(), a.end(), list.begin(), list.end()));
+
+			// One element more of one value, one fewer of another
+			auto c = b;
+			auto const other = std::find_if(c.begin(), c.end(),
+				[&](int x) { return x != c.back(); });
+			if (other != c.end()) {
+				*other = c.back();
+				CHECK(!ranges::is_permutation(a, c));
+				CHECK(!ranges::is_permutation(c, a));
+			}
+			c = b;
+			c[static_cast<std::size_t>(n / 2)] = 1;
+			CHECK(!ranges::is_permutation(a, c));
+		}
+
+		std::vector<std::string> words;
+		for (int i = 0; i < 500; ++i) words.push_back(std::to_string(i % 97));
+		auto shuffled = words;
+		std::shuffle(shuffled.begin(), shuffled.end(), gen);
+		CHECK(ranges::is_permutation(words, shuffled));
+		shuffled.back() += "x";
+		CHECK(!ranges::is_permutation(words, shuffled));
+
+		struct record { int key; int tag; };
+		std::vector<record> r1, r2;
+		for (int i = 0; i < 200; ++i) {
+			r1.push_back({i % 50, i});
+			r2.push_back({(199 - i) % 50, -i});
+		}
+		CHECK(ranges::is_permutation(r1, r2, ranges::equal_to{}, &record::key, &record::key));
+		r2[7].key = 50;
+		CHECK(!ranges::is_permutation(r1, r2, ranges::equal_to{}, &record::key, &record::key));
+	}
+
 	return ::test_result();
 }
@@ -27,7 +27,10 @@
 //   http://http://libcxx.llvm.org/
 
 #include <stl2/detail/algorithm/is_sorted_until.hpp>
+#include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
 
@@ -372,6 +375,29 @@ void test() {
 	}
 }
 
+// A sorted range with runs of equal elements and one pair swapped, whose
+// end the kernels must find where a projection, which they do not take,
+// finds it.
+template<class T, class Comp>
+void test_vectorized(Comp comp) {
+	namespace simd = ranges::detail::simd;
+	static_assert(simd::adjacent_order_scannable<T*, T*, Comp, ranges::identity>);
+	for_each_isa([&] {
+		for (int n : {0, 1, 2, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100}) {
+			std::vector<T> v(n);
+			for (int i = 0; i < n; ++i) v[i] = static_cast<T>(i / 3);
+			if (!comp(T(0), T(1))) std::reverse(v.begin(), v.end());
+			CHECK(ranges::is_sorted_until(v, comp) == v.end());
+			for (int pos = 1; pos < n; ++pos) {
+				auto w = v;
+				std::swap(w[pos - 1], w[pos]);
+				auto ref = ranges::is_sorted_until(w, comp, [](T x) { return x; });
+				CHECK(ranges::is_sorted_until(w, comp) == ref);
+			}
+		}
+	});
+}
+
 struct A { int a; };
 
 int main() {
@@ -405,5 +431,16 @@ int main() {
 		CHECK(ranges::is_sorted_until(ranges::subrange(as), std::greater<int>{}, &A::a) == ranges::next(ranges::begin(as),1));
 	}
 
+	test_vectorized<signed char>(ranges::less{});
+	test_vectorized<unsigned char>(ranges::greater{});
+	test_vectorized<short>(std::less<>{});
+	test_vectorized<unsigned short>(ranges::less{});
+	test_vectorized<int>(ranges::greater{});
+	test_vectorized<unsigned>(ranges::less{});
+	test_vectorized<long long>(ranges::less{});
+	test_vectorized<unsigned long long>(std::greater<unsigned long long>{});
+	test_vectorized<float>(ranges::less{});
+	test_vectorized<double>(ranges::greater{});
+
 	return ::test_result();
 }
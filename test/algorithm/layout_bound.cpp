@@ -0,0 +1,118 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/layout_bound.hpp>
+#include <algorithm>
+#include <forward_list>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	struct record {
+		int key;
+		std::string name;
+	};
+
+	template<class Layout, class T>
+	void check_layout(const std::vector<T>& sorted) {
+		const Layout layout{sorted};
+		CHECK(layout.size() == sorted.size());
+		const T probes[] = {T(-1), T(0), T(1), T(7), T(sorted.size() / 2),
+			T(sorted.size()), T(sorted.size() * 2 + 1)};
+		for (const T& x : probes) {
+			const auto lower = static_cast<std::size_t>(
+				std::lower_bound(sorted.begin(), sorted.end(), x) - sorted.begin());
+			const auto upper = static_cast<std::size_t>(
+				std::upper_bound(sorted.begin(), sorted.end(), x) - sorted.begin());
+			CHECK(ranges::ext::layout_lower_bound(layout, x) == lower);
+			CHECK(ranges::ext::layout_upper_bound(layout, x) == upper);
+			const auto range = ranges::ext::layout_equal_range(layout, x);
+			CHECK(*range.begin() == lower);
+			CHECK(range.size() == upper - lower);
+		}
+	}
+
+	template<class T>
+	void test_random() {
+		for (std::size_t n = 0; n < 300; ++n) {
+			for (int spread : {1, 2, 5}) {
+				std::uniform_int_distribution<int> dist(0, static_cast<int>(n) * spread / 2);
+				std::vector<T> sorted(n);
+				for (auto& x : sorted) x = static_cast<T>(dist(gen));
+				std::sort(sorted.begin(), sorted.end());
+				check_layout<ranges::ext::eytzinger_layout<T>>(sorted);
+				check_layout<ranges::ext::btree_layout<T>>(sorted);
+				check_layout<ranges::ext::btree_layout<T, 2>>(sorted);
+				check_layout<ranges::ext::btree_layout<T, 5>>(sorted);
+			}
+		}
+	}
+}
+
+int main() {
+	using ranges::ext::eytzinger_layout, ranges::ext::btree_layout;
+	using ranges::ext::layout_lower_bound, ranges::ext::layout_upper_bound,
+		ranges::ext::layout_equal_range;
+
+	// Every rank, in a layout spanning many levels
+	{
+		std::vector<long> sorted(100000);
+		for (std::size_t i = 0; i < sorted.size(); ++i) sorted[i] = 2 * static_cast<long>(i);
+		const eytzinger_layout eytzinger{sorted};
+		const btree_layout btree{sorted};
+		for (std::size_t i = 0; i < sorted.size(); ++i) {
+			const long x = sorted[i];
+			CHECK(layout_lower_bound(eytzinger, x) == i);
+			CHECK(layout_lower_bound(eytzinger, x + 1) == i + 1);
+			CHECK(layout_upper_bound(eytzinger, x) == i + 1);
+			CHECK(layout_lower_bound(btree, x) == i);
+			CHECK(layout_lower_bound(btree, x + 1) == i + 1);
+			CHECK(layout_upper_bound(btree, x) == i + 1);
+		}
+	}
+
+	// From a forward range, in descending order
+	{
+		const std::forward_list<int> sorted = {9, 7, 7, 7, 4, 2, 2, 0};
+		const eytzinger_layout eytzinger{sorted};
+		const btree_layout<int, 3> btree{sorted};
+		CHECK(layout_lower_bound(eytzinger, 7, std::greater<>{}) == 1u);
+		CHECK(layout_upper_bound(eytzinger, 7, std::greater<>{}) == 4u);
+		CHECK(layout_lower_bound(btree, 7, std::greater<>{}) == 1u);
+		CHECK(layout_upper_bound(btree, 7, std::greater<>{}) == 4u);
+		CHECK(layout_equal_range(btree, 2, std::greater<>{}).size() == 2u);
+		CHECK(layout_lower_bound(btree, 10, std::greater<>{}) == 0u);
+		CHECK(layout_lower_bound(btree, -1, std::greater<>{}) == 8u);
+	}
+
+	// Through a projection
+	{
+		const std::vector<record> sorted = {{1, "a"}, {3, "b"}, {3, "c"}, {8, "d"}};
+		const eytzinger_layout eytzinger{sorted};
+		const btree_layout btree{sorted};
+		auto const range = layout_equal_range(eytzinger, 3, ranges::less{}, &record::key);
+		CHECK(*range.begin() == 1u);
+		CHECK(*range.end() == 3u);
+		CHECK(layout_lower_bound(btree, 4, ranges::less{}, &record::key) == 3u);
+		CHECK(layout_upper_bound(btree, 8, ranges::less{}, &record::key) == 4u);
+	}
+
+	test_random<int>();
+	test_random<unsigned char>();
+	test_random<double>();
+
+	return ::test_result();
+}
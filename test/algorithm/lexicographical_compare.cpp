@@ -19,7 +19,13 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/lexicographical_compare.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
 
@@ -160,7 +166,54 @@ void test_iter_comp() {
 	test_iter_comp1<const int*, const int*>();
 }
 
+// Contiguous integers are ordered at their first mismatch, found a vector
+// at a time, and unsigned bytes by memcmp; try each instruction set the
+// machine has, with values of either sign.
+template<class T>
+void test_vectorized() {
+	for_each_isa([&] {
+		for (int n : {0, 1, 16, 65, 1000}) {
+			std::vector<T> a(n);
+			for (int i = 0; i < n; ++i) a[i] = static_cast<T>(i * 37 - 500);
+			auto b = a;
+			CHECK(!ranges::lexicographical_compare(a, b));
+			CHECK(!ranges::lexicographical_compare(a, b, ranges::greater{}));
+			if (n == 0) continue;
+			CHECK(ranges::lexicographical_compare(a.data(), a.data() + n - 1,
+				b.data(), b.data() + n));
+			CHECK(!ranges::lexicographical_compare(a.data(), a.data() + n,
+				b.data(), b.data() + n - 1));
+			CHECK(ranges::lexicographical_compare(a.data(), a.data() + n - 1,
+				b.data(), b.data() + n, std::greater<>{}));
+			for (int pos : {0, n / 2, n - 1}) {
+				for (T v : {T(0), T(1), static_cast<T>(-1), static_cast<T>(a[pos] + 1)}) {
+					b[pos] = v;
+					CHECK(ranges::lexicographical_compare(a, b) ==
+						std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+					CHECK(ranges::lexicographical_compare(b, a) ==
+						std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end()));
+					CHECK(ranges::lexicographical_compare(a, b, std::greater<T>{}) ==
+						std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+							std::greater<T>{}));
+					CHECK(ranges::lexicographical_compare(a, b, ranges::greater{}) ==
+						ranges::lexicographical_compare(b, a));
+				}
+				b[pos] = a[pos];
+			}
+		}
+	});
+}
+
 int main() {
+	test_vectorized<char>();
+	test_vectorized<signed char>();
+	test_vectorized<unsigned char>();
+	test_vectorized<short>();
+	test_vectorized<std::uint16_t>();
+	test_vectorized<int>();
+	test_vectorized<unsigned>();
+	test_vectorized<std::int64_t>();
+	test_vectorized<std::uint64_t>();
 	test_iter();
 	test_iter_comp();
 
@@ -0,0 +1,123 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/lower_bound_batch.hpp>
+#include <stl2/detail/algorithm/lower_bound.hpp>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	using ranges::ext::batch_strategy;
+
+	std::mt19937 gen;
+
+	struct record {
+		std::string name;
+		int key;
+	};
+
+	constexpr batch_strategy strategies[] = {
+		batch_strategy::automatic, batch_strategy::interleave, batch_strategy::merge
+	};
+
+	template<class Haystack>
+	void check_against_loop(const Haystack& sorted, const std::vector<int>& queries) {
+		using I = ranges::iterator_t<const Haystack>;
+		std::vector<I> expected;
+		for (int q : queries) expected.push_back(ranges::lower_bound(sorted, q));
+		for (auto strategy : strategies) {
+			std::vector<I> out(queries.size() + 1);
+			auto result = ranges::ext::lower_bound_batch(strategy, sorted, queries,
+				out.begin());
+			CHECK(result.in == queries.end());
+			CHECK(result.out == out.begin() + static_cast<std::ptrdiff_t>(queries.size()));
+			out.pop_back();
+			CHECK(out == expected);
+		}
+	}
+
+	void test_random() {
+		for (std::size_t n : {0, 1, 2, 3, 15, 16, 17, 100, 1000, 4097}) {
+			std::vector<int> sorted(n);
+			for (auto& x : sorted) x = static_cast<int>(gen() % (n + 1));
+			std::sort(sorted.begin(), sorted.end());
+			for (std::size_t m : {0, 1, 15, 16, 17, 33, 500}) {
+				std::vector<int> queries(m);
+				for (auto& q : queries) q = static_cast<int>(gen() % (n + 3)) - 1;
+				check_against_loop(sorted, queries);
+				const std::deque<int> deque(sorted.begin(), sorted.end());
+				check_against_loop(deque, queries);
+			}
+		}
+	}
+}
+
+int main() {
+	using ranges::ext::lower_bound_batch;
+
+	// Iterators and sentinels, with single-pass queries
+	{
+		const int sorted[] = {1, 3, 3, 5, 8, 13};
+		int queries[] = {3, 0, 14, 8, 4};
+		for (auto strategy : strategies) {
+			using I = random_access_iterator<const int*>;
+			using Q = input_iterator<int*>;
+			I out[5];
+			auto result = lower_bound_batch(strategy, I{sorted},
+				sentinel<const int*>{sorted + 6},
+				Q{queries}, sentinel<int*>{queries + 5}, out,
+				ranges::less{}, ranges::identity{});
+			CHECK(result.in.base() == queries + 5);
+			CHECK(result.out == out + 5);
+			CHECK(out[0].base() == sorted + 1);
+			CHECK(out[1].base() == sorted);
+			CHECK(out[2].base() == sorted + 6);
+			CHECK(out[3].base() == sorted + 4);
+			CHECK(out[4].base() == sorted + 3);
+		}
+	}
+
+	// A projection and a descending order
+	{
+		const std::vector<record> sorted = {{"z", 9}, {"y", 7}, {"x", 7}, {"w", 2}};
+		const std::vector<int> queries = {7, 10, 1, 2};
+		for (auto strategy : strategies) {
+			std::vector<std::vector<record>::const_iterator> out;
+			lower_bound_batch(strategy, sorted, queries, ranges::back_inserter(out),
+				std::greater<>{}, &record::key);
+			CHECK(out.size() == 4u);
+			CHECK(out[0] == sorted.begin() + 1);
+			CHECK(out[1] == sorted.begin());
+			CHECK(out[2] == sorted.end());
+			CHECK(out[3] == sorted.begin() + 3);
+		}
+	}
+
+	// Queries that are a prvalue range: the result does not refer to them.
+	{
+		const std::vector<int> sorted = {0, 2, 4};
+		std::vector<std::vector<int>::const_iterator> out(2);
+		auto result = lower_bound_batch(sorted, std::vector<int>{1, 4}, out.begin());
+		static_assert(ranges::same_as<decltype(result.in), ranges::dangling>);
+		CHECK(out[0] == sorted.begin() + 1);
+		CHECK(out[1] == sorted.begin() + 2);
+	}
+
+	test_random();
+
+	return ::test_result();
+}
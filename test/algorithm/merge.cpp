@@ -16,11 +16,21 @@
 #include <stl2/detail/algorithm/merge.hpp>
 #include <algorithm>
 #include <memory>
+#include <random>
 #include <utility>
+#include <vector>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
 
+namespace {
+	struct record {
+		int key;
+		int source;
+		bool operator==(const record&) const = default;
+	};
+}
+
 int main() {
 	{
 		unsigned N = 100000;
@@ -82,5 +92,41 @@ int main() {
 		CHECK(std::is_sorted(ic.get(), ic.get() + 2 * N));
 	}
 
+	// Equivalent elements of the first range precede those of the second
+	{
+		std::pair<int, int> a[] = {{0, 0}, {1, 0}, {1, 0}, {2, 0}};
+		std::pair<int, int> b[] = {{1, 1}, {2, 1}, {2, 1}, {3, 1}};
+		std::pair<int, int> c[8];
+		ranges::merge(a, b, c, ranges::less{}, &std::pair<int, int>::first,
+			&std::pair<int, int>::first);
+		std::pair<int, int> expected[] = {{0, 0}, {1, 0}, {1, 0}, {1, 1}, {2, 0},
+			{2, 1}, {2, 1}, {3, 1}};
+		CHECK(std::equal(c, c + 8, expected));
+	}
+
+	// Small trivially copyable elements are merged without branching on
+	// the comparisons, to the same result.
+	{
+		std::mt19937 gen;
+		for (std::size_t n1 : {0, 1, 2, 17, 500}) {
+			for (std::size_t n2 : {0, 1, 3, 64, 1000}) {
+				std::vector<record> a(n1), b(n2);
+				for (auto& x : a) x = {static_cast<int>(gen() % 100), 1};
+				for (auto& x : b) x = {static_cast<int>(gen() % 100), 2};
+				auto by_key = [](const record& x, const record& y) { return x.key < y.key; };
+				std::sort(a.begin(), a.end(), by_key);
+				std::sort(b.begin(), b.end(), by_key);
+				std::vector<record> expected(n1 + n2), actual(n1 + n2);
+				std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin(), by_key);
+				auto r = ranges::merge(a, b, actual.begin(), ranges::less{}, &record::key,
+					&record::key);
+				CHECK(r.in1 == a.end());
+				CHECK(r.in2 == b.end());
+				CHECK(r.out == actual.end());
+				CHECK(actual == expected);
+			}
+		}
+	}
+
 	return ::test_result();
 }
@@ -23,7 +23,9 @@
 #include <random>
 #include <numeric>
 #include <algorithm>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
 
@@ -141,6 +143,21 @@ test_iter_comp()
 	test_iter_comp<Iter, Sent>(1000);
 }
 
+// Elements drawn from seven values, so that the least repeats and the
+// kernels must find its first occurrence, as the projected scalar loop does.
+template<class T, class Comp>
+void test_vectorized(Comp comp) {
+	namespace simd = stl2::detail::simd;
+	static_assert(simd::extremum_scannable<T*, T*, Comp, stl2::identity>);
+	for_each_isa([&] {
+		for (int n : {0, 1, 2, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+			std::vector<T> v(n);
+			for (auto& x : v) x = static_cast<T>(static_cast<T>(gen() % 7) - T(3));
+			CHECK(stl2::min_element(v, comp) == stl2::min_element(v, comp, [](T x) { return x; }));
+		}
+	});
+}
+
 struct S
 {
 	int i;
@@ -169,5 +186,11 @@ int main()
 	S const *ps = stl2::min_element(s, std::less<int>{}, &S::i);
 	CHECK(ps->i == -4);
 
+	test_vectorized<int>(stl2::less{});
+	test_vectorized<unsigned>(stl2::greater{});
+	test_vectorized<long>(std::less<long>{});
+	test_vectorized<float>(std::greater<>{});
+	test_vectorized<double>(stl2::less{});
+
 	return test_result();
 }
@@ -22,8 +22,10 @@
 #include <memory>
 #include <numeric>
 #include <random>
+#include <vector>
 #include <algorithm>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
 
@@ -167,6 +169,43 @@ void test_iter_comp() {
 	}
 }
 
+// Elements drawn from few values, so that the extrema repeat and the
+// kernels must pick the first least and the last greatest; for unsigned
+// types, the values lie on both sides of the sign bit.
+template<class T, class Comp>
+void test_vectorized(Comp comp) {
+	namespace simd = ranges::detail::simd;
+	static_assert(simd::extremum_scannable<T*, T*, Comp, ranges::identity>);
+	for_each_isa([&] {
+		for (int n : {0, 1, 2, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+			std::vector<T> v(n);
+			for (auto& x : v) x = static_cast<T>(static_cast<T>(gen() % 7) - T(3));
+			auto p = ranges::minmax_element(v, comp);
+			auto ref = ranges::minmax_element(v, comp, [](T x) { return x; });
+			CHECK(p.min == ref.min);
+			CHECK(p.max == ref.max);
+		}
+	});
+}
+
+void test_vectorized() {
+	test_vectorized<int>(ranges::less{});
+	test_vectorized<int>(ranges::greater{});
+	test_vectorized<unsigned>(std::less<>{});
+	test_vectorized<long long>(std::greater<long long>{});
+	test_vectorized<unsigned long long>(ranges::less{});
+	test_vectorized<float>(ranges::less{});
+	test_vectorized<double>(ranges::greater{});
+
+	// Negative and positive zero are equivalent: the first is least, and
+	// the last greatest.
+	std::vector<double> zeros(40, 0.0);
+	zeros[3] = zeros[38] = -0.0;
+	auto p = ranges::minmax_element(zeros);
+	CHECK(p.min == zeros.begin());
+	CHECK(p.max == zeros.end() - 1);
+}
+
 struct S {
 	int i;
 };
@@ -195,5 +234,7 @@ int main() {
 	CHECK(ps.min->i == -4);
 	CHECK(ps.max->i == 40);
 
+	test_vectorized();
+
 	return test_result();
 }
@@ -21,7 +21,10 @@
 #include <stl2/detail/algorithm/mismatch.hpp>
 #include <memory>
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
 
@@ -34,6 +37,34 @@ STL2_OPEN_NAMESPACE {
 
 namespace ranges = __stl2;
 
+// Contiguous integers are compared a vector at a time; try each
+// instruction set the machine has.
+template<class T>
+void test_vectorized() {
+	for_each_isa([&] {
+		for (int n : {0, 1, 15, 16, 17, 64, 257, 1000}) {
+			std::vector<T> a(n);
+			for (int i = 0; i < n; ++i) a[i] = static_cast<T>(i * 37 + 5);
+			auto b = a;
+			auto res = ranges::mismatch(a, b);
+			CHECK(res.in1 == a.end());
+			CHECK(res.in2 == b.end());
+			if (n == 0) continue;
+			auto shorter = ranges::mismatch(a.data(), a.data() + n, b.data(), b.data() + n - 1);
+			CHECK(shorter.in1 == a.data() + n - 1);
+			CHECK(shorter.in2 == b.data() + n - 1);
+			for (int pos : {0, n / 3, n / 2 + 1, n - 1}) {
+				if (pos >= n) continue;
+				b[pos] = static_cast<T>(a[pos] ^ T(1));
+				res = ranges::mismatch(a, b);
+				CHECK((res.in1 - a.begin()) == pos);
+				CHECK((res.in2 - b.begin()) == pos);
+				b[pos] = a[pos];
+			}
+		}
+	});
+}
+
 template<typename Iter, typename Sent = Iter>
 void test_range() {
 	using S = ranges::subrange<Iter, Sent>;
@@ -113,5 +144,10 @@ int main() {
 		CHECK(ps2.in2->i == 5);
 	}
 
+	test_vectorized<char>();
+	test_vectorized<std::uint16_t>();
+	test_vectorized<int>();
+	test_vectorized<long long>();
+
 	return test_result();
 }
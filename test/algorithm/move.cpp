@@ -237,5 +237,16 @@ int main() {
 	test1<random_access_iterator<std::unique_ptr<int>*>, bidirectional_iterator<std::unique_ptr<int>*>, sentinel<std::unique_ptr<int>*> >();
 	test1<random_access_iterator<std::unique_ptr<int>*>, random_access_iterator<std::unique_ptr<int>*>, sentinel<std::unique_ptr<int>*> >();
 
+	// The bounded extension, moving a block at a time
+	{
+		int ia[] = {1, 2, 3, 4, 5};
+		int ib[3] = {};
+		auto r = ranges::ext::move(ia, ib);
+		CHECK(r.in == ia + 3);
+		CHECK(r.out == ib + 3);
+		CHECK(ib[0] == 1);
+		CHECK(ib[2] == 3);
+	}
+
 	return test_result();
 }
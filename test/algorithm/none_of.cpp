@@ -77,5 +77,15 @@ int main()
 		CHECK(ranges::none_of(std::move(il), &S::p));
 	}
 
+	{
+		std::vector<int> v(1000, 1);
+		CHECK(ranges::none_of(v, ranges::ext::equal_to_value{2}));
+		CHECK(!ranges::none_of(v, ranges::ext::equal_to_value{1}));
+		CHECK(ranges::none_of(v, ranges::ext::not_equal_to_value{1}));
+		v[999] = 2;
+		CHECK(!ranges::none_of(v, ranges::ext::equal_to_value{2}));
+		CHECK(!ranges::none_of(v.begin(), v.end(), ranges::ext::not_equal_to_value{1}));
+	}
+
 	return ::test_result();
 }
@@ -22,6 +22,7 @@
 #include <cassert>
 #include <memory>
 #include <random>
+#include <vector>
 #include <algorithm>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
@@ -66,6 +67,46 @@ test(unsigned N)
 	test_one(N, N-1);
 }
 
+// Patterns that defeat median-of-3 pivots, which must still select the
+// right element within a bounded number of comparisons.
+void
+test_patterns(int N)
+{
+	std::vector<int> v(N);
+	long comparisons = 0;
+	auto counting_less = [&](int a, int b) { ++comparisons; return a < b; };
+	auto check = [&](int M) {
+		auto sorted = v;
+		std::sort(sorted.begin(), sorted.end());
+		comparisons = 0;
+		CHECK(stl2::nth_element(v, v.begin() + M, counting_less) == v.end());
+		CHECK(v[M] == sorted[M]);
+		CHECK(std::all_of(v.begin(), v.begin() + M, [&](int x) { return x <= v[M]; }));
+		CHECK(std::all_of(v.begin() + M, v.end(), [&](int x) { return x >= v[M]; }));
+		CHECK(comparisons <= 20L * N);
+	};
+
+	// organ pipe
+	for (int i = 0; i < N; ++i)
+		v[i] = i < N / 2 ? i : N - i;
+	check(N / 2);
+	// Musser's median-of-3 killer
+	const int K = N / 2;
+	for (int i = 1; i <= K; ++i) {
+		if (i % 2) {
+			v[i - 1] = i;
+			v[i] = K + i;
+		}
+		v[K + i - 1] = 2 * i;
+	}
+	check(K);
+	check(N - 1);
+	// few distinct values
+	for (int i = 0; i < N; ++i)
+		v[i] = (i * 7919) % 100;
+	check(N / 3);
+}
+
 struct S
 {
 	int i,j;
@@ -84,6 +125,9 @@ int main()
 	test(1000);
 	test(1009);
 
+	test_patterns(100000);
+	test_patterns(4096);
+
 	// Works with projections?
 	const int N = 257;
 	const int M = 56;
@@ -128,6 +128,41 @@ test_larger_sorts(int N)
 	test_larger_sorts(N, N);
 }
 
+// Large prefixes are selected with nth_element before sorting; check
+// shapes that go either way, with duplicates.
+void
+test_large_prefixes(int N)
+{
+	std::vector<int> v(N);
+	auto check = [&](std::vector<int> const& orig, int M) {
+		std::vector<int> expected = orig;
+		std::sort(expected.begin(), expected.end());
+		v = orig;
+		auto res = stl2::partial_sort(v, v.begin() + M);
+		CHECK(res == v.end());
+		CHECK(std::equal(v.begin(), v.begin() + M, expected.begin()));
+		std::sort(v.begin() + M, v.end());
+		CHECK(v == expected);
+	};
+	std::vector<int> orig(N);
+	for (int M : {N / 300, N / 100, N / 2, N - 1, N}) {
+		for(int i = 0; i < N; ++i)
+			orig[i] = i;
+		std::shuffle(orig.begin(), orig.end(), gen);
+		check(orig, M);
+		for(int i = 0; i < N; ++i)
+			orig[i] = i % 17;
+		std::shuffle(orig.begin(), orig.end(), gen);
+		check(orig, M);
+		for(int i = 0; i < N; ++i)
+			orig[i] = i < N / 2 ? i : N - i;
+		check(orig, M);
+		for(int i = 0; i < N; ++i)
+			orig[i] = N - i;
+		check(orig, M);
+	}
+}
+
 struct S
 {
 	int i, j;
@@ -147,6 +182,7 @@ int main()
 	test_larger_sorts(997);
 	test_larger_sorts(1000);
 	test_larger_sorts(1009);
+	test_large_prefixes(100000);
 
 	// Check move-only types
 	{
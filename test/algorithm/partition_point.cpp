@@ -25,8 +25,11 @@
 #include <stl2/detail/algorithm/partition_point.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/view/iota.hpp>
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <utility>
+#include <vector>
 #include "../simple_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
@@ -191,6 +194,30 @@ void test_counted() {
 	}
 }
 
+// The branchless search over random-access ranges, through plain and
+// counted iterators, and the bisection over forward ones, against the
+// standard one.
+void test_partition_point_n() {
+	std::mt19937 gen;
+	for (int n = 0; n < 200; ++n) {
+		std::vector<int> sorted(n);
+		for (auto& x : sorted) x = static_cast<int>(gen() % (n + 1));
+		std::sort(sorted.begin(), sorted.end());
+		for (int x = -1; x <= n + 1; ++x) {
+			auto const pred = [x](int y) { return y < x; };
+			auto const expected = std::partition_point(sorted.begin(), sorted.end(), pred);
+			CHECK(ranges::ext::partition_point_n(sorted.begin(), n, pred) == expected);
+			auto const counted = ranges::ext::partition_point_n(
+				ranges::counted_iterator{sorted.begin(), n}, n, pred);
+			CHECK(counted.base() == expected);
+			CHECK(counted.count() == sorted.end() - expected);
+			using I = forward_iterator<const int*>;
+			CHECK(ranges::ext::partition_point_n(I{sorted.data()}, n, pred).base() ==
+				sorted.data() + (expected - sorted.begin()));
+		}
+	}
+}
+
 struct S {
 	int i;
 };
@@ -204,6 +231,8 @@ int main() {
 
 	test_counted<forward_iterator<const int*> >();
 
+	test_partition_point_n();
+
 	// Test projections
 	const S ia[] = {S{1}, S{3}, S{5}, S{2}, S{4}, S{6}};
 	CHECK(ranges::partition_point(ia, is_odd(), &S::i) == ia + 3);
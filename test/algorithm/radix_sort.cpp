@@ -0,0 +1,163 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/radix_sort.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937_64 gen;
+
+	template<class K>
+	struct record {
+		K key;
+		int id;
+	};
+
+	template<class K>
+	std::vector<K> make_keys(std::size_t n) {
+		std::vector<K> v(n);
+		if constexpr (std::is_floating_point_v<K>) {
+			std::uniform_real_distribution<K> dist(-1e6, 1e6);
+			for (auto& k : v) k = dist(gen);
+		} else {
+			for (auto& k : v) k = static_cast<K>(gen());
+		}
+		return v;
+	}
+
+	template<class K>
+	void test_keys(std::size_t n) {
+		auto v = make_keys<K>(n);
+		auto w = v;
+		CHECK(ranges::ext::radix_sort(w) == w.end());
+		CHECK(std::is_sorted(w.begin(), w.end()));
+		std::sort(v.begin(), v.end());
+		CHECK(w == v);
+
+		w = v;
+		CHECK(ranges::ext::radix_sort(w.begin(), w.end(), ranges::greater{}) == w.end());
+		CHECK(std::is_sorted(w.begin(), w.end(), std::greater<K>{}));
+
+		// Few distinct keys exercise the skipped passes and equal buckets.
+		for (auto& k : w) k = static_cast<K>(static_cast<int>(k) % 3);
+		CHECK(ranges::ext::radix_sort(w, std::less<K>{}) == w.end());
+		CHECK(std::is_sorted(w.begin(), w.end()));
+	}
+
+	template<class K>
+	void test_records(std::size_t n) {
+		auto keys = make_keys<K>(n);
+		std::vector<record<K>> v(n);
+		for (std::size_t i = 0; i < n; ++i) v[i] = {keys[i], static_cast<int>(i)};
+		CHECK(ranges::ext::radix_sort(v, ranges::less{}, &record<K>::key) == v.end());
+		CHECK(std::is_sorted(v.begin(), v.end(),
+			[](auto const& a, auto const& b) { return a.key < b.key; }));
+		std::vector<bool> seen(n);
+		for (auto const& r : v) {
+			CHECK(r.key == keys[r.id]);
+			CHECK(!seen[r.id]);
+			seen[r.id] = true;
+		}
+	}
+
+	template<class K>
+	void test_all_sizes() {
+		for (std::size_t n : {0, 1, 2, 3, 47, 48, 49, 300, 5000, 70000}) {
+			test_keys<K>(n);
+			test_records<K>(n);
+		}
+	}
+}
+
+int main() {
+	test_all_sizes<std::int8_t>();
+	test_all_sizes<std::uint8_t>();
+	test_all_sizes<std::int16_t>();
+	test_all_sizes<std::int32_t>();
+	test_all_sizes<std::uint32_t>();
+	test_all_sizes<std::int64_t>();
+	test_all_sizes<std::uint64_t>();
+	test_all_sizes<float>();
+	test_all_sizes<double>();
+
+	// Special floating-point values and integral extremes.
+	{
+		constexpr double inf = std::numeric_limits<double>::infinity();
+		std::vector<double> v{0.0, -inf, 1.5, -0.0, inf, -1.5,
+			std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::max(),
+			std::numeric_limits<double>::lowest(), -std::numeric_limits<double>::denorm_min()};
+		ranges::ext::radix_sort(v);
+		CHECK(std::is_sorted(v.begin(), v.end()));
+		CHECK(v.front() == -inf);
+		CHECK(v.back() == inf);
+		CHECK(std::signbit(v[5]));
+		CHECK(!std::signbit(v[6]));
+
+		std::vector<int> w{0, std::numeric_limits<int>::max(), -1, 1,
+			std::numeric_limits<int>::min()};
+		ranges::ext::radix_sort(w, ranges::greater{});
+		CHECK_EQUAL(w, {std::numeric_limits<int>::max(), 1, 0, -1,
+			std::numeric_limits<int>::min()});
+	}
+
+	// Elements that are not trivially copyable take the in-place MSD path.
+	{
+		std::vector<std::unique_ptr<long>> v;
+		auto keys = make_keys<long>(20000);
+		for (auto k : keys) v.push_back(std::make_unique<long>(k));
+		ranges::ext::radix_sort(v, ranges::less{}, [](auto const& p) { return *p; });
+		CHECK(std::is_sorted(v.begin(), v.end(),
+			[](auto const& a, auto const& b) { return *a < *b; }));
+	}
+
+	// Iterators that are not pointers.
+	{
+		auto v = make_keys<unsigned>(3000);
+		using I = random_access_iterator<unsigned*>;
+		auto r = ranges::ext::radix_sort(I{v.data()}, sentinel<unsigned*>{v.data() + v.size()});
+		CHECK(r == I{v.data() + v.size()});
+		CHECK(std::is_sorted(v.begin(), v.end()));
+	}
+
+	// rvalue ranges
+	{
+		auto r = ranges::ext::radix_sort(make_keys<int>(10));
+		static_assert(ranges::same_as<decltype(r), ranges::dangling>);
+	}
+
+	// sort dispatches to radix_sort only for builtin orders on
+	// arithmetic keys.
+	{
+		static_assert(ranges::detail::radix_sortable<int*, ranges::less, ranges::identity>);
+		static_assert(ranges::detail::radix_sortable<double*, std::greater<double>, ranges::identity>);
+		static_assert(ranges::detail::radix_sortable<record<float>*, ranges::less, decltype(&record<float>::key)>);
+		static_assert(!ranges::detail::radix_sortable<double*, std::less<int>, ranges::identity>);
+		static_assert(!ranges::detail::radix_sortable<int*, ranges::less_equal, ranges::identity>);
+		static_assert(!ranges::detail::radix_sortable<long double*, ranges::less, ranges::identity>);
+		static_assert(!ranges::detail::radix_sortable<std::string*, ranges::less, ranges::identity>);
+
+		auto v = make_keys<double>(100000);
+		ranges::sort(v, ranges::greater{});
+		CHECK(std::is_sorted(v.begin(), v.end(), std::greater<double>{}));
+	}
+
+	return ::test_result();
+}
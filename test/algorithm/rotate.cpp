@@ -23,6 +23,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/rotate.hpp>
+#include <memory>
 #include <utility>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
@@ -250,6 +251,25 @@ void test()
 	CHECK(ig[5] == 2);
 }
 
+// Elements better relocated than moved
+template<class Iter>
+void test_relocating()
+{
+	using P = std::unique_ptr<int>;
+	for (int k : {1, 3, 4, 5, 9}) {
+		P ig[10];
+		for (int i = 0; i < 10; ++i) {
+			ig[i] = std::make_unique<int>(i);
+		}
+		auto r = ranges::rotate(Iter(ig), Iter(ig + k), Iter(ig + 10));
+		CHECK(base(r.begin()) == ig + (10 - k));
+		CHECK(base(r.end()) == ig + 10);
+		for (int i = 0; i < 10; ++i) {
+			CHECK(*ig[i] == (i + k) % 10);
+		}
+	}
+}
+
 int main()
 {
 	test<forward_iterator<int *>>();
@@ -260,6 +280,11 @@ int main()
 	test<bidirectional_iterator<int *>, sentinel<int*>>();
 	test<random_access_iterator<int *>, sentinel<int*>>();
 
+	test_relocating<forward_iterator<std::unique_ptr<int>*>>();
+	test_relocating<bidirectional_iterator<std::unique_ptr<int>*>>();
+	test_relocating<random_access_iterator<std::unique_ptr<int>*>>();
+	test_relocating<std::unique_ptr<int>*>();
+
 	// test rvalue range
 	{
 		int rgi[] = {0,1,2,3,4,5};
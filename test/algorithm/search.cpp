@@ -23,10 +23,16 @@
 //===----------------------------------------------------------------------===//
 
 #include <stl2/detail/algorithm/search.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
 
@@ -202,6 +208,59 @@ test()
 	test_range<Iter1, Iter2>();
 }
 
+// Contiguous bytes are searched by first and last element a vector at a
+// time, falling back to Two-Way when false candidates abound, as with
+// periodic texts; other totally ordered values are searched by Two-Way.
+// Either must agree with the naive search of std::search.
+template<class C>
+void test_linear()
+{
+	std::mt19937 gen;
+	for_each_isa([&] {
+		for (int alphabet : {2, 3, 26}) {
+			std::uniform_int_distribution<int> dist(0, alphabet - 1);
+			for (int n : {0, 1, 5, 63, 64, 65, 300, 3000}) {
+				std::vector<C> text(n);
+				for (auto& c : text) c = static_cast<C>('a' + dist(gen));
+				for (int m : {1, 2, 3, 4, 7, 16, 40, 70}) {
+					for (int trial = 0; trial < 4; ++trial) {
+						std::vector<C> pattern(m);
+						if (trial < 2 && m <= n) {
+							const int at = std::uniform_int_distribution<int>(0, n - m)(gen);
+							std::copy(text.begin() + at, text.begin() + at + m, pattern.begin());
+							if (trial == 1) pattern[m / 2] = static_cast<C>('a' + dist(gen));
+						} else {
+							for (auto& c : pattern) c = static_cast<C>('a' + dist(gen));
+						}
+						const auto expected = std::search(text.begin(), text.end(),
+							pattern.begin(), pattern.end());
+						const auto result = ranges::search(text, pattern);
+						CHECK(result.begin() == expected);
+						CHECK(result.end() == (expected == text.end() ? text.end() : expected + m));
+					}
+				}
+			}
+		}
+	});
+
+	// Worst cases for the filter: a periodic text, and patterns that match
+	// it everywhere but in the middle.
+	for_each_isa([&] {
+		std::vector<C> text(100000, C('a'));
+		text.back() = C('b');
+		for (int m : {3, 17, 60}) {
+			std::vector<C> pattern(m, C('a'));
+			pattern.back() = C('b');
+			auto result = ranges::search(text, pattern);
+			CHECK((result.begin() - text.begin()) == 100000 - m);
+			pattern.back() = C('a');
+			pattern[m / 2] = C('b');
+			result = ranges::search(text, pattern);
+			CHECK(result.begin() == text.end());
+		}
+	});
+}
+
 struct S
 {
 	int i;
@@ -254,6 +313,20 @@ int main()
 		CHECK((e - b) == 0);
 	}
 
+	test_linear<char>();
+	test_linear<unsigned char>();
+	test_linear<int>();
+	test_linear<std::uint64_t>();
+
+	// Patterns of strings are searched by Two-Way too.
+	{
+		std::vector<std::string> text{"a", "b", "a", "b", "a", "c", "a", "b"};
+		std::vector<std::string> pattern{"a", "b", "a", "c"};
+		auto result = ranges::search(text, pattern);
+		CHECK(result.begin() == text.begin() + 2);
+		CHECK(result.end() == text.begin() + 6);
+	}
+
 	// Test rvalue ranges
 	{
 		int ib[] = {0, 1, 2, 0, 1, 2, 3, 0, 1, 2, 3, 4};
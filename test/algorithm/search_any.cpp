@@ -0,0 +1,152 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/search_any.hpp>
+#include <stl2/view/join.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <forward_list>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	// The leftmost, then longest, occurrence of any pattern, by brute force.
+	std::pair<std::size_t, std::size_t> brute_force(std::string_view text,
+		const std::vector<std::string>& patterns)
+	{
+		for (std::size_t i = 0; i < text.size(); ++i) {
+			std::size_t best = patterns.size();
+			for (std::size_t p = 0; p < patterns.size(); ++p) {
+				if (!patterns[p].empty() && text.substr(i).starts_with(patterns[p]) &&
+					(best == patterns.size() || patterns[p].size() > patterns[best].size()))
+				{
+					best = p;
+				}
+			}
+			if (best != patterns.size()) return {i, best};
+		}
+		return {text.size(), patterns.size()};
+	}
+
+	void test_random() {
+		for (int alphabet : {2, 3, 26}) {
+			std::uniform_int_distribution<int> letter(0, alphabet - 1);
+			for (int k : {1, 2, 10, 100}) {
+				std::vector<std::string> patterns(k);
+				for (auto& p : patterns) {
+					p.resize(std::uniform_int_distribution<int>(1, 8)(gen));
+					for (auto& c : p) c = static_cast<char>('a' + letter(gen));
+				}
+				const ranges::ext::aho_corasick ac{patterns};
+				for (int n : {0, 1, 10, 200}) {
+					std::string text(n, ' ');
+					for (auto& c : text) c = static_cast<char>('a' + letter(gen));
+					const auto [start, p] = brute_force(text, patterns);
+					const auto m = ranges::ext::search_any(text, ac);
+					CHECK(static_cast<std::size_t>(m.begin() - text.begin()) == start);
+					CHECK(m.pattern == p);
+					if (p != patterns.size()) {
+						CHECK(static_cast<std::size_t>(m.end() - m.begin()) == patterns[p].size());
+					} else {
+						CHECK(m.begin() == text.end());
+						CHECK(m.end() == text.end());
+					}
+				}
+			}
+		}
+	}
+}
+
+int main() {
+	using ranges::ext::search_any, ranges::ext::aho_corasick;
+
+	// Leftmost, then longest
+	{
+		const std::string_view text = "she sells seashells";
+		const std::vector<std::string> patterns{"he", "sells", "shells", "hell", "she"};
+		auto m = search_any(text, patterns);
+		CHECK(m.begin() == text.begin());
+		CHECK(m.end() == text.begin() + 3);
+		CHECK(m.pattern == 4u);
+
+		const aho_corasick ac{std::vector<std::string>{"abcd", "bc", "bcdef"}};
+		const std::string_view abcde = "xabcdex";
+		m = search_any(abcde, ac);
+		CHECK((m.begin() - abcde.begin()) == 1);
+		CHECK((m.end() - abcde.begin()) == 5);
+		CHECK(m.pattern == 0u);
+	}
+
+	// No match, no patterns, empty patterns
+	{
+		const std::string_view text = "abc";
+		auto m = search_any(text, std::vector<std::string>{"abd", "x"});
+		CHECK(m.begin() == text.end());
+		CHECK(m.end() == text.end());
+		CHECK(m.pattern == 2u);
+		m = search_any(text, aho_corasick{});
+		CHECK(m.begin() == text.end());
+		CHECK(m.pattern == 0u);
+		m = search_any(text, std::vector<std::string>{"", "c"});
+		CHECK((m.begin() - text.begin()) == 2);
+		CHECK(m.pattern == 1u);
+	}
+
+	// Forward iterators, sentinels and bytes
+	{
+		const std::forward_list<unsigned char> text{'a', 'x', 'y', 'z', 'b'};
+		const std::vector<std::string> patterns{"xyz", "yz"};
+		const auto m = search_any(text, patterns);
+		CHECK(m.begin() == std::next(text.begin()));
+		CHECK(m.end() == std::next(text.begin(), 4));
+
+		// Nothing to match, and no history to keep
+		auto none = search_any(text, aho_corasick{});
+		CHECK(none.begin() == text.end());
+		CHECK(none.pattern == 0u);
+		none = search_any(text, std::vector<std::string>{""});
+		CHECK(none.begin() == text.end());
+		CHECK(none.pattern == 1u);
+
+		const char chars[] = "--needle--";
+		using I = forward_iterator<const char*>;
+		const auto n = search_any(I{chars}, sentinel<const char*>{chars + 10},
+			aho_corasick{std::vector<std::string>{"needle"}});
+		CHECK(n.begin().base() == chars + 2);
+		CHECK(n.end().base() == chars + 8);
+
+		const std::byte bytes[] = {std::byte{1}, std::byte{0}, std::byte{255}};
+		const std::vector<std::vector<std::byte>> byte_patterns{{std::byte{0}, std::byte{255}}};
+		CHECK(search_any(bytes, byte_patterns).begin() == bytes + 1);
+	}
+
+	// Matches across the pieces of a joined range
+	{
+		const std::vector<std::string> lines{"GET /ind", "ex.html", " 200 OK"};
+		const std::vector<std::string> patterns{"index", "200"};
+		auto joined = ranges::views::join(lines);
+		const auto m = search_any(joined, patterns);
+		CHECK(m.pattern == 0u);
+		std::string found;
+		for (char c : m) found += c;
+		CHECK(found == "index");
+	}
+
+	test_random();
+
+	return ::test_result();
+}
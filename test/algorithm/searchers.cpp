@@ -0,0 +1,148 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/searchers.hpp>
+#include <stl2/detail/algorithm/search.hpp>
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	// Orders characters ignoring case, counting its calls.
+	struct case_insensitive_less {
+		static inline long calls = 0;
+
+		bool operator()(char a, char b) const {
+			++calls;
+			return std::tolower(static_cast<unsigned char>(a)) <
+				std::tolower(static_cast<unsigned char>(b));
+		}
+	};
+
+	struct point {
+		int x, y;
+		bool operator==(const point&) const = default;
+	};
+
+	struct point_hash {
+		std::size_t operator()(const point& p) const {
+			return std::hash<int>{}(p.x * 31 + p.y);
+		}
+	};
+
+	template<class Searcher>
+	void check_against_std(const std::string& text, const std::string& pattern,
+		const Searcher& searcher)
+	{
+		const auto expected = std::search(text.begin(), text.end(),
+			pattern.begin(), pattern.end());
+		const auto result = ranges::search(text, searcher);
+		CHECK(result.begin() == expected);
+		CHECK(result.end() == (expected == text.end() ? text.end() :
+			expected + static_cast<std::ptrdiff_t>(pattern.size())));
+	}
+
+	void test_random() {
+		for (int alphabet : {1, 2, 4, 26}) {
+			std::uniform_int_distribution<int> dist(0, alphabet - 1);
+			for (int n : {0, 1, 10, 100, 1000}) {
+				std::string text(n, ' ');
+				for (auto& c : text) c = static_cast<char>('a' + dist(gen));
+				for (int m : {0, 1, 2, 5, 13, 40}) {
+					for (int trial = 0; trial < 3; ++trial) {
+						std::string pattern(m, ' ');
+						if (trial == 0 && m <= n) {
+							const int at = std::uniform_int_distribution<int>(0, n - m)(gen);
+							pattern = text.substr(at, m);
+						} else {
+							for (auto& c : pattern) c = static_cast<char>('a' + dist(gen));
+						}
+						check_against_std(text, pattern,
+							ranges::ext::two_way_searcher(pattern.begin(), pattern.end()));
+						check_against_std(text, pattern,
+							ranges::ext::boyer_moore_horspool_searcher(pattern));
+					}
+				}
+			}
+		}
+	}
+}
+
+int main() {
+	using ranges::ext::two_way_searcher, ranges::ext::boyer_moore_horspool_searcher;
+
+	// Iterator and sentinel
+	{
+		const std::string_view text = "here is a simple example";
+		const std::string_view pattern = "example";
+		using I = random_access_iterator<const char*>;
+		const auto first = I{text.data()};
+		const auto last = sentinel<const char*, true>{text.data() + text.size()};
+		const two_way_searcher tw{pattern};
+		auto result = ranges::search(first, last, tw);
+		CHECK((result.begin().base() - text.data()) == 17);
+		CHECK((result.end().base() - text.data()) == 24);
+		const boyer_moore_horspool_searcher bmh{pattern.begin(), pattern.end()};
+		result = ranges::search(first, last, bmh);
+		CHECK((result.begin().base() - text.data()) == 17);
+		CHECK((result.end().base() - text.data()) == 24);
+
+		const two_way_searcher missing{std::string_view{"examples"}};
+		CHECK(ranges::search(text, missing).begin() == text.end());
+		const two_way_searcher empty{std::string_view{}};
+		CHECK(ranges::search(text, empty).begin() == text.begin());
+		CHECK(ranges::search(text, empty).end() == text.begin());
+	}
+
+	// Equivalence under a comparison, with a linear bound on its calls
+	{
+		std::string text(10000, 'a');
+		text += "AAB";
+		const std::string pattern = "aaaaaaaaaab";
+		const two_way_searcher tw{pattern, case_insensitive_less{}};
+		case_insensitive_less::calls = 0;
+		const auto result = ranges::search(text, tw);
+		CHECK((result.begin() - text.begin()) == 10003 - 11);
+		CHECK(case_insensitive_less::calls <= 4 * 10003);
+	}
+
+	// Keys without a byte table
+	{
+		std::vector<point> text;
+		for (int i = 0; i < 100; ++i) text.push_back({i % 7, i % 3});
+		const std::vector<point> pattern(text.begin() + 40, text.begin() + 50);
+		const boyer_moore_horspool_searcher bmh{pattern, point_hash{}};
+		const auto result = ranges::search(text, bmh);
+		CHECK(result.begin() == text.begin() + 19);
+		CHECK(result.end() == result.begin() + 10);
+	}
+
+	// Compile-time
+	{
+		static_assert([] {
+			const int text[] = {1, 2, 1, 2, 1, 3, 1, 2, 1, 2};
+			const int pattern[] = {1, 2, 1, 3};
+			const auto result = ranges::search(text, two_way_searcher{pattern});
+			return result.begin() == text + 2 && result.end() == text + 6;
+		}());
+	}
+
+	test_random();
+
+	return ::test_result();
+}
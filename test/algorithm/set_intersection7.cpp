@@ -0,0 +1,159 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/set_intersection.hpp>
+#include <stl2/detail/algorithm/set_difference.hpp>
+#include <stl2/detail/algorithm/includes.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../simd_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	struct record {
+		int key;
+		int tag;
+	};
+
+	template<class T>
+	std::vector<T> sorted_sample(std::size_t n, std::uint64_t spread) {
+		std::vector<T> v(n);
+		for (auto& x : v) x = static_cast<T>(gen() % (spread + 1));
+		std::sort(v.begin(), v.end());
+		return v;
+	}
+
+	// The element-wise algorithms, whose results the galloping and the
+	// vector kernels must reproduce exactly, down to where they stop.
+	template<class T>
+	void check_against_loop(const std::vector<T>& a, const std::vector<T>& b) {
+		{
+			std::vector<T> expected;
+			auto i = a.begin();
+			auto j = b.begin();
+			while (i != a.end() && j != b.end()) {
+				if (*i < *j) ++i;
+				else if (*j < *i) ++j;
+				else { expected.push_back(*i); ++i; ++j; }
+			}
+			std::vector<T> out(std::min(a.size(), b.size()) + 1);
+			auto result = ranges::set_intersection(a, b, out.begin());
+			CHECK(result.in1 == i);
+			CHECK(result.in2 == j);
+			out.resize(static_cast<std::size_t>(result.out - out.begin()));
+			CHECK(out == expected);
+		}
+		{
+			std::vector<T> expected;
+			std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+				std::back_inserter(expected));
+			std::vector<T> out(a.size() + 1);
+			auto result = ranges::set_difference(a, b, out.begin());
+			CHECK(result.in == a.end());
+			out.resize(static_cast<std::size_t>(result.out - out.begin()));
+			CHECK(out == expected);
+		}
+		CHECK(ranges::includes(a, b) ==
+			std::includes(a.begin(), a.end(), b.begin(), b.end()));
+		CHECK(ranges::includes(b, a) ==
+			std::includes(b.begin(), b.end(), a.begin(), a.end()));
+	}
+
+	// Sorted integers are intersected a block at a time by the vector
+	// kernels; try each instruction set the machine has.
+	template<class T>
+	void test_random() {
+		for_each_isa([&] {
+			for (std::size_t n : {0, 1, 15, 16, 17, 63, 64, 65, 300, 2000}) {
+				for (std::size_t m : {0, 1, 17, 64, 300, 2000}) {
+					// Distinct-heavy and duplicate-heavy inputs
+					for (std::uint64_t spread : {4 * (n + m), (n + m) / 4}) {
+						auto a = sorted_sample<T>(n, spread);
+						auto b = sorted_sample<T>(m, spread);
+						check_against_loop(a, b);
+						a.erase(std::unique(a.begin(), a.end()), a.end());
+						b.erase(std::unique(b.begin(), b.end()), b.end());
+						check_against_loop(a, b);
+					}
+				}
+			}
+			// Skewed sizes, where the short range gallops through the long
+			auto const big = sorted_sample<T>(100000, 1000000);
+			for (std::size_t m : {1, 10, 100, 1000}) {
+				auto small = sorted_sample<T>(m, 1000000);
+				check_against_loop(small, big);
+				check_against_loop(big, small);
+				for (std::size_t k = 0; k < m; ++k) small[k] = big[gen() % big.size()];
+				std::sort(small.begin(), small.end());
+				check_against_loop(small, big);
+				check_against_loop(big, small);
+			}
+		});
+	}
+}
+
+int main() {
+	test_random<std::uint32_t>();
+	test_random<std::int32_t>();
+	test_random<std::uint64_t>();
+	test_random<std::int64_t>();
+	test_random<short>();
+
+	// Galloping through a projection, with the multiplicities of the first range
+	{
+		std::vector<record> a;
+		for (int i = 0; i < 1000; ++i) a.push_back({i / 3, i});
+		const std::vector<record> b = {{0, -1}, {0, -1}, {0, -1}, {0, -1}, {5, -1},
+			{5, -1}, {500, -1}};
+		std::vector<record> out;
+		auto result = ranges::set_intersection(a, b, ranges::back_inserter(out),
+			ranges::less{}, &record::key, &record::key);
+		CHECK(result.in1 == a.end());
+		CHECK(result.in2 == b.end() - 1);
+		CHECK(out.size() == 5u);
+		CHECK(out[0].tag == 0);
+		CHECK(out[1].tag == 1);
+		CHECK(out[2].tag == 2);
+		CHECK(out[3].tag == 15);
+		CHECK(out[4].tag == 16);
+
+		std::vector<record> rest;
+		ranges::set_difference(a, b, ranges::back_inserter(rest), ranges::less{},
+			&record::key, &record::key);
+		CHECK(rest.size() == 995u);
+		CHECK(rest[3].tag == 6);
+
+		CHECK(!ranges::includes(a, b, ranges::less{}, &record::key, &record::key));
+		const std::vector<int> c = {1, 1, 2, 300, 333};
+		CHECK(ranges::includes(a, c, ranges::less{}, &record::key));
+	}
+
+	// A random-access range against a forward one
+	{
+		const int a[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18};
+		const int b[] = {2, 17};
+		int out[2] = {};
+		auto result = ranges::set_intersection(a, a + 18,
+			forward_iterator<const int*>{b}, forward_iterator<const int*>{b + 2}, out);
+		CHECK(result.in1 == a + 17);
+		CHECK(result.in2.base() == b + 2);
+		CHECK(out[0] == 2);
+		CHECK(out[1] == 17);
+	}
+
+	return ::test_result();
+}
@@ -26,6 +26,7 @@
 #include <random>
 #include <vector>
 #include "../simple_test.hpp"
+#include "../simd_test.hpp"
 #include "../test_utils.hpp"
 #include "../test_iterators.hpp"
 
@@ -163,6 +164,15 @@ test_larger_sorts(int N, int M)
 	std::swap_ranges(array, array+N/2, array+N/2);
 	CHECK(ranges::sort(array, array+N) == array+N);
 	CHECK(std::is_sorted(array, array+N));
+	// test organ pipe pattern
+	std::reverse(array+N/2, array+N);
+	CHECK(ranges::sort(array, array+N) == array+N);
+	CHECK(std::is_sorted(array, array+N));
+	// test sorted pattern with a few stragglers
+	std::swap(array[0], array[N-1]);
+	std::swap(array[N/3], array[N/2]);
+	CHECK(ranges::sort(array, array+N) == array+N);
+	CHECK(std::is_sorted(array, array+N));
 	delete [] array;
 }
 
@@ -185,6 +195,118 @@ struct S
 	int i, j;
 };
 
+// Exercises both the radix sort dispatch (projected arithmetic key, builtin
+// order) and the comparison sort on the same data.
+void
+test_large_projected_sorts(int N, int M)
+{
+	std::vector<S> v(N);
+	std::uniform_int_distribution<int> dist(0, M - 1);
+	for (int i = 0; i < N; ++i)
+		v[i] = S{dist(gen), i};
+	auto by_i = [](S const& a, S const& b) { return a.i < b.i; };
+	auto by_i_desc = [](S const& a, S const& b) { return a.i > b.i; };
+
+	auto w = v;
+	CHECK(ranges::sort(w, ranges::less{}, &S::i) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i));
+	{
+		// every record is still present, with its key intact
+		std::vector<bool> seen(N);
+		for (auto const& s : w) {
+			CHECK(s.i == v[s.j].i);
+			CHECK(!seen[s.j]);
+			seen[s.j] = true;
+		}
+	}
+
+	w = v;
+	CHECK(ranges::sort(w, ranges::greater{}, &S::i) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i_desc));
+
+	w = v;
+	CHECK(ranges::sort(w, by_i) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i));
+
+	// already sorted and reverse sorted inputs
+	CHECK(ranges::sort(w, ranges::less{}, &S::i) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i));
+	std::reverse(w.begin(), w.end());
+	CHECK(ranges::sort(w, ranges::less{}, &S::i) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i));
+}
+
+// Every length the sorting networks handle, and a few beyond, in both
+// orders against std::sort.
+template<class T>
+void
+test_small_scalar_sorts(int M)
+{
+	std::uniform_int_distribution<int> dist(-M, M);
+	for (int n = 0; n <= 40; ++n) {
+		for (int rep = 0; rep < 50; ++rep) {
+			std::vector<T> v(n);
+			for (auto& x : v)
+				x = static_cast<T>(dist(gen));
+			auto w = v;
+			std::sort(w.begin(), w.end());
+			auto u = v;
+			CHECK(ranges::sort(u) == u.end());
+			CHECK(u == w);
+			std::reverse(w.begin(), w.end());
+			u = v;
+			CHECK(ranges::sort(u, ranges::greater{}) == u.end());
+			CHECK(u == w);
+		}
+	}
+}
+
+// The parallel sort, on more threads than the machine may have, over
+// contiguous storage and through an iterator wrapper.
+void
+test_parallel_sorts(int N, int M)
+{
+	std::vector<S> v(N);
+	std::uniform_int_distribution<int> dist(0, M - 1);
+	for (int i = 0; i < N; ++i)
+		v[i] = S{dist(gen), i};
+	auto by_i = [](S const& a, S const& b) { return a.i < b.i; };
+	auto by_i_desc = [](S const& a, S const& b) { return a.i > b.i; };
+	auto check_permutation = [&](std::vector<S> const& w) {
+		std::vector<bool> seen(N);
+		for (auto const& s : w) {
+			CHECK(s.i == v[s.j].i);
+			CHECK(!seen[s.j]);
+			seen[s.j] = true;
+		}
+	};
+
+	auto w = v;
+	CHECK(ranges::sort(ranges::ext::par.on(4), w, ranges::less{}, &S::i) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i));
+	check_permutation(w);
+
+	w = v;
+	CHECK(ranges::sort(ranges::ext::par.on(3), w, by_i_desc) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i_desc));
+	check_permutation(w);
+
+	w = v;
+	using RI = random_access_iterator<S*>;
+	CHECK(ranges::sort(ranges::ext::par.on(5), RI(w.data()), RI(w.data() + N), by_i) ==
+		RI(w.data() + N));
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i));
+	check_permutation(w);
+
+	// already sorted and reverse sorted inputs
+	CHECK(ranges::sort(ranges::ext::par.on(4), w, by_i) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i));
+	std::reverse(w.begin(), w.end());
+	CHECK(ranges::sort(ranges::ext::par, w, by_i) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), by_i));
+	check_permutation(w);
+}
+
 struct Int
 {
 	using difference_type = int;
@@ -251,8 +373,45 @@ int main()
 	test_larger_sorts(997);
 	test_larger_sorts(1000);
 	test_larger_sorts(1009);
+	test_larger_sorts(10007);
+
+	// 32-bit integers take the bitonic kernels.
+	for_each_isa([&] {
+		test_small_scalar_sorts<int>(3);
+		test_small_scalar_sorts<int>(1000000);
+		test_small_scalar_sorts<unsigned>(1000000);
+	});
+	test_small_scalar_sorts<long long>(1000);
+	test_small_scalar_sorts<double>(1000);
+
+	test_large_projected_sorts(30000, 2);
+	test_large_projected_sorts(30000, 100);
+	test_large_projected_sorts(30000, 1000000000);
+
+	test_parallel_sorts(200000, 1);
+	test_parallel_sorts(200000, 3);
+	test_parallel_sorts(200000, 1000);
+	test_parallel_sorts(200003, 1000000000);
+
+	// Check execution policies on small ranges
+	{
+		std::vector<int> v{3, 1, 2};
+		CHECK(ranges::sort(ranges::ext::seq, v) == v.end());
+		CHECK(std::is_sorted(v.begin(), v.end()));
+		std::reverse(v.begin(), v.end());
+		CHECK(ranges::sort(ranges::ext::par, v.begin(), v.end()) == v.end());
+		CHECK(std::is_sorted(v.begin(), v.end()));
+	}
 
 	// Check move-only types
+	{
+		std::vector<std::unique_ptr<int> > v(100000);
+		for(int i = 0; (std::size_t)i < v.size(); ++i)
+			v[i].reset(new int((i * 7919) % v.size()));
+		ranges::sort(ranges::ext::par.on(4), v, indirect_less());
+		for(int i = 0; (std::size_t)i < v.size(); ++i)
+			CHECK(*v[i] == i);
+	}
 	{
 		std::vector<std::unique_ptr<int> > v(1000);
 		for(int i = 0; (std::size_t)i < v.size(); ++i)
@@ -0,0 +1,139 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/sort_by_cached_key.hpp>
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	struct record {
+		int key;
+		int id;
+	};
+
+	std::vector<record> make_records(int n, int distinct) {
+		std::vector<record> v(n);
+		for (int i = 0; i < n; ++i) {
+			v[i] = record{i % distinct, i};
+		}
+		std::shuffle(v.begin(), v.end(), gen);
+		for (int i = 0; i < n; ++i) {
+			v[i].id = i;
+		}
+		return v;
+	}
+
+	// Counts its invocations.
+	struct counted_key {
+		int* calls;
+		int operator()(record const& r) const { ++*calls; return r.key; }
+	};
+
+	void test_records(int n, int distinct) {
+		auto v = make_records(n, distinct);
+		auto expected = v;
+		std::stable_sort(expected.begin(), expected.end(),
+			[](auto& a, auto& b) { return a.key < b.key; });
+
+		auto w = v;
+		int calls = 0;
+		auto res = ranges::ext::stable_sort_by_cached_key(w, ranges::less{}, counted_key{&calls});
+		CHECK(res == w.end());
+		CHECK(calls == n);
+		CHECK(std::equal(w.begin(), w.end(), expected.begin(), expected.end(),
+			[](auto& a, auto& b) { return a.key == b.key && a.id == b.id; }));
+
+		w = v;
+		calls = 0;
+		res = ranges::ext::sort_by_cached_key(w, ranges::less{}, counted_key{&calls});
+		CHECK(res == w.end());
+		CHECK(calls == n);
+		CHECK(std::is_sorted(w.begin(), w.end(),
+			[](auto& a, auto& b) { return a.key < b.key; }));
+		std::sort(w.begin(), w.end(), [](auto& a, auto& b) { return a.id < b.id; });
+		CHECK(std::equal(w.begin(), w.end(), v.begin(), v.end(),
+			[](auto& a, auto& b) { return a.key == b.key && a.id == b.id; }));
+
+		// Descending keys, which the unstable sort hands to radix sort for
+		// large n.
+		w = v;
+		ranges::ext::sort_by_cached_key(w, std::greater<>{}, &record::key);
+		CHECK(std::is_sorted(w.begin(), w.end(),
+			[](auto& a, auto& b) { return a.key > b.key; }));
+		w = v;
+		ranges::ext::stable_sort_by_cached_key(w, std::greater<>{}, &record::key);
+		std::stable_sort(expected.begin(), expected.end(),
+			[](auto& a, auto& b) { return a.key > b.key; });
+		CHECK(std::equal(w.begin(), w.end(), expected.begin(), expected.end(),
+			[](auto& a, auto& b) { return a.key == b.key && a.id == b.id; }));
+	}
+}
+
+int main() {
+	// Empty and single-element ranges
+	{
+		int a[] = {42};
+		CHECK(ranges::ext::sort_by_cached_key(a, a) == a);
+		CHECK(ranges::ext::stable_sort_by_cached_key(a, a + 1) == a + 1);
+		CHECK(a[0] == 42);
+	}
+
+	// Iterator and sentinel
+	{
+		int a[] = {5, 3, 9, 1, 7, 2, 8, 0, 6, 4};
+		using I = random_access_iterator<int*>;
+		using S = sentinel<int*>;
+		auto res = ranges::ext::sort_by_cached_key(I{a}, S{a + 10});
+		CHECK(res.base() == a + 10);
+		for (int i = 0; i < 10; ++i) CHECK(a[i] == i);
+		res = ranges::ext::stable_sort_by_cached_key(I{a}, S{a + 10}, std::greater<>{});
+		CHECK(res.base() == a + 10);
+		for (int i = 0; i < 10; ++i) CHECK(a[i] == 9 - i);
+	}
+
+	// An expensive projection to a string
+	{
+		std::vector<std::string> v = {"delta", "Alpha", "charlie", "Bravo", "alpha", "ECHO"};
+		auto lower = [](std::string const& s) {
+			std::string r = s;
+			for (auto& c : r) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+			return r;
+		};
+		ranges::ext::stable_sort_by_cached_key(v, ranges::less{}, lower);
+		CHECK(v == (std::vector<std::string>{"Alpha", "alpha", "Bravo", "charlie", "delta", "ECHO"}));
+	}
+
+	// Move-only elements
+	{
+		std::vector<std::unique_ptr<int>> v;
+		for (int i = 0; i < 1000; ++i) {
+			v.push_back(std::make_unique<int>((i * 7919) % 1000));
+		}
+		ranges::ext::sort_by_cached_key(v, ranges::less{}, [](auto& p) { return *p; });
+		for (int i = 0; i < 1000; ++i) CHECK(*v[i] == i);
+	}
+
+	test_records(100, 7);
+	test_records(1000, 1000);
+	test_records(10000, 10);
+	test_records(100000, 100000);
+
+	return ::test_result();
+}
@@ -0,0 +1,120 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/sort_permutation.hpp>
+#include <stl2/detail/algorithm/apply_permutation.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	struct S {
+		int key;
+		std::string name;
+	};
+
+	template<class Index>
+	void test_random(int n, int distinct) {
+		std::vector<int> v(n);
+		for (int i = 0; i < n; ++i) v[i] = i % distinct;
+		std::shuffle(v.begin(), v.end(), gen);
+		const auto orig = v;
+
+		std::vector<Index> perm(n);
+		auto res = ranges::ext::stable_sort_permutation(v, perm.begin());
+		CHECK(res.in == v.end());
+		CHECK(res.out == perm.end());
+		CHECK(v == orig);
+		std::vector<int> expected(n);
+		std::iota(expected.begin(), expected.end(), 0);
+		std::stable_sort(expected.begin(), expected.end(),
+			[&](int a, int b) { return v[a] < v[b]; });
+		CHECK(std::equal(perm.begin(), perm.end(), expected.begin(), expected.end(),
+			[](Index a, int b) { return static_cast<int>(a) == b; }));
+
+		res = ranges::ext::sort_permutation(v, perm.begin(), std::greater<>{});
+		CHECK(res.out == perm.end());
+		auto sorted = perm;
+		std::sort(sorted.begin(), sorted.end());
+		for (int i = 0; i < n; ++i) CHECK(static_cast<int>(sorted[i]) == i);
+		CHECK(std::is_sorted(perm.begin(), perm.end(),
+			[&](Index a, Index b) { return v[a] > v[b]; }));
+	}
+}
+
+int main() {
+	// Empty range
+	{
+		int a[1] = {};
+		int p[1] = {-1};
+		auto res = ranges::ext::sort_permutation(a, a, p);
+		CHECK(res.in == a);
+		CHECK(res.out == p);
+		CHECK(p[0] == -1);
+	}
+
+	// Iterator and sentinel, projection
+	{
+		S a[] = {{3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}, {0, "zero"}};
+		using I = random_access_iterator<S*>;
+		std::size_t p[5];
+		auto res = ranges::ext::stable_sort_permutation(I{a}, sentinel<S*>{a + 5}, p,
+			ranges::less{}, &S::key);
+		CHECK(res.in.base() == a + 5);
+		CHECK(res.out == p + 5);
+		CHECK(p[0] == 4u);
+		CHECK(p[1] == 1u);
+		CHECK(p[2] == 3u);
+		CHECK(p[3] == 2u);
+		CHECK(p[4] == 0u);
+
+		// Sorting a parallel array by the same key
+		int weights[] = {30, 10, 20, 11, 0};
+		ranges::ext::apply_permutation(weights, p);
+		CHECK(weights[0] == 0);
+		CHECK(weights[1] == 10);
+		CHECK(weights[2] == 11);
+		CHECK(weights[3] == 20);
+		CHECK(weights[4] == 30);
+		ranges::ext::apply_permutation(a, p);
+		CHECK(a[0].name == "zero");
+		CHECK(a[1].name == "one");
+		CHECK(a[2].name == "uno");
+		CHECK(a[3].name == "two");
+		CHECK(a[4].name == "three");
+	}
+
+	// Compile-time
+	{
+		constexpr auto perm = [] {
+			int a[] = {5, 2, 4, 0, 1, 3};
+			std::array<int, 6> p{};
+			ranges::ext::sort_permutation(a, p.begin());
+			return p;
+		}();
+		static_assert(perm == std::array<int, 6>{3, 4, 1, 5, 2, 0});
+	}
+
+	test_random<int>(1000, 1000);
+	test_random<std::uint32_t>(1000, 10);
+	test_random<std::int64_t>(100000, 100000);
+	test_random<std::size_t>(100000, 100);
+
+	return ::test_result();
+}
@@ -358,6 +358,23 @@ void test_move_only() {
 	CHECK(array[4].i == 4);
 }
 
+// Elements better relocated than moved
+template<class Iter>
+void test_relocating() {
+	using P = std::unique_ptr<int>;
+	P array[100];
+	for (int i = 0; i < 100; ++i) {
+		array[i] = std::make_unique<int>(i);
+	}
+	auto even = [](const P& p) { return *p % 2 == 0; };
+	Iter r = ranges::stable_partition(Iter(array), Iter(array + 100), even);
+	CHECK(base(r) == array + 50);
+	for (int i = 0; i < 50; ++i) {
+		CHECK(*array[i] == 2 * i);
+		CHECK(*array[50 + i] == 2 * i + 1);
+	}
+}
+
 struct S {
 	std::pair<int,int> p;
 };
@@ -384,6 +401,10 @@ int main() {
 	test_move_only<bidirectional_iterator<move_only*> >();
 	CHECK(move_only::count == 0);
 
+	test_relocating<forward_iterator<std::unique_ptr<int>*> >();
+	test_relocating<bidirectional_iterator<std::unique_ptr<int>*> >();
+	test_relocating<std::unique_ptr<int>*>();
+
 	// Test projections
 	using P = std::pair<int, int>;
 	{	// check mixed
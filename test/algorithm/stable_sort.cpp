@@ -22,6 +22,7 @@
 #include <cassert>
 #include <memory>
 #include <random>
+#include <string>
 #include <vector>
 #include <algorithm>
 #include "../simple_test.hpp"
@@ -151,6 +152,74 @@ struct S {
 	int i, j;
 };
 
+// The parallel sort must keep equal keys in their original order.
+void test_parallel_sorts(int N, int M, unsigned threads) {
+	std::vector<S> v(N);
+	std::uniform_int_distribution<int> dist(0, M - 1);
+	for (int i = 0; i < N; ++i)
+		v[i] = S{dist(gen), i};
+	auto stably_ordered = [](S const& a, S const& b) {
+		return a.i < b.i || (a.i == b.i && a.j < b.j);
+	};
+
+	auto w = v;
+	CHECK(ranges::stable_sort(ranges::ext::par.on(threads), w, ranges::less{}, &S::i) == w.end());
+	CHECK(std::is_sorted(w.begin(), w.end(), stably_ordered));
+	{
+		std::vector<bool> seen(N);
+		for (auto const& s : w) {
+			CHECK(s.i == v[s.j].i);
+			CHECK(!seen[s.j]);
+			seen[s.j] = true;
+		}
+	}
+
+	// reverse sorted input, through an iterator wrapper
+	std::reverse(w.begin(), w.end());
+	for (int i = 0; i < N; ++i)
+		w[i].j = i;
+	using RI = random_access_iterator<S*>;
+	auto by_i = [](S const& a, S const& b) { return a.i < b.i; };
+	CHECK(ranges::stable_sort(ranges::ext::par.on(threads), RI(w.data()), RI(w.data() + N),
+		by_i) == RI(w.data() + N));
+	CHECK(std::is_sorted(w.begin(), w.end(), stably_ordered));
+}
+
+// Inputs made of long runs with a few elements out of place, which are
+// merged rather than sorted again; equal keys must keep their order.
+void test_presorted_sorts(int N, int M) {
+	std::vector<S> v(N);
+	auto stably_ordered = [](S const& a, S const& b) {
+		return a.i < b.i || (a.i == b.i && a.j < b.j);
+	};
+	auto check = [&](auto&& comp) {
+		for (int i = 0; i < N; ++i)
+			v[i].j = i;
+		CHECK(ranges::stable_sort(v, comp, &S::i) == v.end());
+		CHECK(std::is_sorted(v.begin(), v.end(), [&](S const& a, S const& b) {
+			return comp(a.i, b.i) || (a.i == b.i && a.j < b.j);
+		}));
+	};
+	std::uniform_int_distribution<int> dist(0, N - 1);
+
+	// ascending with duplicates and stragglers
+	for (int i = 0; i < N; ++i)
+		v[i].i = i / M;
+	for (int k = 0; k < N / 100; ++k)
+		std::swap(v[dist(gen)].i, v[dist(gen)].i);
+	check(ranges::less{});
+	// descending runs, sorted ascending and descending
+	for (int i = 0; i < N; ++i)
+		v[i].i = (i / 1000) % 2 ? i / M : (N - i) / M;
+	check(ranges::less{});
+	check(ranges::greater{});
+	// sorted, then an unsorted tail
+	for (int i = 0; i < N; ++i)
+		v[i].i = i < N - N / 10 ? i / M : dist(gen) / M;
+	check(ranges::less{});
+	CHECK(std::is_sorted(v.begin(), v.end(), stably_ordered));
+}
+
 int main() {
 	// test null range
 	int d = 0;
@@ -177,7 +246,40 @@ int main() {
 	test_larger_sorts(1000);
 	test_larger_sorts(1009);
 
+	test_presorted_sorts(100000, 1);
+	test_presorted_sorts(100000, 3);
+	test_presorted_sorts(5003, 7);
+
+	// Tails left in place by a merge are not moved onto themselves
+	{
+		std::vector<std::string> v(5000);
+		for (auto& s : v)
+			s = std::to_string(gen());
+		auto w = v;
+		CHECK(ranges::stable_sort(v) == v.end());
+		std::stable_sort(w.begin(), w.end());
+		CHECK(v == w);
+	}
+
+	test_parallel_sorts(100000, 1, 2);
+	test_parallel_sorts(100000, 7, 4);
+	test_parallel_sorts(100003, 1000, 3);
+	test_parallel_sorts(100003, 1000000000, 5);
+	{
+		std::vector<int> v{3, 1, 2};
+		CHECK(ranges::stable_sort(ranges::ext::seq, v) == v.end());
+		CHECK(std::is_sorted(v.begin(), v.end()));
+	}
+
 	// Check move-only types
+	{
+		std::vector<std::unique_ptr<int> > v(100000);
+		for(int i = 0; (std::size_t)i < v.size(); ++i)
+			v[i].reset(new int((i * 7919) % v.size()));
+		ranges::stable_sort(ranges::ext::par.on(4), v, indirect_less());
+		for(int i = 0; (std::size_t)i < v.size(); ++i)
+			CHECK(*v[i] == i);
+	}
 	{
 		std::vector<std::unique_ptr<int> > v(1000);
 		for(int i = 0; (std::size_t)i < v.size(); ++i)
@@ -186,6 +288,16 @@ int main() {
 		for(int i = 0; (std::size_t)i < v.size(); ++i)
 			CHECK(*v[i] == i);
 	}
+	{
+		// Relocated rather than moved; each holds 10000 * key + i.
+		std::vector<std::unique_ptr<int> > v(5000);
+		for(int i = 0; (std::size_t)i < v.size(); ++i)
+			v[i].reset(new int(10000 * ((i * 7919) % 100) + i));
+		ranges::stable_sort(v, std::less<int>{},
+			[](const std::unique_ptr<int>& p) { return *p / 10000; });
+		for(int i = 1; (std::size_t)i < v.size(); ++i)
+			CHECK(*v[i - 1] < *v[i]);
+	}
 
 	// Check projections
 	{
@@ -0,0 +1,151 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/top_k.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/view/istream.hpp>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	struct S {
+		int i, j;
+	};
+
+	// The k least of v under comp, in order.
+	template<class Comp = std::less<>>
+	std::vector<int> expected(std::vector<int> v, std::size_t k, Comp comp = {}) {
+		k = std::min(k, v.size());
+		std::partial_sort(v.begin(), v.begin() + k, v.end(), comp);
+		v.resize(k);
+		return v;
+	}
+
+	void test_shape(std::vector<int> const& v, int k) {
+		std::vector<int> out(v.size() + 1, -1);
+		auto res = ranges::ext::top_k(v, out.begin(), k);
+		CHECK(res.in == v.end());
+		auto exp = expected(v, k);
+		CHECK(res.out == out.begin() + exp.size());
+		CHECK(std::equal(out.begin(), res.out, exp.begin(), exp.end()));
+		CHECK(*res.out == -1);
+
+		res = ranges::ext::top_k(v, out.begin(), k, std::greater<>{});
+		exp = expected(v, k, std::greater<>{});
+		CHECK(res.out == out.begin() + exp.size());
+		CHECK(std::equal(out.begin(), res.out, exp.begin(), exp.end()));
+	}
+}
+
+int main() {
+	// Empty output
+	{
+		int a[] = {3, 1, 2};
+		int out[3] = {};
+		auto res = ranges::ext::top_k(a, out, 0);
+		CHECK(res.in == a + 3);
+		CHECK(res.out == out);
+		res = ranges::ext::top_k(a, out, -1);
+		CHECK(res.out == out);
+	}
+
+	// Fewer elements than k
+	{
+		int a[] = {3, 1, 2};
+		int out[5] = {};
+		auto res = ranges::ext::top_k(a, out, 5);
+		CHECK(res.out == out + 3);
+		CHECK(out[0] == 1);
+		CHECK(out[1] == 2);
+		CHECK(out[2] == 3);
+	}
+
+	// Input iterators and sentinels
+	{
+		int a[] = {5, 9, 1, 7, 3, 8, 2, 6, 4, 0};
+		int out[4] = {};
+		auto res = ranges::ext::top_k(input_iterator<const int*>{a},
+			sentinel<const int*>{a + 10}, out, 4);
+		CHECK(res.in.base() == a + 10);
+		CHECK(res.out == out + 4);
+		CHECK(out[0] == 0);
+		CHECK(out[1] == 1);
+		CHECK(out[2] == 2);
+		CHECK(out[3] == 3);
+	}
+
+	// A single pass over a stream
+	{
+		std::istringstream ss{"42 7 19 3 88 3 61 25 0 14 77"};
+		std::vector<int> out;
+		ranges::ext::top_k(ranges::views::istream<int>(ss),
+			ranges::back_inserter(out), 3, std::greater<>{});
+		CHECK(out == std::vector<int>{88, 77, 61});
+	}
+
+	// Projections
+	{
+		std::vector<S> v(1000);
+		for (int i = 0; i < 1000; ++i) {
+			v[i] = S{999 - i, i};
+		}
+		std::shuffle(v.begin(), v.end(), gen);
+		std::vector<S> out(10);
+		ranges::ext::top_k(v, out.begin(), 10, std::less<>{}, &S::i);
+		for (int i = 0; i < 10; ++i) {
+			CHECK(out[i].i == i);
+			CHECK(out[i].j == 999 - i);
+		}
+	}
+
+	// Move-only output
+	{
+		std::vector<std::unique_ptr<int>> out;
+		int a[] = {4, 2, 3, 1};
+		auto make = [](int i) { return std::make_unique<int>(i); };
+		std::vector<std::unique_ptr<int>> v;
+		for (int i : a) v.push_back(make(i));
+		auto less_ptr = [](auto const& x, auto const& y) { return *x < *y; };
+		ranges::ext::top_k(ranges::make_move_iterator(v.begin()),
+			ranges::make_move_sentinel(v.end()), ranges::back_inserter(out), 2, less_ptr);
+		CHECK(out.size() == 2u);
+		CHECK(*out[0] == 1);
+		CHECK(*out[1] == 2);
+	}
+
+	// Larger inputs that refill the candidate buffer many times
+	{
+		const int N = 100000;
+		std::vector<int> v(N);
+		for (int k : {1, 2, 10, 1000, N / 2, N - 1, N}) {
+			for (int i = 0; i < N; ++i) v[i] = i;
+			std::shuffle(v.begin(), v.end(), gen);
+			test_shape(v, k);
+			for (int i = 0; i < N; ++i) v[i] = i % 31;
+			std::shuffle(v.begin(), v.end(), gen);
+			test_shape(v, k);
+			for (int i = 0; i < N; ++i) v[i] = N - i;
+			test_shape(v, k);
+			for (int i = 0; i < N; ++i) v[i] = i;
+			test_shape(v, k);
+		}
+	}
+
+	return ::test_result();
+}
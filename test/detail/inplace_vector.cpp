@@ -0,0 +1,163 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/inplace_vector.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+
+using ranges::ext::inplace_vector;
+
+namespace {
+	struct counted {
+		static int count;
+		static int throw_at;
+
+		int i;
+
+		counted(int j) : i{j} {
+			if (count == throw_at) throw j;
+			++count;
+		}
+		counted(const counted& that) : counted(that.i) {}
+		counted& operator=(const counted&) = default;
+		~counted() { --count; }
+	};
+	int counted::count = 0;
+	int counted::throw_at = -1;
+
+	template<class V, class T>
+	bool holds(const V& v, std::initializer_list<T> il) {
+		return ranges::equal(v, il);
+	}
+
+	void test_basics() {
+		inplace_vector<int, 8> v;
+		CHECK(v.empty());
+		CHECK(v.capacity() == 8u);
+		for (int i = 0; i < 8; ++i) {
+			v.push_back(i);
+		}
+		CHECK(v.size() == 8u);
+		CHECK(v.try_push_back(8) == nullptr);
+		try {
+			v.push_back(8);
+			CHECK(false);
+		} catch (const std::bad_alloc&) {}
+		try {
+			(void) v.at(8);
+			CHECK(false);
+		} catch (const std::out_of_range&) {}
+		CHECK(holds(v, {0, 1, 2, 3, 4, 5, 6, 7}));
+
+		v.erase(v.begin() + 1, v.begin() + 3);
+		CHECK(holds(v, {0, 3, 4, 5, 6, 7}));
+		v.insert(v.begin() + 1, 2, v.back());
+		CHECK(holds(v, {0, 7, 7, 3, 4, 5, 6, 7}));
+		v.pop_back();
+		v.erase(v.begin());
+		CHECK(*v.try_push_back(9) == 9);
+		CHECK(holds(v, {7, 7, 3, 4, 5, 6, 9}));
+		v.resize(3);
+		v.emplace(v.begin(), 1);
+		CHECK(holds(v, {1, 7, 7, 3}));
+		v.assign(2, 5);
+		CHECK(holds(v, {5, 5}));
+		const int a[] = {1, 2, 3};
+		v.insert(v.begin() + 1, input_iterator<const int*>{a}, input_iterator<const int*>{a + 3});
+		CHECK(holds(v, {5, 1, 2, 3, 5}));
+		v.resize(6, v.front());
+		CHECK(holds(v, {5, 1, 2, 3, 5, 5}));
+
+		// Copies of trivially copyable elements are trivial.
+		auto w = v;
+		CHECK(w == v);
+		w[1] = 0;
+		CHECK(w < v);
+		CHECK(w != v);
+		CHECK(holds(inplace_vector<int, 4>{}, std::initializer_list<int>{}));
+	}
+
+	void test_elements() {
+		using S = inplace_vector<std::string, 4>;
+		S s{"a", "b", "c"};
+		auto t = s;
+		CHECK(t == s);
+		t.assign({"xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", "y"});
+		CHECK(holds(t, {"xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", "y"}));
+		s.swap(t);
+		CHECK(holds(t, {"a", "b", "c"}));
+		CHECK(s.size() == 2u);
+		s = std::move(t);
+		CHECK(holds(s, {"a", "b", "c"}));
+
+		// Moves of trivially relocatable elements leave the source empty.
+		inplace_vector<std::unique_ptr<int>, 4> p;
+		for (int i = 0; i < 4; ++i) {
+			p.emplace_back(new int{i});
+		}
+		p.erase(p.begin() + 1);
+		p.emplace(p.begin(), new int{4});
+		auto q = std::move(p);
+		CHECK(p.empty());
+		CHECK(q.size() == 4u);
+		CHECK(*q[0] == 4);
+		CHECK(*q[1] == 0);
+		CHECK(*q[3] == 3);
+	}
+
+	void test_exceptions() {
+		const int a[] = {0, 1, 2, 3, 4};
+		counted::throw_at = 3;
+		try {
+			inplace_vector<counted, 8> v(a, a + 5);
+			CHECK(false);
+		} catch (int i) {
+			CHECK(i == 3);
+		}
+		CHECK(counted::count == 0);
+
+		counted::throw_at = 5;
+		{
+			inplace_vector<counted, 8> v(a, a + 3);
+			try {
+				v.insert(v.begin(), input_iterator<const int*>{a}, input_iterator<const int*>{a + 5});
+				CHECK(false);
+			} catch (int i) {
+				CHECK(i == 2);
+			}
+			CHECK(v.size() == 3u);
+		}
+		CHECK(counted::count == 0);
+		counted::throw_at = -1;
+	}
+}
+
+static_assert(ranges::contiguous_range<inplace_vector<int, 4>>);
+static_assert(ranges::sized_range<inplace_vector<int, 4>>);
+static_assert(std::is_trivially_copyable_v<inplace_vector<int, 4>>);
+static_assert(!std::is_trivially_copyable_v<inplace_vector<std::string, 4>>);
+static_assert(std::is_nothrow_move_constructible_v<inplace_vector<std::unique_ptr<int>, 4>>);
+static_assert(!std::is_copy_constructible_v<inplace_vector<std::unique_ptr<int>, 4>>);
+static_assert(std::is_empty_v<ranges::detail::inline_storage<int, 0>>);
+
+int main() {
+	test_basics();
+	test_elements();
+	test_exceptions();
+
+	return ::test_result();
+}
@@ -0,0 +1,158 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/small_vector.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+using ranges::ext::small_vector;
+
+namespace {
+	int allocations = 0;
+	int outstanding = 0;
+
+	template<class T>
+	struct counting_allocator {
+		using value_type = T;
+
+		counting_allocator() = default;
+		template<class U>
+		counting_allocator(const counting_allocator<U>&) noexcept {}
+
+		T* allocate(std::size_t n) {
+			++allocations;
+			++outstanding;
+			return std::allocator<T>{}.allocate(n);
+		}
+		void deallocate(T* p, std::size_t n) noexcept {
+			--outstanding;
+			std::allocator<T>{}.deallocate(p, n);
+		}
+
+		friend bool operator==(counting_allocator, counting_allocator) noexcept { return true; }
+		friend bool operator!=(counting_allocator, counting_allocator) noexcept { return false; }
+	};
+
+	template<class V>
+	bool is_inline(const V& v) {
+		const auto p = reinterpret_cast<const unsigned char*>(v.data());
+		const auto q = reinterpret_cast<const unsigned char*>(&v);
+		return q <= p && p < q + sizeof(v);
+	}
+
+	void test_ints() {
+		using V = small_vector<int, 4, counting_allocator<int>>;
+		{
+			V v;
+			CHECK(v.capacity() == 4u);
+			for (int i = 0; i < 4; ++i) {
+				v.push_back(i);
+			}
+			CHECK(is_inline(v));
+			CHECK(allocations == 0);
+
+			// Spills over,
+			v.push_back(v[0]);
+			CHECK(!is_inline(v));
+			CHECK(allocations == 1);
+			CHECK(v.capacity() == 8u);
+			CHECK(ranges::equal(v, std::initializer_list<int>{0, 1, 2, 3, 0}));
+			v.insert(v.begin() + 1, {7, 8, 9, 10});
+			CHECK(ranges::equal(v, std::initializer_list<int>{0, 7, 8, 9, 10, 1, 2, 3, 0}));
+			CHECK(allocations == 2);
+
+			// moves by taking the storage,
+			const auto p = v.data();
+			V w = std::move(v);
+			CHECK(w.data() == p);
+			CHECK(v.empty());
+			CHECK(is_inline(v));
+
+			// and moves back in.
+			w.erase(w.begin() + 2, w.end());
+			w.shrink_to_fit();
+			CHECK(is_inline(w));
+			CHECK(ranges::equal(w, std::initializer_list<int>{0, 7}));
+			CHECK(outstanding == 0);
+
+			V x = w;
+			CHECK(x == w);
+			x = V{1, 2, 3, 4, 5, 6};
+			CHECK(x.size() == 6u);
+			x.swap(w);
+			CHECK(ranges::equal(x, std::initializer_list<int>{0, 7}));
+			CHECK(w.size() == 6u);
+			w.reserve(100);
+			CHECK(w.capacity() == 100u);
+			CHECK(w > x);
+		}
+		CHECK(outstanding == 0);
+	}
+
+	template<class T, class Make>
+	void test_elements(Make make) {
+		{
+			small_vector<T, 2> v;
+			for (int i = 0; i < 20; ++i) {
+				v.push_back(make(i));
+			}
+			v.emplace_back(v[3]);
+			for (int i = 0; i < 20; ++i) {
+				CHECK(v[i] == make(i));
+			}
+			CHECK(v.back() == make(3));
+			v.erase(v.begin(), v.begin() + 19);
+			v.shrink_to_fit();
+			CHECK(is_inline(v));
+			CHECK(v.size() == 2u);
+			CHECK(v[0] == make(19));
+
+			auto w = v;
+			w.resize(10, w[0]);
+			CHECK(w.size() == 10u);
+			CHECK(w[9] == make(19));
+			v = std::move(w);
+			CHECK(v.size() == 10u);
+		}
+	}
+
+	void test_move_only() {
+		small_vector<std::unique_ptr<int>, 2> v;
+		for (int i = 0; i < 10; ++i) {
+			v.emplace(v.begin(), new int{i});
+		}
+		for (int i = 0; i < 10; ++i) {
+			CHECK(*v[i] == 9 - i);
+		}
+		auto w = std::move(v);
+		CHECK(*w.front() == 9);
+	}
+}
+
+static_assert(ranges::contiguous_range<small_vector<int, 4>>);
+static_assert(std::is_nothrow_move_constructible_v<small_vector<std::unique_ptr<int>, 4>>);
+static_assert(!std::is_copy_constructible_v<small_vector<std::unique_ptr<int>, 4>>);
+
+int main() {
+	test_ints();
+	test_elements<std::string>([](int i) { return std::string(40, static_cast<char>('a' + i)); });
+	test_elements<std::shared_ptr<int>>([](int i) {
+		static std::shared_ptr<int> ptrs[20];
+		if (!ptrs[i]) ptrs[i] = std::make_shared<int>(i);
+		return ptrs[i];
+	});
+	test_move_only();
+
+	return ::test_result();
+}
@@ -0,0 +1,178 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/memory/scratch_resource.hpp>
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/inplace_merge.hpp>
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/detail/algorithm/stable_partition.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	// Counts the allocations that reach the heap.
+	struct counting_resource final : std::pmr::memory_resource {
+		int allocations = 0;
+		int outstanding = 0;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+			++allocations;
+			++outstanding;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+			--outstanding;
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+		bool do_is_equal(const std::pmr::memory_resource& that) const noexcept override {
+			return this == &that;
+		}
+	};
+
+	bool aligned(const void* p, std::size_t alignment) {
+		return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+	}
+
+	void test_arena() {
+		counting_resource heap;
+		{
+			ranges::ext::scratch_arena arena{1 << 16, false, &heap};
+			CHECK(arena.capacity() == std::size_t{1} << 16);
+			CHECK(arena.reserved() == 0u);
+
+			// The first allocation takes a block,
+			void* p = arena.allocate(100, 8);
+			CHECK(heap.allocations == 1);
+			CHECK(arena.reserved() >= 108u);
+			CHECK(aligned(p, 8));
+			// which serves the next ones, however aligned,
+			void* q = arena.allocate(10, 64);
+			CHECK(aligned(q, 64));
+			CHECK(q != p);
+			// until it runs out.
+			void* r = arena.allocate(1 << 12, 16);
+			CHECK(heap.allocations == 2);
+			arena.deallocate(r, 1 << 12, 16);
+			CHECK(heap.outstanding == 1);
+
+			// The last is rolled back.
+			arena.deallocate(q, 10, 64);
+			void* s = arena.allocate(10, 64);
+			CHECK(s == q);
+			arena.deallocate(s, 10, 64);
+			arena.deallocate(p, 100, 8);
+
+			// Idle, the block is replaced by one that would have served the burst,
+			const auto before = arena.reserved();
+			p = arena.allocate(100, 8);
+			CHECK(arena.reserved() > before);
+			CHECK(heap.allocations == 3);
+			CHECK(heap.outstanding == 1);
+			q = arena.allocate(10, 64);
+			r = arena.allocate(1 << 12, 16);
+			CHECK(heap.allocations == 3);
+			arena.deallocate(r, 1 << 12, 16);
+			arena.deallocate(q, 10, 64);
+			arena.deallocate(p, 100, 8);
+
+			// but no larger than the capacity.
+			p = arena.allocate(1 << 17, 8);
+			CHECK(arena.reserved() <= arena.capacity());
+			CHECK(heap.outstanding == 2);
+			arena.deallocate(p, 1 << 17, 8);
+
+			arena.release();
+			CHECK(arena.reserved() == 0u);
+			CHECK(heap.outstanding == 0);
+		}
+		{
+			// In huge pages, if the capacity allows.
+			ranges::ext::scratch_arena arena{std::size_t{1} << 22, true, &heap};
+			void* p = arena.allocate(100, 8);
+			CHECK(arena.reserved() == std::size_t{1} << 21);
+			CHECK(aligned(p, std::size_t{1} << 21));
+			arena.deallocate(p, 100, 8);
+		}
+		CHECK(heap.outstanding == 0);
+	}
+
+	void test_hook() {
+		auto* const standard = ranges::ext::scratch_resource();
+		CHECK(standard != nullptr);
+		CHECK(ranges::ext::set_scratch_resource(nullptr) == standard);
+		CHECK(ranges::ext::scratch_resource() == standard);
+
+		counting_resource heap;
+		CHECK(ranges::ext::set_scratch_resource(&heap) == standard);
+		CHECK(ranges::ext::scratch_resource() == &heap);
+		{
+			ranges::detail::temporary_buffer<int> buf{100};
+			CHECK(buf.size() == 100);
+			CHECK(heap.outstanding == 1);
+			auto other = std::move(buf);
+			CHECK(other.size() == 100);
+			CHECK(buf.size() == 0);
+		}
+		CHECK(heap.allocations == 1);
+		CHECK(heap.outstanding == 0);
+
+		// Each thread has a resource of its own.
+		std::pmr::memory_resource* theirs = nullptr;
+		std::thread{[&] { theirs = ranges::ext::scratch_resource(); }}.join();
+		CHECK(theirs != &heap);
+		CHECK(theirs != standard);
+
+		CHECK(ranges::ext::set_scratch_resource(nullptr) == &heap);
+		CHECK(ranges::ext::scratch_resource() == standard);
+	}
+
+	// After the first call, the buffered algorithms take no more memory
+	// from the heap.
+	void test_steady_state() {
+		counting_resource heap;
+		ranges::ext::scratch_arena arena{std::size_t{1} << 20, false, &heap};
+		auto* const previous = ranges::ext::set_scratch_resource(&arena);
+
+		std::vector<int> v(5000);
+		auto run = [&] {
+			for (int i = 0; i < 5000; ++i) {
+				v[i] = (i * 7919) % 1000;
+			}
+			ranges::stable_sort(v);
+			CHECK(ranges::is_sorted(v));
+			ranges::stable_partition(v, [](int i) { return i % 2 == 0; });
+			ranges::stable_sort(v.begin(), v.begin() + 2500);
+			ranges::inplace_merge(v, v.begin() + 2500);
+			CHECK(ranges::is_sorted(v));
+		};
+		run();
+		const int warm = heap.allocations;
+		CHECK(warm > 0);
+		for (int i = 0; i < 10; ++i) {
+			run();
+		}
+		CHECK(heap.allocations == warm);
+
+		ranges::ext::set_scratch_resource(previous);
+	}
+}
+
+int main() {
+	test_arena();
+	test_hook();
+	test_steady_state();
+
+	return ::test_result();
+}
@@ -90,6 +90,8 @@ namespace {
 
 int main() {
 	uninitialized_fill_test(0);
+	uninitialized_fill_test(-1);
+	uninitialized_fill_test(7);
 	uninitialized_fill_test(0.0);
 	uninitialized_fill_test('a');
 	uninitialized_fill_test(std::vector<int>{});
@@ -0,0 +1,123 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/memory/relocate.hpp>
+#include <stl2/iterator.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/view/iota.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+#include "common.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	struct counted {
+		static int count;
+		static int moves;
+		static int throw_at;
+
+		int i;
+
+		counted(int j) : i{j} { ++count; }
+		counted(counted&& that) : i{that.i} {
+			if (++moves == throw_at) throw i;
+			++count;
+		}
+		~counted() { --count; }
+	};
+	int counted::count = 0;
+	int counted::moves = 0;
+	int counted::throw_at = -1;
+
+	struct opted_in {
+		opted_in* self = this;
+		~opted_in() {}
+	};
+}
+
+namespace std::experimental::ranges::ext {
+	template<>
+	inline constexpr bool enable_trivially_relocatable<opted_in> = true;
+} // namespace std::experimental::ranges::ext
+
+static_assert(ranges::ext::trivially_relocatable<int>);
+static_assert(ranges::ext::trivially_relocatable<const int>);
+static_assert(ranges::ext::trivially_relocatable<std::unique_ptr<int>>);
+static_assert(ranges::ext::trivially_relocatable<std::shared_ptr<int>>);
+static_assert(ranges::ext::trivially_relocatable<std::vector<std::string>>);
+static_assert(ranges::ext::trivially_relocatable<opted_in>);
+static_assert(!ranges::ext::trivially_relocatable<counted>);
+static_assert(!ranges::ext::trivially_relocatable<int&>);
+static_assert(!ranges::ext::trivially_relocatable<void>);
+
+void test_relocate_bytes() {
+	using V = std::vector<int>;
+	const auto control = Array<V>{{V{1}, V{2, 2}, V{3, 3, 3}, V{}, V{5}, V{6}, V{7}, V{8}}};
+	auto from = make_buffer<V>(control.size());
+	ranges::uninitialized_copy(control, from);
+	auto to = make_buffer<V>(control.size());
+
+	// As one block, from an array to an array
+	auto r = ranges::ext::uninitialized_relocate(from.begin(), from.end(), to.begin());
+	CHECK(r.in == from.end());
+	CHECK(r.out == to.end());
+	CHECK(ranges::equal(control, to));
+
+	// Element by element, then back again as a block
+	auto r2 = ranges::ext::uninitialized_relocate_n(
+		forward_iterator<V*>{to.begin()}, to.size(), from.begin());
+	CHECK(r2.in.base() == to.end());
+	CHECK(r2.out == from.end());
+	CHECK(ranges::equal(control, from));
+	ranges::ext::uninitialized_relocate(from, to.begin());
+	CHECK(ranges::equal(control, to));
+
+	// Overlapping, toward the front
+	ranges::destroy_at(to.begin());
+	ranges::ext::uninitialized_relocate(to.begin() + 1, to.end(), to.begin());
+	CHECK(ranges::equal(control.begin() + 1, control.end(), to.begin(), to.end() - 1));
+	ranges::destroy(to.begin(), to.end() - 1);
+}
+
+void test_relocate_moves() {
+	auto from = make_buffer<counted>(8);
+	ranges::uninitialized_copy(ranges::iota_view{0, 8}, from);
+	CHECK(counted::count == 8);
+	auto to = make_buffer<counted>(8);
+
+	auto r = ranges::ext::uninitialized_relocate(from, to.begin());
+	CHECK(r.out == to.end());
+	CHECK(counted::count == 8);
+	for (int i = 0; i < 8; ++i) {
+		CHECK(to.begin()[i].i == i);
+	}
+
+	// Both ranges are destroyed if a move throws.
+	counted::moves = 0;
+	counted::throw_at = 4;
+	try {
+		ranges::ext::uninitialized_relocate(to, from.begin());
+		CHECK(false);
+	} catch (int i) {
+		CHECK(i == 3);
+	}
+	CHECK(counted::count == 0);
+	counted::throw_at = -1;
+}
+
+int main() {
+	test_relocate_bytes();
+	test_relocate_moves();
+
+	return ::test_result();
+}
@@ -12,6 +12,7 @@
 //
 #include <stl2/detail/memory/uninitialized_value_construct.hpp>
 #include <cstdint>
+#include <cstring>
 #include <deque>
 #include <list>
 #include <memory>
@@ -86,6 +87,28 @@ namespace {
 		}
 		S::count = 0;
 	}
+
+	// Trivially default constructible types are zero-initialized, a block
+	// at a time where their zeros are all zero bytes.
+	struct point { int x, y; };
+	struct member { int point::* m; };
+	void zero_test() {
+		{
+			auto buffer = make_buffer<point>(N);
+			std::memset(static_cast<void*>(buffer.begin()), 0xFF, N * sizeof(point));
+			CHECK(ranges::uninitialized_value_construct(buffer) == buffer.end());
+			CHECK(ranges::find_if(buffer, [](const point& p) {
+				return p.x != 0 || p.y != 0; }) == buffer.end());
+		}
+		{
+			// A null pointer to member is not all zero bytes.
+			auto buffer = make_buffer<member>(N);
+			std::memset(static_cast<void*>(buffer.begin()), 0, N * sizeof(member));
+			CHECK(ranges::uninitialized_value_construct_n(buffer.begin(), N) == buffer.end());
+			CHECK(ranges::find_if(buffer, [](const member& m) {
+				return m.m != nullptr; }) == buffer.end());
+		}
+	}
 }
 
 int main()
@@ -106,6 +129,7 @@ int main()
 	uninitialized_value_construct_test<unique_ptr<string>>();
 
 	throw_test();
+	zero_test();
 
 	return ::test_result();
 }
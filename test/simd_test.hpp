@@ -0,0 +1,30 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_SIMD_TEST_HPP
+#define STL2_SIMD_TEST_HPP
+
+#include <stl2/detail/simd.hpp>
+
+// Calls f with each instruction set the machine supports made the one the
+// vector kernels use, from the scalar loops up, so that every kernel is
+// tested whichever would be chosen; the default is restored afterwards.
+template<class F>
+void for_each_isa(F f)
+{
+	namespace simd = __stl2::detail::simd;
+	const simd::isa best = simd::detect_isa();
+	for (int level = 0; level <= static_cast<int>(best); ++level) {
+		simd::active_isa() = static_cast<simd::isa>(level);
+		f();
+	}
+	simd::active_isa() = best;
+}
+
+#endif
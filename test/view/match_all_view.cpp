@@ -0,0 +1,109 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/match_all.hpp>
+#include <stl2/view/join.hpp>
+#include <forward_list>
+#include <list>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	using match = std::tuple<std::size_t, std::size_t, std::size_t>; // start, end, pattern
+
+	// Every occurrence of every pattern, ordered by end and then longest first.
+	std::vector<match> brute_force(std::string_view text,
+		const std::vector<std::string>& patterns)
+	{
+		std::vector<match> result;
+		for (std::size_t end = 1; end <= text.size(); ++end) {
+			for (std::size_t length = end; length >= 1; --length) {
+				for (std::size_t p = 0; p < patterns.size(); ++p) {
+					if (patterns[p] == text.substr(end - length, length)) {
+						result.emplace_back(end - length, end, p);
+						break;
+					}
+				}
+			}
+		}
+		return result;
+	}
+
+	template<class Rng>
+	std::vector<match> collect(Rng&& text, const ranges::ext::aho_corasick& ac) {
+		std::vector<match> result;
+		const auto first = ranges::begin(text);
+		for (auto&& m : text | ranges::views::ext::match_all(ac)) {
+			result.emplace_back(ranges::distance(first, m.begin()),
+				ranges::distance(first, m.end()), m.pattern);
+		}
+		return result;
+	}
+}
+
+int main() {
+	using ranges::ext::aho_corasick, ranges::ext::match_all_view;
+
+	{
+		const std::string_view text = "ushers";
+		const std::vector<std::string> patterns{"he", "she", "his", "hers"};
+		const aho_corasick ac{patterns};
+		auto v = ranges::views::ext::match_all(text, ac);
+		static_assert(ranges::view<decltype(v)>);
+		static_assert(ranges::input_range<decltype(v)>);
+		static_assert(ranges::same_as<decltype(v), match_all_view<std::string_view>>);
+		CHECK(collect(text, ac) == brute_force(text, patterns));
+		CHECK(collect(text, ac).size() == 3u);
+	}
+
+	// Joined lines, with matches across their boundaries
+	{
+		const std::vector<std::string> lines{"error: dis", "k full; err", "or: disk", " full"};
+		std::string whole;
+		for (auto& l : lines) whole += l;
+		const std::vector<std::string> patterns{"error", "disk full", "full", "k"};
+		const aho_corasick ac{patterns};
+		CHECK(collect(ranges::views::join(lines), ac) == brute_force(whole, patterns));
+	}
+
+	// No patterns, or only empty ones, over a forward-only text
+	{
+		const std::forward_list<char> text{'a', 'b', 'c'};
+		CHECK(collect(text, aho_corasick{}).empty());
+		CHECK(collect(text, aho_corasick{std::vector<std::string>{""}}).empty());
+		CHECK(collect(text, aho_corasick{std::vector<std::string>{"", "b"}}).size() == 1u);
+	}
+
+	// Random texts over small alphabets, in lists
+	{
+		std::mt19937 gen;
+		for (int alphabet : {2, 4}) {
+			std::uniform_int_distribution<int> letter(0, alphabet - 1);
+			std::vector<std::string> patterns(20);
+			for (auto& p : patterns) {
+				p.resize(std::uniform_int_distribution<int>(1, 6)(gen));
+				for (auto& c : p) c = static_cast<char>('a' + letter(gen));
+			}
+			const aho_corasick ac{patterns};
+			std::string text(500, ' ');
+			for (auto& c : text) c = static_cast<char>('a' + letter(gen));
+			const std::list<char> list(text.begin(), text.end());
+			CHECK(collect(list, ac) == brute_force(text, patterns));
+			CHECK(collect(text, ac) == brute_force(text, patterns));
+		}
+	}
+
+	return ::test_result();
+}
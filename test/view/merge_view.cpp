@@ -0,0 +1,118 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/merge.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::mt19937 gen;
+
+	struct record {
+		int key;
+		std::size_t source;
+		bool operator==(const record&) const = default;
+	};
+
+	// Sorting the concatenation stably gives the order of the merge, the
+	// earlier range first among equal elements.
+	void check_random(const std::size_t k) {
+		std::vector<std::vector<record>> ranges(k);
+		std::vector<record> expected;
+		for (std::size_t i = 0; i < k; ++i) {
+			ranges[i].resize(gen() % 40);
+			for (auto& x : ranges[i]) x = {static_cast<int>(gen() % 50), i};
+			std::sort(ranges[i].begin(), ranges[i].end(),
+				[](const record& x, const record& y) { return x.key < y.key; });
+			expected.insert(expected.end(), ranges[i].begin(), ranges[i].end());
+		}
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const record& x, const record& y) { return x.key < y.key; });
+
+		std::vector<record> actual;
+		for (const record& x : ranges::views::ext::merge(ranges, ranges::less{}, &record::key)) {
+			actual.push_back(x);
+		}
+		CHECK(actual == expected);
+	}
+}
+
+int main() {
+	using ranges::ext::merge_view;
+	namespace views = ranges::views::ext;
+
+	{
+		std::vector<std::vector<int>> segments = {{1, 4, 9}, {}, {2, 3, 10, 11}, {0}, {4, 5}};
+		auto rng = views::merge(segments);
+		using R = decltype(rng);
+		static_assert(ranges::view<R>);
+		static_assert(ranges::input_range<R>);
+		static_assert(!ranges::forward_range<R>);
+		static_assert(ranges::same_as<ranges::range_reference_t<R>, int&>);
+		const int expected[] = {0, 1, 2, 3, 4, 4, 5, 9, 10, 11};
+		CHECK(ranges::equal(rng, expected));
+
+		// Elements are referred to in place.
+		*views::merge(segments).begin() = 42;
+		CHECK(segments[3][0] == 42);
+
+		// so a temporary range of ranges would dangle.
+		using VV = std::vector<std::vector<int>>;
+		static_assert(ranges::invocable<decltype((views::merge)), VV&>);
+		static_assert(!ranges::invocable<decltype((views::merge)), VV>);
+		static_assert(!ranges::constructible_from<merge_view<std::vector<int>::iterator, std::vector<int>::iterator>, VV>);
+	}
+
+	// Pipeable, and over a non-contiguous range of ranges
+	{
+		const std::list<std::vector<int>> segments = {{5, 3, 1}, {6, 4, 2}, {7}};
+		merge_view rng{segments, std::greater<>{}};
+		const int expected[] = {7, 6, 5, 4, 3, 2, 1};
+		CHECK(ranges::equal(rng, expected));
+		const int ascending[] = {1, 2, 3};
+		const std::vector<std::list<int>> lists = {{3}, {1, 2}};
+		CHECK(ranges::equal(lists | views::merge, ascending));
+	}
+
+	// Ranges given one by one
+	{
+		const std::vector<int> a = {1, 5}, b = {2, 3}, c = {0, 4, 6};
+		const int expected[] = {0, 1, 2, 3, 4, 5, 6};
+		CHECK(ranges::equal(views::merge(a, b, c), expected));
+		const int two[] = {1, 2, 3, 5};
+		CHECK(ranges::equal(views::merge(a, b), two));
+	}
+
+	// No ranges, and a single range
+	{
+		const std::vector<std::vector<int>> none;
+		auto rng = views::merge(none);
+		CHECK(rng.begin() == rng.end());
+		const std::vector<std::vector<int>> one = {{1, 2, 3}};
+		const int expected[] = {1, 2, 3};
+		CHECK(ranges::equal(views::merge(one), expected));
+		const std::vector<std::vector<int>> empties(5);
+		auto nothing = views::merge(empties);
+		CHECK(nothing.begin() == nothing.end());
+	}
+
+	for (std::size_t k : {1, 2, 3, 4, 5, 7, 8, 9, 16, 31, 200}) {
+		check_random(k);
+	}
+
+	return ::test_result();
+}